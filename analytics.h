@@ -1,258 +1,1071 @@
-#ifndef ANALYTICS_H
-#define ANALYTICS_H
-
-#include <iostream>
-#include <string>
-#include <iomanip>
-#include <map>
-#include <vector>
-#include <algorithm>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-#include <cppconn/statement.h>
-
-using namespace std;
-
-#define RESET   "\033[0m"
-#define BOLD    "\033[1m"
-#define CYAN    "\033[36m"
-#define GREEN   "\033[32m"
-#define YELLOW  "\033[33m"
-#define RED     "\033[31m"
-#define MAGENTA "\033[35m"
-
-class Analytics {
-private:
-    sql::Connection* con;
-
-    void printTableLine(int width = 70) {
-        cout << "+";
-        for (int i = 0; i < width; i++) cout << "-";
-        cout << "+" << endl;
-    }
-
-    void printHeader(string title) {
-        cout << "\n" << BOLD << CYAN;
-        printTableLine(70);
-        cout << "| " << left << setw(68) << title << " |" << endl;
-        printTableLine(70);
-        cout << RESET;
-    }
-
-public:
-    Analytics(sql::Connection* conn) : con(conn) {}
-
-    // 1. CATEGORY PERFORMANCE - TABLE FORMAT
-    void showCategoryPerformance() {
-        printHeader("1. GENERATE SALES TABLE BY CATEGORY");
-
-        try {
-            sql::Statement* stmt = con->createStatement();
-            sql::ResultSet* res = stmt->executeQuery(
-                "SELECT c.CategoryID, c.CategoryName, "
-                "SUM(oi.Quantity) as total_quantity, "
-                "SUM(oi.Quantity * m.Price) as total_sales "
-                "FROM category c "
-                "JOIN menu m ON c.CategoryID = m.CategoryID "
-                "JOIN order_item oi ON m.MenuID = oi.MenuID "
-                "GROUP BY c.CategoryID, c.CategoryName "
-                "ORDER BY total_sales DESC"
-            );
-
-            cout << "\n";
-            printTableLine(70);
-            cout << "| " << left << setw(15) << "Category ID"
-                << "| " << setw(20) << "Category Name"
-                << "| " << setw(12) << "Quantity"
-                << "| " << setw(15) << "Total Sales" << " |" << endl;
-            printTableLine(70);
-
-            double grandTotal = 0.0;
-            while (res->next()) {
-                int catID = res->getInt("CategoryID");
-                string catName = res->getString("CategoryName");
-                int qty = res->getInt("total_quantity");
-                double sales = res->getDouble("total_sales");
-                grandTotal += sales;
-
-                cout << "| " << left << setw(15) << catID
-                    << "| " << setw(20) << catName
-                    << "| " << setw(12) << qty
-                    << "| RM" << setw(14) << fixed << setprecision(2) << sales << " |" << endl;
-            }
-            printTableLine(70);
-
-            cout << BOLD << GREEN << "\nGRAND TOTAL: RM" << fixed << setprecision(2) << grandTotal << RESET << endl;
-
-            delete res;
-            delete stmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-
-    // 2. SALES SUMMARY - TABLE FORMAT
-    void showSalesSummary() {
-        printHeader("2. GENERATE SALES SUMMARY");
-
-        try {
-            sql::Statement* stmt = con->createStatement();
-
-            // Total Monthly Sales
-            sql::ResultSet* monthRes = stmt->executeQuery(
-                "SELECT IFNULL(SUM(Amount), 0) as total FROM payment "
-                "WHERE MONTH(PaymentDate) = MONTH(NOW()) AND YEAR(PaymentDate) = YEAR(NOW())"
-            );
-            double monthlySales = 0;
-            if (monthRes->next()) monthlySales = monthRes->getDouble("total");
-            delete monthRes;
-
-            // Total Inventory Value
-            sql::ResultSet* invRes = stmt->executeQuery(
-                "SELECT IFNULL(SUM(Stock * Price), 0) as total FROM menu"
-            );
-            double inventoryValue = 0;
-            if (invRes->next()) inventoryValue = invRes->getDouble("total");
-            delete invRes;
-
-            // Calculate Profit Margin (example: 25%)
-            double profitMargin = 25.0;
-
-            cout << "\n";
-            cout << "1. Total Monthly Sales: RM" << fixed << setprecision(2) << monthlySales << endl;
-            cout << "2. Total Inventory Value: RM" << fixed << setprecision(2) << inventoryValue << endl;
-            cout << "3. Profit Margin: " << profitMargin << "%" << endl;
-
-            delete stmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-
-    // 3. PEAK HOURS BAR CHART (UPDATED - replaces monthly)
-    void showPeakHoursBarChart() {
-        printHeader("3. GENERATE TEXT BAR CHART - PEAK HOURS ANALYSIS");
-
-        try {
-            sql::Statement* stmt = con->createStatement();
-            sql::ResultSet* res = stmt->executeQuery(
-                "SELECT HOUR(OrdersDate) as hour, COUNT(*) as total "
-                "FROM orders "
-                "GROUP BY HOUR(OrdersDate) "
-                "ORDER BY hour"
-            );
-
-            cout << "\n";
-
-            map<int, int> hourlyOrders;
-            int maxOrders = 0;
-            while (res->next()) {
-                int hour = res->getInt("hour");
-                int total = res->getInt("total");
-                hourlyOrders[hour] = total;
-                if (total > maxOrders) maxOrders = total;
-            }
-
-            // Display bar chart by hour order
-            for (auto& entry : hourlyOrders) {
-                int hour = entry.first;
-                int orders = entry.second;
-
-                // Calculate number of stars (scale to max 50 stars)
-                int numStars = (maxOrders > 0) ? (int)((orders * 1.0 / maxOrders) * 50) : 0;
-                if (numStars < 1 && orders > 0) numStars = 1;
-
-                cout << "Hour " << setw(2) << setfill('0') << hour << ":00 : ";
-                cout << setfill(' ');
-
-                // Color: RED for peak, GREEN for others
-                if (orders == maxOrders) {
-                    cout << RED;
-                }
-                else {
-                    cout << GREEN;
-                }
-
-                for (int i = 0; i < numStars; i++) cout << "*";
-                cout << RESET << " (" << orders << " orders)" << endl;
-            }
-
-            // Find and display peak hour
-            auto peak = max_element(hourlyOrders.begin(), hourlyOrders.end(),
-                [](const pair<int, int>& a, const pair<int, int>& b) {
-                    return a.second < b.second;
-                });
-
-            cout << "\n" << BOLD << RED << "PEAK HOUR: "
-                << setw(2) << setfill('0') << peak->first << ":00" << setfill(' ')
-                << " (" << peak->second << " orders)"
-                << RESET << endl;
-
-            delete res;
-            delete stmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-
-    // 4. TOP SELLING ITEMS - TABLE FORMAT
-    void showTopSellingTable() {
-        printHeader("4. TOP SELLING ITEMS TABLE");
-
-        try {
-            sql::Statement* stmt = con->createStatement();
-            sql::ResultSet* res = stmt->executeQuery(
-                "SELECT m.MenuID, m.Menu_Name, "
-                "COUNT(DISTINCT oi.OrdersID) as times_ordered, "
-                "SUM(oi.Quantity) as total_sold, "
-                "SUM(oi.Quantity * m.Price) as revenue "
-                "FROM order_item oi "
-                "JOIN menu m ON oi.MenuID = m.MenuID "
-                "GROUP BY m.MenuID, m.Menu_Name "
-                "ORDER BY total_sold DESC "
-                "LIMIT 10"
-            );
-
-            cout << "\n";
-            printTableLine(85);
-            cout << "| " << left << setw(6) << "Rank"
-                << "| " << setw(10) << "Menu ID"
-                << "| " << setw(25) << "Menu Name"
-                << "| " << setw(13) << "Times Order"
-                << "| " << setw(11) << "Total Sold"
-                << "| " << setw(12) << "Revenue" << " |" << endl;
-            printTableLine(85);
-
-            int rank = 1;
-            while (res->next()) {
-                int menuID = res->getInt("MenuID");
-                string menuName = res->getString("Menu_Name");
-                int timesOrdered = res->getInt("times_ordered");
-                int totalSold = res->getInt("total_sold");
-                double revenue = res->getDouble("revenue");
-
-                string rankStr = (rank == 1) ? "1st" : (rank == 2) ? "2nd" : (rank == 3) ? "3rd" : to_string(rank) + "th";
-
-                cout << "| " << left << setw(6) << rankStr
-                    << "| " << setw(10) << menuID
-                    << "| " << setw(25) << menuName
-                    << "| " << setw(13) << timesOrdered
-                    << "| " << setw(11) << totalSold
-                    << "| $" << setw(11) << fixed << setprecision(2) << revenue << " |" << endl;
-                rank++;
-            }
-            printTableLine(85);
-
-            delete res;
-            delete stmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-};
-
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <thread>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "sales_rollup.h"
+#include "margin_engine.h"
+#include "analytics_engine.h"
+#include "cohort.h"
+#include "top_sellers.h"
+#include "live_metrics.h"
+#include "reach_tracker.h"
+#include "report_scheduler.h"
+#include "query_router.h"
+
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <sys/select.h>
+#endif
+
+using namespace std;
+
+#define RESET   "\033[0m"
+#define BOLD    "\033[1m"
+#define CYAN    "\033[36m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define RED     "\033[31m"
+#define MAGENTA "\033[35m"
+
+class Analytics {
+private:
+    sql::Connection* con;
+    SalesRollup rollup;
+    MarginEngine margins;
+    ColumnarSales columnar;
+    bool useColumnar = false;
+    CohortEngine cohorts;
+    TopSellerTracker* topSellers = nullptr;
+    LiveMetrics* liveMetrics = nullptr;
+    ReachTracker* reach = nullptr;
+    ReportScheduler* scheduler = nullptr;
+    QueryRouter* router = nullptr;
+
+    struct SalesSummaryData {
+        double monthlySales;
+        double inventoryValue;
+        MarginTotals margin;                                        // month to date
+        vector<pair<string, MarginTotals>> categoryMargins;         // all time
+    };
+
+    // Connection for report reads: the replica when it is fresh enough
+    sql::Connection* reader() { return router ? router->reader() : con; }
+
+    void printTableLine(int width = 70) {
+        cout << "+";
+        for (int i = 0; i < width; i++) cout << "-";
+        cout << "+" << endl;
+    }
+
+    void printHeader(string title) {
+        cout << "\n" << BOLD << CYAN;
+        printTableLine(70);
+        cout << "| " << left << setw(68) << title << " |" << endl;
+        printTableLine(70);
+        cout << RESET;
+    }
+
+    vector<CategorySalesRow> fetchCategorySales() {
+        rollup.ensureSchema();      // also adds order_item.UnitPrice, read by the columnar load
+        if (useColumnar) {
+            columnar.refresh(reader());
+            return columnar.categorySales();
+        }
+        return queryCategorySales(reader());
+    }
+
+    static vector<CategorySalesRow> queryCategorySales(sql::Connection* db) {
+        vector<CategorySalesRow> rows;
+        sql::Statement* stmt = db->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT c.CategoryID, c.CategoryName, "
+            "r.Quantity as total_quantity, "
+            "r.Revenue as total_sales "
+            "FROM sales_rollup_category r "
+            "JOIN category c ON c.CategoryID = r.CategoryID "
+            "ORDER BY total_sales DESC"
+        );
+        while (res->next()) {
+            CategorySalesRow row;
+            row.categoryID = res->getInt("CategoryID");
+            row.categoryName = res->getString("CategoryName");
+            row.quantity = res->getInt64("total_quantity");
+            row.sales = res->getDouble("total_sales");
+            rows.push_back(row);
+        }
+        delete res;
+        delete stmt;
+        return rows;
+    }
+
+    map<int, int> fetchHourlyOrders() {
+        map<int, int> hourlyOrders;
+        rollup.ensureSchema();
+        if (useColumnar) {
+            columnar.refresh(reader());
+            vector<int64_t> counts = columnar.hourlyOrders();
+            for (int hour = 0; hour < 24; hour++) {
+                if (counts[hour] > 0) hourlyOrders[hour] = (int)counts[hour];
+            }
+            return hourlyOrders;
+        }
+        return queryHourlyOrders(reader());
+    }
+
+    static map<int, int> queryHourlyOrders(sql::Connection* db) {
+        map<int, int> hourlyOrders;
+        sql::Statement* stmt = db->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT SalesHour as hour, Orders as total "
+            "FROM sales_rollup_hour "
+            "ORDER BY hour"
+        );
+        while (res->next()) {
+            hourlyOrders[res->getInt("hour")] = res->getInt("total");
+        }
+        delete res;
+        delete stmt;
+        return hourlyOrders;
+    }
+
+    // Waits up to timeoutMs for the Enter key without blocking the refresh loop
+    static bool keyPressed(int timeoutMs) {
+#ifdef _WIN32
+        for (int waited = 0; waited < timeoutMs; waited += 50) {
+            if (_kbhit()) {
+                _getch();
+                return true;
+            }
+            this_thread::sleep_for(chrono::milliseconds(50));
+        }
+        return false;
+#else
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(0, &fds);
+        timeval tv = { timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+        if (select(1, &fds, nullptr, nullptr, &tv) > 0) {
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            return true;
+        }
+        return false;
+#endif
+    }
+
+    void renderCategorySales(const vector<CategorySalesRow>& rows) {
+        cout << "\n";
+        printTableLine(70);
+        cout << "| " << left << setw(15) << "Category ID"
+            << "| " << setw(20) << "Category Name"
+            << "| " << setw(12) << "Quantity"
+            << "| " << setw(15) << "Total Sales" << " |" << endl;
+        printTableLine(70);
+
+        double grandTotal = 0.0;
+        for (const CategorySalesRow& row : rows) {
+            int catID = row.categoryID;
+            string catName = row.categoryName;
+            long long qty = row.quantity;
+            double sales = row.sales;
+            grandTotal += sales;
+
+            cout << "| " << left << setw(15) << catID
+                << "| " << setw(20) << catName
+                << "| " << setw(12) << qty
+                << "| RM" << setw(14) << fixed << setprecision(2) << sales << " |" << endl;
+        }
+        printTableLine(70);
+
+        cout << BOLD << GREEN << "\nGRAND TOTAL: RM" << fixed << setprecision(2) << grandTotal << RESET << endl;
+    }
+
+    void renderSalesSummary(const SalesSummaryData& data) {
+        cout << "\n";
+        cout << "1. Total Monthly Sales: RM" << fixed << setprecision(2) << data.monthlySales << endl;
+        cout << "2. Total Inventory Value: RM" << fixed << setprecision(2) << data.inventoryValue << endl;
+        if (!data.margin.hasCost()) {
+            cout << "3. Profit Margin: " << YELLOW << "n/a (no unit costs recorded for this month's sales)" << RESET << endl;
+            return;
+        }
+        cout << "3. Profit Margin: " << fixed << setprecision(1) << data.margin.marginPercent() << "%"
+            << " (gross, on RM" << setprecision(2) << data.margin.costedRevenue() << " of item sales; cost RM"
+            << data.margin.cost << ")" << endl;
+        if (data.margin.uncostedRevenue > 0.005) {
+            cout << YELLOW << "   " << fixed << setprecision(1) << 100.0 - data.margin.costedPercent()
+                << "% of item sales have no unit cost and are left out" << RESET << endl;
+        }
+
+        cout << "\n   " << left << setw(22) << "Category" << right << setw(14) << "Revenue"
+            << setw(14) << "Cost" << setw(10) << "Margin" << endl;
+        for (const auto& row : data.categoryMargins) {
+            if (row.second.revenue <= 0) continue;
+            cout << "   " << left << setw(22) << row.first << right << fixed << setprecision(2)
+                << setw(14) << row.second.revenue << setw(14) << row.second.cost;
+            if (row.second.hasCost()) cout << setw(9) << setprecision(1) << row.second.marginPercent() << "%";
+            else cout << setw(10) << "n/a";
+            cout << endl;
+        }
+        cout << left;
+    }
+
+    void renderPeakHours(const map<int, int>& hourlyOrders) {
+        cout << "\n";
+
+        int maxOrders = 0;
+        for (auto& entry : hourlyOrders) {
+            if (entry.second > maxOrders) maxOrders = entry.second;
+        }
+
+        // Display bar chart by hour order
+        for (auto& entry : hourlyOrders) {
+            int hour = entry.first;
+            int orders = entry.second;
+
+            // Calculate number of stars (scale to max 50 stars)
+            int numStars = (maxOrders > 0) ? (int)((orders * 1.0 / maxOrders) * 50) : 0;
+            if (numStars < 1 && orders > 0) numStars = 1;
+
+            cout << "Hour " << setw(2) << setfill('0') << hour << ":00 : ";
+            cout << setfill(' ');
+
+            // Color: RED for peak, GREEN for others
+            if (orders == maxOrders) {
+                cout << RED;
+            }
+            else {
+                cout << GREEN;
+            }
+
+            for (int i = 0; i < numStars; i++) cout << "*";
+            cout << RESET << " (" << orders << " orders)" << endl;
+        }
+
+        if (hourlyOrders.empty()) {
+            cout << YELLOW << "No orders recorded yet." << RESET << endl;
+            return;
+        }
+
+        // Find and display peak hour
+        auto peak = max_element(hourlyOrders.begin(), hourlyOrders.end(),
+            [](const pair<int, int>& a, const pair<int, int>& b) {
+                return a.second < b.second;
+            });
+
+        cout << "\n" << BOLD << RED << "PEAK HOUR: "
+            << setw(2) << setfill('0') << peak->first << ":00" << setfill(' ')
+            << " (" << peak->second << " orders)"
+            << RESET << endl;
+    }
+
+    void printTopSellerRows(const vector<TopSellerRow>& rows) {
+        cout << "\n";
+        printTableLine(85);
+        cout << "| " << left << setw(6) << "Rank"
+            << "| " << setw(10) << "Menu ID"
+            << "| " << setw(25) << "Menu Name"
+            << "| " << setw(13) << "Times Order"
+            << "| " << setw(11) << "Total Sold"
+            << "| " << setw(12) << "Revenue" << " |" << endl;
+        printTableLine(85);
+
+        int rank = 1;
+        for (const TopSellerRow& row : rows) {
+            int menuID = row.menuID;
+            string menuName = row.menuName;
+            long long timesOrdered = row.timesOrdered;
+            long long totalSold = row.totalSold;
+            double revenue = row.revenue;
+
+            string rankStr = (rank == 1) ? "1st" : (rank == 2) ? "2nd" : (rank == 3) ? "3rd" : to_string(rank) + "th";
+
+            cout << "| " << left << setw(6) << rankStr
+                << "| " << setw(10) << menuID
+                << "| " << setw(25) << menuName
+                << "| " << setw(13) << timesOrdered
+                << "| " << setw(11) << totalSold
+                << "| $" << setw(11) << fixed << setprecision(2) << revenue << " |" << endl;
+            rank++;
+        }
+        printTableLine(85);
+    }
+
+    static vector<TopSellerRow> toRows(const vector<TopSellerEntry>& entries) {
+        vector<TopSellerRow> rows;
+        for (const TopSellerEntry& e : entries) {
+            TopSellerRow row = { e.menuID, e.menuName, e.orders, e.unitsSold, e.revenueCents / 100.0 };
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    vector<TopSellerRow> fetchTopSellers() {
+        rollup.ensureSchema();
+        if (useColumnar) {
+            columnar.refresh(reader());
+            return columnar.topSellers(10);
+        }
+        if (topSellers) return toRows(topSellers->topAllTime(10));
+        return queryTopSellers(reader());
+    }
+
+    static vector<TopSellerRow> queryTopSellers(sql::Connection* db) {
+        vector<TopSellerRow> rows;
+        sql::Statement* stmt = db->createStatement();
+        sql::ResultSet* res = stmt->executeQuery(
+            "SELECT r.MenuID, m.Menu_Name, "
+            "r.Orders as times_ordered, "
+            "r.Quantity as total_sold, "
+            "r.Revenue as revenue "
+            "FROM sales_rollup_item r "
+            "JOIN menu m ON r.MenuID = m.MenuID "
+            "ORDER BY total_sold DESC "
+            "LIMIT 10"
+        );
+        while (res->next()) {
+            TopSellerRow row;
+            row.menuID = res->getInt("MenuID");
+            row.menuName = res->getString("Menu_Name");
+            row.timesOrdered = res->getInt64("times_ordered");
+            row.totalSold = res->getInt64("total_sold");
+            row.revenue = res->getDouble("revenue");
+            rows.push_back(row);
+        }
+        delete res;
+        delete stmt;
+        return rows;
+    }
+
+
+    void renderCohorts(const CohortReport& report, size_t maxRows = 12) {
+        if (report.cohorts.empty()) {
+            cout << YELLOW << "No orders yet." << RESET << endl;
+            return;
+        }
+        size_t offsets = report.cohorts[0].active.size();
+        int lastIndex = (report.lastMonth / 100) * 12 + report.lastMonth % 100 - 1;
+
+        cout << "\n" << left << setw(10) << "Cohort" << right << setw(10) << "New" << setw(9) << "Repeat";
+        for (size_t k = 1; k < offsets; k++) cout << setw(7) << ("M+" + to_string(k));
+        cout << endl << string(29 + 7 * (offsets - 1), '-') << endl;
+
+        size_t first = report.cohorts.size() > maxRows ? report.cohorts.size() - maxRows : 0;
+        for (size_t c = first; c < report.cohorts.size(); c++) {
+            const CohortRow& row = report.cohorts[c];
+            int monthIndex = (row.month / 100) * 12 + row.month % 100 - 1;
+            cout << row.month / 100 << "-" << right << setfill('0') << setw(2) << row.month % 100
+                << setfill(' ') << "   " << setw(10) << row.customers
+                << setw(8) << fixed << setprecision(1) << row.repeaters * 100.0 / row.customers << "%";
+            for (size_t k = 1; k < offsets; k++) {
+                if (monthIndex + static_cast<int>(k) > lastIndex) {
+                    cout << setw(7) << "";
+                    continue;
+                }
+                double pct = row.active[k] * 100.0 / row.customers;
+                cout << (pct >= 20 ? GREEN : (pct >= 5 ? YELLOW : RED)) << setw(6) << setprecision(1) << pct << "%" << RESET;
+            }
+            cout << endl;
+        }
+        cout << left;
+
+        cout << "\n" << BOLD << "Repeat-rate curve" << RESET << " (share of all " << report.customers
+            << " customers with a 2nd order within N days of their first)" << endl;
+        for (size_t i = 0; i < report.curveDays.size(); i++) {
+            double pct = report.repeatWithin[i] * 100.0;
+            cout << "  " << right << setw(4) << report.curveDays[i] << " days : " << setw(5) << fixed << setprecision(1)
+                << pct << "% " << GREEN << string(static_cast<size_t>(pct / 2), '*') << RESET << endl;
+        }
+        cout << left;
+    }
+
+    static SalesSummaryData querySalesSummary(sql::Connection* db) {
+        SalesSummaryData data;
+        data.monthlySales = 0.0;
+        sql::Statement* stmt = db->createStatement();
+
+        // Total Monthly Sales (daily rollup rows for this calendar month)
+        sql::ResultSet* monthRes = stmt->executeQuery(
+            "SELECT IFNULL(SUM(Revenue), 0) as total FROM sales_rollup_day "
+            "WHERE SalesDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+            "AND SalesDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH"
+        );
+        if (monthRes->next()) data.monthlySales = monthRes->getDouble("total");
+        delete monthRes;
+        delete stmt;
+
+        // Inventory value and cost of goods are maintained at checkout / restock
+        data.inventoryValue = MarginEngine::inventoryValue(db);
+        data.margin = MarginEngine::monthToDate(db);
+        data.categoryMargins = MarginEngine::byCategory(db);
+        return data;
+    }
+
+public:
+    Analytics(sql::Connection* conn) : con(conn), rollup(conn), margins(conn) {}
+
+    // Serve category, top seller and peak hour reports from the in-memory columnar snapshot
+    void setColumnarEngine(bool enabled) {
+        useColumnar = enabled;
+        if (!enabled) columnar.clear();
+    }
+
+    bool columnarEngineEnabled() const { return useColumnar; }
+
+    // Streaming all-time / today / last-hour top sellers fed by checkout events
+    void setTopSellerTracker(TopSellerTracker* tracker) { topSellers = tracker; }
+
+    // Per-second order / revenue windows fed by checkout events
+    void setLiveMetrics(LiveMetrics* metrics) { liveMetrics = metrics; }
+
+    // HyperLogLog distinct buyer / order sketches per item, category and day
+    void setReachTracker(ReachTracker* tracker) { reach = tracker; }
+
+    // Worker pool with its own read connections for the full dashboard
+    void setReportScheduler(ReportScheduler* reportScheduler) { scheduler = reportScheduler; }
+
+    // Send report reads through the replica router
+    void setQueryRouter(QueryRouter* queryRouter) { router = queryRouter; }
+
+    // 1. CATEGORY PERFORMANCE - TABLE FORMAT
+    void showCategoryPerformance() {
+        printHeader("1. GENERATE SALES TABLE BY CATEGORY");
+
+        try {
+            renderCategorySales(fetchCategorySales());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // 2. SALES SUMMARY - TABLE FORMAT
+    void showSalesSummary() {
+        printHeader("2. GENERATE SALES SUMMARY");
+
+        try {
+            rollup.ensureSchema();
+            margins.ensureSchema();
+            renderSalesSummary(querySalesSummary(reader()));
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // 3. PEAK HOURS BAR CHART (UPDATED - replaces monthly)
+    void showPeakHoursBarChart() {
+        printHeader("3. GENERATE TEXT BAR CHART - PEAK HOURS ANALYSIS");
+
+        try {
+            renderPeakHours(fetchHourlyOrders());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // 4. TOP SELLING ITEMS - TABLE FORMAT
+    void showTopSellingTable() {
+        printHeader("4. TOP SELLING ITEMS TABLE");
+
+        try {
+            printTopSellerRows(fetchTopSellers());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // 5. LIVE TOP SELLERS - all time, today and the last hour from the streaming tracker
+    void showLiveTopSellers() {
+        printHeader("5. LIVE TOP SELLERS");
+
+        if (!topSellers) {
+            cout << YELLOW << "Live tracking is not enabled." << RESET << endl;
+            return;
+        }
+
+        cout << "\n" << BOLD << "All time" << RESET;
+        printTopSellerRows(toRows(topSellers->topAllTime(10)));
+        cout << "\n" << BOLD << "Today" << RESET;
+        printTopSellerRows(toRows(topSellers->topToday(10)));
+        cout << "\n" << BOLD << "Last hour" << RESET;
+        printTopSellerRows(toRows(topSellers->topLastHour(10)));
+    }
+
+    // 6. LIVE DASHBOARD - sliding 5 min / 1 h / 24 h windows, redrawn every second
+    void showLiveDashboard() {
+        if (!liveMetrics) {
+            printHeader("6. LIVE SALES DASHBOARD");
+            cout << YELLOW << "Live metrics are not enabled." << RESET << endl;
+            return;
+        }
+
+        const LiveMetrics::Window windows[] = { LiveMetrics::FIVE_MINUTES, LiveMetrics::ONE_HOUR, LiveMetrics::ONE_DAY };
+        const char* labels[] = { "Last 5 minutes", "Last hour", "Last 24 hours" };
+
+        do {
+            cout << "\033[H\033[2J";
+            printHeader("6. LIVE SALES DASHBOARD");
+
+            time_t now = time(nullptr);
+            tm local = {};
+#ifdef _WIN32
+            localtime_s(&local, &now);
+#else
+            localtime_r(&now, &local);
+#endif
+            char clock[16];
+            strftime(clock, sizeof(clock), "%H:%M:%S", &local);
+            cout << "\nUpdated " << clock << "  (press Enter to return)\n\n";
+
+            printTableLine(70);
+            cout << "| " << left << setw(16) << "Window"
+                << "| " << setw(8) << "Orders"
+                << "| " << setw(10) << "Orders/min"
+                << "| " << setw(12) << "Revenue"
+                << "| " << setw(6) << "Items"
+                << "| " << setw(8) << "Avg RM" << " |" << endl;
+            printTableLine(70);
+            for (int i = 0; i < 3; i++) {
+                WindowStats stats = liveMetrics->window(windows[i]);
+                cout << "| " << left << setw(16) << labels[i]
+                    << "| " << setw(8) << stats.orders
+                    << "| " << setw(10) << fixed << setprecision(2) << stats.ordersPerMinute(LiveMetrics::seconds(windows[i]))
+                    << "| RM" << setw(10) << stats.revenueCents / 100.0
+                    << "| " << setw(6) << setprecision(1) << stats.averageBasketItems()
+                    << "| " << setw(8) << setprecision(2) << stats.averageOrderValue() << " |" << endl;
+            }
+            printTableLine(70);
+
+            // Orders per minute for the last half hour
+            vector<int> perMinute = liveMetrics->ordersPerMinute(30);
+            int peak = *max_element(perMinute.begin(), perMinute.end());
+            const char* levels[] = { " ", ".", ":", "|", "#" };
+            cout << "\nOrders/min, last 30 min: [";
+            for (int count : perMinute) {
+                cout << levels[peak > 0 ? (count * 4 + peak - 1) / peak : 0];
+            }
+            cout << "] peak " << peak << endl;
+
+            if (topSellers) {
+                cout << "\nTop sellers, last hour:";
+                int rank = 1;
+                for (const TopSellerEntry& e : topSellers->topLastHour(3)) {
+                    cout << "  " << rank++ << ". " << e.menuName << " (" << e.unitsSold << ")";
+                }
+                cout << endl;
+            }
+            cout.flush();
+        } while (!keyPressed(1000));
+    }
+
+    // 7. UNIQUE BUYERS & REACH - approximate distinct counts from the HLL sketches
+    void showReach() {
+        printHeader("7. UNIQUE BUYERS & REACH (ESTIMATED)");
+
+        if (!reach) {
+            cout << YELLOW << "Reach tracking is not enabled." << RESET << endl;
+            return;
+        }
+
+        try {
+            map<int, string> menuNames, categoryNames;
+            sql::Statement* stmt = reader()->createStatement();
+            sql::ResultSet* res = stmt->executeQuery("SELECT MenuID, Menu_Name FROM menu");
+            while (res->next()) menuNames[res->getInt("MenuID")] = res->getString("Menu_Name");
+            delete res;
+            res = stmt->executeQuery("SELECT CategoryID, CategoryName FROM category");
+            while (res->next()) categoryNames[res->getInt("CategoryID")] = res->getString("CategoryName");
+            delete res;
+            delete stmt;
+
+            cout << "\nEstimates are within about +/-" << fixed << setprecision(1)
+                << reach->standardError() * 100 << "% (one standard error).\n\n";
+
+            printTableLine(70);
+            cout << "| " << left << setw(30) << "Menu Item"
+                << "| " << setw(17) << "Unique Buyers"
+                << "| " << setw(16) << "Orders" << " |" << endl;
+            printTableLine(70);
+            for (int menuID : reach->keys(ReachTracker::ITEM)) {
+                string name = menuNames.count(menuID) ? menuNames[menuID] : "#" + to_string(menuID);
+                cout << "| " << left << setw(30) << name
+                    << "| " << setw(17) << setprecision(0) << reach->estimate(ReachTracker::ITEM, menuID, ReachTracker::CUSTOMERS)
+                    << "| " << setw(16) << reach->estimate(ReachTracker::ITEM, menuID, ReachTracker::ORDERS) << " |" << endl;
+            }
+            printTableLine(70);
+
+            cout << "\n";
+            printTableLine(70);
+            cout << "| " << left << setw(30) << "Category"
+                << "| " << setw(17) << "Unique Buyers"
+                << "| " << setw(16) << "Orders" << " |" << endl;
+            printTableLine(70);
+            for (int catID : reach->keys(ReachTracker::CATEGORY)) {
+                string name = categoryNames.count(catID) ? categoryNames[catID] : "#" + to_string(catID);
+                cout << "| " << left << setw(30) << name
+                    << "| " << setw(17) << setprecision(0) << reach->estimate(ReachTracker::CATEGORY, catID, ReachTracker::CUSTOMERS)
+                    << "| " << setw(16) << reach->estimate(ReachTracker::CATEGORY, catID, ReachTracker::ORDERS) << " |" << endl;
+            }
+            printTableLine(70);
+
+            cout << "\n" << BOLD << "Unique customers by day" << RESET << endl;
+            vector<int> week = ReachTracker::lastDays(7);
+            for (int day : week) {
+                cout << "  " << day / 10000 << "-" << setw(2) << setfill('0') << day / 100 % 100
+                    << "-" << setw(2) << day % 100 << setfill(' ') << " : "
+                    << setprecision(0) << reach->estimate(ReachTracker::DAY, day, ReachTracker::CUSTOMERS) << endl;
+            }
+            cout << BOLD << GREEN << "\nUnique customers, last 7 days : "
+                << reach->estimateUnion(ReachTracker::DAY, week, ReachTracker::CUSTOMERS) << endl;
+            cout << "Unique customers, last 30 days: "
+                << reach->estimateUnion(ReachTracker::DAY, ReachTracker::lastDays(30), ReachTracker::CUSTOMERS)
+                << RESET << endl;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // 8. FULL DASHBOARD - reports 1-4 fetched concurrently on the report workers
+    void showFullDashboard() {
+        printHeader("8. FULL ANALYTICS DASHBOARD");
+
+        if (!scheduler) {
+            showCategoryPerformance();
+            showSalesSummary();
+            showPeakHoursBarChart();
+            showTopSellingTable();
+            return;
+        }
+
+        try {
+            rollup.ensureSchema();
+            margins.ensureSchema();
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+            return;
+        }
+
+        // Each task records its own duration so the overlap can be shown
+        typedef chrono::steady_clock Clock;
+        auto timed = [](double& ms, Clock::time_point start) {
+            ms = chrono::duration<double, milli>(Clock::now() - start).count();
+        };
+        double taskMs[4] = { 0, 0, 0, 0 };
+        auto start = Clock::now();
+
+        future<vector<CategorySalesRow>> categories = scheduler->submit([&](sql::Connection* db) {
+            auto t0 = Clock::now();
+            vector<CategorySalesRow> rows = queryCategorySales(db);
+            timed(taskMs[0], t0);
+            return rows;
+        });
+        future<SalesSummaryData> summary = scheduler->submit([&](sql::Connection* db) {
+            auto t0 = Clock::now();
+            SalesSummaryData data = querySalesSummary(db);
+            timed(taskMs[1], t0);
+            return data;
+        });
+        future<map<int, int>> hours = scheduler->submit([&](sql::Connection* db) {
+            auto t0 = Clock::now();
+            map<int, int> hourly = queryHourlyOrders(db);
+            timed(taskMs[2], t0);
+            return hourly;
+        });
+        future<vector<TopSellerRow>> top = scheduler->submit([&](sql::Connection* db) {
+            auto t0 = Clock::now();
+            vector<TopSellerRow> rows = queryTopSellers(db);
+            timed(taskMs[3], t0);
+            return rows;
+        });
+
+        // Render in a fixed order as each result arrives
+        try {
+            printHeader("1. SALES BY CATEGORY");
+            renderCategorySales(categories.get());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+        try {
+            printHeader("2. SALES SUMMARY");
+            renderSalesSummary(summary.get());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+        try {
+            printHeader("3. PEAK HOURS");
+            renderPeakHours(hours.get());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+        try {
+            printHeader("4. TOP SELLING ITEMS");
+            printTopSellerRows(top.get());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+
+        double wallMs = chrono::duration<double, milli>(Clock::now() - start).count();
+        double sumMs = taskMs[0] + taskMs[1] + taskMs[2] + taskMs[3];
+        cout << "\n" << CYAN << "Fetched 4 reports on " << scheduler->concurrency() << " workers in "
+            << fixed << setprecision(1) << wallMs << " ms (sequential would be ~" << sumMs << " ms)" << RESET << endl;
+    }
+
+    // 9. CUSTOMER COHORTS - retention of each month's new customers
+    void showCohortRetention() {
+        printHeader("9. CUSTOMER COHORTS & RETENTION");
+
+        try {
+            auto start = chrono::steady_clock::now();
+            cohorts.refresh(reader());
+            CohortReport report = cohorts.compute(7);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            cout << "\nCohort = month of a customer's first order. M+k = share of that cohort who ordered\n"
+                << "again k months later; blank cells are months that have not happened yet.\n";
+            renderCohorts(report);
+            cout << "\n" << report.orders << " orders, " << report.customers << " customers, computed in "
+                << fixed << setprecision(1) << ms << " ms." << endl;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // Cohort engine on synthetic history: load, radix sort + scan, re-scan
+    void benchmarkCohorts(size_t orders = 5000000) {
+        printHeader("COHORT ENGINE BENCHMARK (SYNTHETIC ORDERS)");
+
+        typedef chrono::steady_clock Clock;
+        auto msSince = [](Clock::time_point t) { return chrono::duration<double, milli>(Clock::now() - t).count(); };
+        int today = static_cast<int>(time(nullptr) / 86400);
+        uint32_t customers = static_cast<uint32_t>(max<size_t>(1, orders / 10));
+
+        CohortEngine engine;
+        cout << "\nGenerating " << orders << " orders from " << customers << " customers ("
+            << orders * 8 / (1024 * 1024) << " MB of keys)..." << endl;
+        auto t0 = Clock::now();
+        engine.loadSynthetic(orders, customers, today);
+        double loadMs = msSince(t0);
+
+        t0 = Clock::now();
+        CohortReport report = engine.compute(7);
+        double firstMs = msSince(t0);
+
+        t0 = Clock::now();
+        engine.compute(7);
+        double scanMs = msSince(t0);
+
+        renderCohorts(report, 6);
+        cout << "\n";
+        printTableLine(70);
+        cout << "| " << left << setw(40) << "Generate keys" << "| " << setw(25) << fixed << setprecision(1) << loadMs << " |" << endl;
+        cout << "| " << setw(40) << "Radix sort + cohort scan" << "| " << setw(25) << firstMs << " |" << endl;
+        cout << "| " << setw(40) << "Cohort scan (already sorted)" << "| " << setw(25) << scanMs << " |" << endl;
+        cout << "| " << setw(40) << "Orders per second (sort + scan)" << "| " << setw(25) << setprecision(0)
+            << (firstMs > 0 ? orders / (firstMs / 1000.0) : 0.0) << " |" << endl;
+        printTableLine(70);
+        cout << "Times in ms, " << engine.threads() << " threads." << endl;
+
+        // Cross-check the parallel engine against a plain map/set count
+        CohortEngine sample;
+        sample.loadSynthetic(200000, 20000, today, 7);
+        bool same = CohortEngine::sameReport(sample.compute(7), sample.computeBruteForce(7));
+        cout << (same ? GREEN : RED) << "Brute-force check on 200,000 orders: "
+            << (same ? "identical" : "MISMATCH") << RESET << endl;
+    }
+
+    // Where report reads are going and how far behind the replica is
+    void showRoutingStatus() {
+        printHeader("READ REPLICA ROUTING");
+
+        if (!router) {
+            cout << YELLOW << "All reads use the primary connection." << RESET << endl;
+            return;
+        }
+
+        sql::Connection* target = router->reader();
+        cout << "\nReplica host      : " << DB_REPLICA_HOST << endl;
+        cout << "Replica connected : " << (router->replicaConnected() ? "yes" : "no") << endl;
+        if (router->replicaLag() >= 0) {
+            cout << "Replication lag   : " << router->replicaLag() << " s (limit " << router->maxLag() << " s)" << endl;
+        }
+        else {
+            cout << "Replication lag   : unknown" << endl;
+        }
+        if (!router->lastReplicaError().empty()) {
+            cout << "Last problem      : " << router->lastReplicaError() << endl;
+        }
+        cout << "Reads on replica  : " << router->readsOnReplica() << endl;
+        cout << "Reads on primary  : " << router->readsOnPrimary() << endl;
+        cout << BOLD << (target == con ? YELLOW : GREEN) << "\nReports are currently served by the "
+            << (target == con ? "PRIMARY" : "REPLICA") << RESET << endl;
+    }
+
+    // Report latency: raw GROUP BY queries vs. the rollup tables vs. the
+    // columnar snapshot, on current history
+    void benchmarkReports(int runs = 10) {
+        printHeader("REPORT LATENCY BENCHMARK (RAW / ROLLUP / COLUMNAR)");
+
+        const char* names[] = { "Category sales", "Monthly sales", "Peak hours", "Top sellers" };
+        const char* raw[] = {
+            "SELECT c.CategoryID, SUM(oi.Quantity), SUM(oi.Quantity * IFNULL(oi.UnitPrice, m.Price)) FROM category c "
+            "JOIN menu m ON c.CategoryID = m.CategoryID JOIN order_item oi ON m.MenuID = oi.MenuID "
+            "GROUP BY c.CategoryID",
+            "SELECT IFNULL(SUM(p.Amount), 0) FROM payment p JOIN orders o ON o.OrdersID = p.OrdersID "
+            "WHERE o.OrdersDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+            "AND o.OrdersDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH",
+            "SELECT HOUR(OrdersDate), COUNT(*) FROM orders GROUP BY HOUR(OrdersDate)",
+            "SELECT m.MenuID, COUNT(DISTINCT oi.OrdersID), SUM(oi.Quantity) AS total_sold "
+            "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID GROUP BY m.MenuID "
+            "ORDER BY total_sold DESC LIMIT 10"
+        };
+        const char* rolled[] = {
+            "SELECT CategoryID, Quantity, Revenue FROM sales_rollup_category",
+            "SELECT IFNULL(SUM(Revenue), 0) FROM sales_rollup_day "
+            "WHERE SalesDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+            "AND SalesDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH",
+            "SELECT SalesHour, Orders FROM sales_rollup_hour",
+            "SELECT MenuID, Orders, Quantity FROM sales_rollup_item ORDER BY Quantity DESC LIMIT 10"
+        };
+
+        try {
+            rollup.ensureSchema();
+            sql::Statement* stmt = con->createStatement();
+
+            sql::ResultSet* countRes = stmt->executeQuery("SELECT COUNT(*) AS n FROM order_item");
+            if (countRes->next()) cout << "\norder_item rows: " << countRes->getInt64("n") << endl;
+            delete countRes;
+
+            ColumnarSales snapshot;
+            auto loadStart = chrono::steady_clock::now();
+            snapshot.refresh(con);
+            double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - loadStart).count();
+            cout << "Columnar snapshot: " << snapshot.itemRows() << " items, " << snapshot.orderRows()
+                << " orders, loaded in " << fixed << setprecision(1) << loadMs << " ms, "
+                << snapshot.threads() << " threads" << endl;
+
+            auto timeQuery = [&](const char* sql) {
+                auto start = chrono::steady_clock::now();
+                for (int i = 0; i < runs; i++) {
+                    sql::ResultSet* res = stmt->executeQuery(sql);
+                    while (res->next()) {}
+                    delete res;
+                }
+                return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / runs;
+            };
+
+            size_t sink = 0;
+            auto timeColumnar = [&](int report) {
+                auto start = chrono::steady_clock::now();
+                for (int i = 0; i < runs; i++) {
+                    if (report == 0) sink += snapshot.categorySales().size();
+                    else if (report == 2) sink += snapshot.hourlyOrders().size();
+                    else sink += snapshot.topSellers(10).size();
+                }
+                return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / runs;
+            };
+
+            cout << "\n";
+            printTableLine(70);
+            cout << "| " << left << setw(19) << "Report"
+                << "| " << setw(15) << "Raw SQL (ms)"
+                << "| " << setw(15) << "Rollup (ms)"
+                << "| " << setw(12) << "Columnar" << " |" << endl;
+            printTableLine(70);
+            for (int i = 0; i < 4; i++) {
+                double rawMs = timeQuery(raw[i]);
+                double rollupMs = timeQuery(rolled[i]);
+                cout << "| " << left << setw(19) << names[i]
+                    << "| " << setw(15) << fixed << setprecision(3) << rawMs
+                    << "| " << setw(15) << rollupMs << "| ";
+                if (i == 1) cout << setw(12) << "-";
+                else cout << setw(12) << timeColumnar(i);
+                cout << " |" << endl;
+            }
+            printTableLine(70);
+            cout << "Average of " << runs << " runs each (" << sink / runs << " result rows)." << endl;
+
+            delete stmt;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // Raw GROUP BY vs rollup reads on synthetic histories of 10k, 100k, 1M
+    // and 10M order_item rows (two items per order, one payment per order,
+    // spread over the last year). Runs only in DB_SCRATCH_SCHEMA, on its own
+    // connection, in rollbench_* tables that are dropped afterwards; the
+    // rollups are rebuilt at each size the same way SalesRollup::rebuild()
+    // does, and the rebuild time is reported too.
+    void benchmarkRollupScaling(long long maxItemRows = 10000000, int runs = 3) {
+        printHeader("ROLLUP SCALING BENCHMARK (SYNTHETIC HISTORY)");
+        unique_ptr<sql::Connection> scratchCon;
+        try {
+            scratchCon.reset(openScratchConnection());
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Cannot open scratch schema " << DB_SCRATCH_SCHEMA << ": " << e.what() << RESET << endl;
+            return;
+        }
+        if (!scratchCon) {
+            cout << YELLOW << "Set DB_SCRATCH_SCHEMA in database.h to a throwaway schema (not "
+                << DB_SCHEMA << ") to run this benchmark." << RESET << endl;
+            return;
+        }
+        cout << "\nScratch schema: " << DB_SCRATCH_SCHEMA << endl;
+        sql::Statement* stmt = scratchCon->createStatement();
+        const char* scratch[] = { "rollbench_digit", "rollbench_menu", "rollbench_orders", "rollbench_item",
+            "rollbench_payment", "rollbench_r_item", "rollbench_r_category", "rollbench_r_hour", "rollbench_r_day" };
+        auto dropScratch = [&]() {
+            for (const char* table : scratch) stmt->execute(string("DROP TABLE IF EXISTS ") + table);
+        };
+
+        try {
+            dropScratch();
+            stmt->execute("CREATE TABLE rollbench_digit (d INT PRIMARY KEY)");
+            stmt->execute("INSERT INTO rollbench_digit VALUES (0),(1),(2),(3),(4),(5),(6),(7),(8),(9)");
+            stmt->execute("CREATE TABLE rollbench_menu (MenuID INT PRIMARY KEY, CategoryID INT NOT NULL, Price DECIMAL(10,2) NOT NULL)");
+            stmt->execute(
+                "INSERT INTO rollbench_menu SELECT 1 + a.d + 10 * b.d, 1 + (a.d + 10 * b.d) % 8, 4.50 + a.d * 1.25 "
+                "FROM rollbench_digit a, rollbench_digit b WHERE b.d < 4");
+            stmt->execute("CREATE TABLE rollbench_orders (OrdersID INT PRIMARY KEY, OrdersDate DATETIME NOT NULL)");
+            stmt->execute(
+                "CREATE TABLE rollbench_item (OrdersID INT NOT NULL, MenuID INT NOT NULL, Quantity INT NOT NULL, "
+                "UnitPrice DECIMAL(10,2) NOT NULL, KEY (MenuID))");
+            stmt->execute("CREATE TABLE rollbench_payment (OrdersID INT PRIMARY KEY, Amount DECIMAL(10,2) NOT NULL)");
+            stmt->execute("CREATE TABLE rollbench_r_item (MenuID INT PRIMARY KEY, Quantity BIGINT, Orders BIGINT, Revenue DECIMAL(14,2))");
+            stmt->execute("CREATE TABLE rollbench_r_category (CategoryID INT PRIMARY KEY, Quantity BIGINT, Revenue DECIMAL(14,2))");
+            stmt->execute("CREATE TABLE rollbench_r_hour (SalesHour TINYINT PRIMARY KEY, Orders BIGINT)");
+            stmt->execute("CREATE TABLE rollbench_r_day (SalesDate DATE PRIMARY KEY, Payments BIGINT, Revenue DECIMAL(14,2))");
+
+            const char* names[] = { "Category sales", "Monthly sales", "Peak hours", "Top sellers" };
+            const char* raw[] = {
+                "SELECT m.CategoryID, SUM(oi.Quantity), SUM(oi.Quantity * oi.UnitPrice) FROM rollbench_item oi "
+                "JOIN rollbench_menu m ON m.MenuID = oi.MenuID GROUP BY m.CategoryID",
+                "SELECT IFNULL(SUM(p.Amount), 0) FROM rollbench_payment p JOIN rollbench_orders o ON o.OrdersID = p.OrdersID "
+                "WHERE o.OrdersDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+                "AND o.OrdersDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH",
+                "SELECT HOUR(OrdersDate), COUNT(*) FROM rollbench_orders GROUP BY HOUR(OrdersDate)",
+                "SELECT MenuID, COUNT(DISTINCT OrdersID), SUM(Quantity) AS total_sold FROM rollbench_item "
+                "GROUP BY MenuID ORDER BY total_sold DESC LIMIT 10"
+            };
+            const char* rolled[] = {
+                "SELECT CategoryID, Quantity, Revenue FROM rollbench_r_category",
+                "SELECT IFNULL(SUM(Revenue), 0) FROM rollbench_r_day "
+                "WHERE SalesDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+                "AND SalesDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH",
+                "SELECT SalesHour, Orders FROM rollbench_r_hour",
+                "SELECT MenuID, Orders, Quantity FROM rollbench_r_item ORDER BY Quantity DESC LIMIT 10"
+            };
+
+            auto timeQuery = [&](const char* query) {
+                auto start = chrono::steady_clock::now();
+                for (int i = 0; i < runs; i++) {
+                    sql::ResultSet* res = stmt->executeQuery(query);
+                    while (res->next()) {}
+                    delete res;
+                }
+                return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / runs;
+            };
+
+            cout << "\n";
+            printTableLine(78);
+            cout << "| " << left << setw(12) << "Item rows" << "| " << setw(16) << "Report"
+                << "| " << setw(14) << "Raw SQL (ms)" << "| " << setw(13) << "Rollup (ms)"
+                << "| " << setw(11) << "Rebuild (s)" << " |" << endl;
+            printTableLine(78);
+
+            long long orders = 0;
+            for (long long itemRows = 10000; itemRows <= maxItemRows; itemRows *= 10) {
+                // Add the orders for this size on top of the previous one
+                long long target = itemRows / 2, add = target - orders;
+                string from = "rollbench_digit d0", number = "d0.d";
+                long long span = 10;
+                for (int k = 1; span < add; k++, span *= 10) {
+                    from += ", rollbench_digit d" + to_string(k);
+                    number += " + " + to_string(span) + " * d" + to_string(k) + ".d";
+                }
+                stmt->execute(
+                    "INSERT INTO rollbench_orders (OrdersID, OrdersDate) "
+                    "SELECT " + to_string(orders + 1) + " + n, NOW() - INTERVAL ((n * 7919) % 525600) MINUTE "
+                    "FROM (SELECT " + number + " AS n FROM " + from + ") g WHERE n < " + to_string(add));
+                string range = " FROM rollbench_orders WHERE OrdersID > " + to_string(orders);
+                stmt->execute(
+                    "INSERT INTO rollbench_item (OrdersID, MenuID, Quantity, UnitPrice) "
+                    "SELECT OrdersID, 1 + OrdersID % 40, 1 + OrdersID % 3, 4.50 + (OrdersID % 10) * 1.25" + range);
+                stmt->execute(
+                    "INSERT INTO rollbench_item (OrdersID, MenuID, Quantity, UnitPrice) "
+                    "SELECT OrdersID, 1 + (OrdersID * 7) % 40, 1, 4.50 + ((OrdersID * 7) % 10) * 1.25" + range);
+                stmt->execute(
+                    "INSERT INTO rollbench_payment (OrdersID, Amount) "
+                    "SELECT OrdersID, (1 + OrdersID % 3) * (4.50 + (OrdersID % 10) * 1.25) "
+                    "+ 4.50 + ((OrdersID * 7) % 10) * 1.25" + range);
+                orders = target;
+
+                auto rebuildStart = chrono::steady_clock::now();
+                stmt->execute("DELETE FROM rollbench_r_item");
+                stmt->execute("DELETE FROM rollbench_r_category");
+                stmt->execute("DELETE FROM rollbench_r_hour");
+                stmt->execute("DELETE FROM rollbench_r_day");
+                stmt->execute(
+                    "INSERT INTO rollbench_r_item SELECT MenuID, SUM(Quantity), COUNT(DISTINCT OrdersID), "
+                    "SUM(Quantity * UnitPrice) FROM rollbench_item GROUP BY MenuID");
+                stmt->execute(
+                    "INSERT INTO rollbench_r_category SELECT m.CategoryID, SUM(oi.Quantity), SUM(oi.Quantity * oi.UnitPrice) "
+                    "FROM rollbench_item oi JOIN rollbench_menu m ON m.MenuID = oi.MenuID GROUP BY m.CategoryID");
+                stmt->execute(
+                    "INSERT INTO rollbench_r_hour SELECT HOUR(OrdersDate), COUNT(*) FROM rollbench_orders GROUP BY HOUR(OrdersDate)");
+                stmt->execute(
+                    "INSERT INTO rollbench_r_day SELECT DATE(o.OrdersDate), COUNT(*), SUM(p.Amount) "
+                    "FROM rollbench_payment p JOIN rollbench_orders o ON o.OrdersID = p.OrdersID GROUP BY DATE(o.OrdersDate)");
+                double rebuildSec = chrono::duration<double>(chrono::steady_clock::now() - rebuildStart).count();
+
+                for (int i = 0; i < 4; i++) {
+                    double rawMs = timeQuery(raw[i]);
+                    double rollupMs = timeQuery(rolled[i]);
+                    cout << "| " << left << setw(12) << (i == 0 ? to_string(itemRows) : "")
+                        << "| " << setw(16) << names[i]
+                        << "| " << setw(14) << fixed << setprecision(3) << rawMs
+                        << "| " << setw(13) << rollupMs << "| ";
+                    if (i == 0) cout << setw(11) << setprecision(2) << rebuildSec;
+                    else cout << setw(11) << "";
+                    cout << " |" << endl;
+                }
+                printTableLine(78);
+            }
+            cout << "Average of " << runs << " runs each. Rollup reads stay flat; raw queries grow with history." << endl;
+            dropScratch();
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+            try {
+                dropScratch();
+            }
+            catch (sql::SQLException&) {}
+        }
+        delete stmt;
+    }
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,310 @@
+#ifndef ANALYTICS_ENGINE_H
+#define ANALYTICS_ENGINE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/resultset.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/statement.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANALYTICS_SSE2 1
+#endif
+
+// Result rows shared by the SQL and columnar report paths
+struct CategorySalesRow {
+    int categoryID;
+    std::string categoryName;
+    long long quantity;
+    double sales;
+};
+
+struct TopSellerRow {
+    int menuID;
+    std::string menuName;
+    long long timesOrdered;
+    long long totalSold;
+    double revenue;
+};
+
+// Column-oriented in-memory copy of order_item / orders / menu / category.
+// Menu and category IDs are dictionary-encoded to dense indexes so group-by
+// becomes an array update instead of a hash lookup. order_item is four
+// parallel columns (menu index, quantity, line revenue in cents at the price
+// charged, first-in-order flag) and orders is a single hour-of-day byte
+// column. Refresh appends orders past the last loaded OrdersID; the small
+// menu/category dictionaries are reloaded each time so name edits show up.
+// Revenue is the price charged at checkout (order_item.UnitPrice, else the
+// current menu price for older rows), the same basis as the sales rollups.
+class ColumnarSales {
+private:
+    // Dictionaries (append-only, index is stable across refreshes)
+    std::unordered_map<int, int32_t> menuIndex, categoryIndex;
+    std::vector<int> menuIDs, categoryIDs;
+    std::vector<std::string> menuNames, categoryNames;
+    std::vector<int32_t> menuCategory;
+    std::vector<uint8_t> menuPresent, categoryPresent;
+
+    // order_item columns
+    std::vector<int32_t> itemMenu;
+    std::vector<int64_t> itemQuantity;
+    std::vector<int64_t> itemCents;     // Quantity x unit price charged, in cents
+    std::vector<int64_t> itemFirst;     // 1 on the first row of each (order, menu) pair
+
+    // orders column
+    std::vector<uint8_t> orderHour;
+
+    int lastOrderID = 0;
+    unsigned threadCount;
+
+    enum { MIN_ROWS_PER_THREAD = 1 << 16 };
+
+    int32_t menuSlot(int menuID) {
+        auto it = menuIndex.find(menuID);
+        if (it != menuIndex.end()) return it->second;
+        int32_t slot = static_cast<int32_t>(menuIDs.size());
+        menuIndex[menuID] = slot;
+        menuIDs.push_back(menuID);
+        menuNames.push_back(std::string());
+        menuCategory.push_back(-1);
+        menuPresent.push_back(0);
+        return slot;
+    }
+
+    int32_t categorySlot(int categoryID) {
+        auto it = categoryIndex.find(categoryID);
+        if (it != categoryIndex.end()) return it->second;
+        int32_t slot = static_cast<int32_t>(categoryIDs.size());
+        categoryIndex[categoryID] = slot;
+        categoryIDs.push_back(categoryID);
+        categoryNames.push_back(std::string());
+        categoryPresent.push_back(0);
+        return slot;
+    }
+
+    void loadDictionaries(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+
+        std::fill(categoryPresent.begin(), categoryPresent.end(), 0);
+        std::unique_ptr<sql::ResultSet> cat(stmt->executeQuery("SELECT CategoryID, CategoryName FROM category"));
+        while (cat->next()) {
+            int32_t slot = categorySlot(cat->getInt("CategoryID"));
+            categoryNames[slot] = cat->getString("CategoryName");
+            categoryPresent[slot] = 1;
+        }
+
+        std::fill(menuPresent.begin(), menuPresent.end(), 0);
+        std::unique_ptr<sql::ResultSet> menu(stmt->executeQuery(
+            "SELECT MenuID, Menu_Name, CategoryID FROM menu"));
+        while (menu->next()) {
+            int32_t slot = menuSlot(menu->getInt("MenuID"));
+            menuNames[slot] = menu->getString("Menu_Name");
+            menuCategory[slot] = menu->isNull("CategoryID") ? -1 : categorySlot(menu->getInt("CategoryID"));
+            menuPresent[slot] = 1;
+        }
+    }
+
+    // Runs fn(begin, end, part) over [0, n) split across the worker threads
+    template <typename Fn>
+    unsigned parallelFor(size_t n, Fn fn) const {
+        unsigned parts = static_cast<unsigned>(std::min<size_t>(threadCount, n / MIN_ROWS_PER_THREAD));
+        if (parts <= 1) {
+            fn(size_t(0), n, 0u);
+            return 1;
+        }
+        std::vector<std::thread> workers;
+        size_t step = (n + parts - 1) / parts;
+        for (unsigned p = 1; p < parts; p++) {
+            size_t begin = p * step, end = std::min(n, begin + step);
+            workers.emplace_back([=] { fn(begin, end, p); });
+        }
+        fn(size_t(0), std::min(n, step), 0u);
+        for (std::thread& t : workers) t.join();
+        return parts;
+    }
+
+    // sums[key] += value over one slice. Four interleaved sub-tables keep
+    // consecutive rows with the same key from serialising on one counter.
+    static void groupSumKernel(const int32_t* keys, const int64_t* values, size_t n,
+        int64_t* lanes, size_t domain) {
+        int64_t* l0 = lanes;
+        int64_t* l1 = lanes + domain;
+        int64_t* l2 = lanes + 2 * domain;
+        int64_t* l3 = lanes + 3 * domain;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            l0[keys[i]] += values[i];
+            l1[keys[i + 1]] += values[i + 1];
+            l2[keys[i + 2]] += values[i + 2];
+            l3[keys[i + 3]] += values[i + 3];
+        }
+        for (; i < n; i++) l0[keys[i]] += values[i];
+    }
+
+    // Folds per-thread / per-lane partial tables into out (contiguous, vectorises)
+    static void reduceLanes(const std::vector<int64_t>& partials, size_t tables, size_t domain, int64_t* out) {
+        for (size_t t = 0; t < tables; t++) {
+            const int64_t* src = partials.data() + t * domain;
+            for (size_t k = 0; k < domain; k++) out[k] += src[k];
+        }
+    }
+
+    std::vector<int64_t> groupSum(const std::vector<int64_t>& values, size_t domain) const {
+        std::vector<int64_t> partials(threadCount * 4 * domain, 0);
+        unsigned parts = parallelFor(values.size(), [&](size_t begin, size_t end, unsigned p) {
+            groupSumKernel(itemMenu.data() + begin, values.data() + begin, end - begin,
+                partials.data() + p * 4 * domain, domain);
+        });
+        std::vector<int64_t> out(domain, 0);
+        reduceLanes(partials, parts * 4, domain, out.data());
+        return out;
+    }
+
+    // 24-bucket histogram of hour bytes. With SSE2, 16 rows per step are
+    // compared against each hour and counted in byte lanes, which are widened
+    // with SAD before they can overflow.
+    static void hourHistogramKernel(const uint8_t* hours, size_t n, int64_t* counts) {
+        size_t i = 0;
+#ifdef ANALYTICS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while (i + 16 <= n) {
+            __m128i acc[24];
+            for (int h = 0; h < 24; h++) acc[h] = zero;
+            size_t blockEnd = std::min(n - (n - i) % 16, i + 255 * 16);
+            for (; i < blockEnd; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hours + i));
+                for (int h = 0; h < 24; h++) {
+                    acc[h] = _mm_sub_epi8(acc[h], _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(h))));
+                }
+            }
+            for (int h = 0; h < 24; h++) {
+                __m128i sums = _mm_sad_epu8(acc[h], zero);
+                counts[h] += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+            }
+        }
+#endif
+        for (; i < n; i++) {
+            if (hours[i] < 24) counts[hours[i]]++;
+        }
+    }
+
+public:
+    ColumnarSales() {
+        unsigned hw = std::thread::hardware_concurrency();
+        threadCount = hw > 0 ? hw : 1;
+    }
+
+    void clear() {
+        itemMenu.clear();
+        itemQuantity.clear();
+        itemCents.clear();
+        itemFirst.clear();
+        orderHour.clear();
+        lastOrderID = 0;
+    }
+
+    // Loads orders (and their items) placed since the previous refresh
+    void refresh(sql::Connection* con) {
+        loadDictionaries(con);
+
+        std::unique_ptr<sql::PreparedStatement> ordStmt(con->prepareStatement(
+            "SELECT OrdersID, HOUR(OrdersDate) AS h FROM orders WHERE OrdersID > ? ORDER BY OrdersID"));
+        ordStmt->setInt(1, lastOrderID);
+        std::unique_ptr<sql::ResultSet> ord(ordStmt->executeQuery());
+        int newLast = lastOrderID;
+        while (ord->next()) {
+            orderHour.push_back(static_cast<uint8_t>(ord->getInt("h")));
+            newLast = ord->getInt("OrdersID");
+        }
+        if (newLast == lastOrderID) return;
+
+        std::unique_ptr<sql::PreparedStatement> itemStmt(con->prepareStatement(
+            "SELECT oi.OrdersID, oi.MenuID, oi.Quantity, "
+            "oi.Quantity * ROUND(IFNULL(oi.UnitPrice, m.Price) * 100) AS LineCents FROM order_item oi "
+            "LEFT JOIN menu m ON m.MenuID = oi.MenuID "
+            "WHERE oi.OrdersID > ? AND oi.OrdersID <= ? ORDER BY oi.OrdersID, oi.MenuID"));
+        itemStmt->setInt(1, lastOrderID);
+        itemStmt->setInt(2, newLast);
+        std::unique_ptr<sql::ResultSet> items(itemStmt->executeQuery());
+        int prevOrder = -1, prevMenu = -1;
+        while (items->next()) {
+            int orderID = items->getInt("OrdersID");
+            int menuID = items->getInt("MenuID");
+            itemMenu.push_back(menuSlot(menuID));
+            itemQuantity.push_back(items->getInt64("Quantity"));
+            itemCents.push_back(items->isNull("LineCents") ? 0 : items->getInt64("LineCents"));
+            itemFirst.push_back(orderID != prevOrder || menuID != prevMenu ? 1 : 0);
+            prevOrder = orderID;
+            prevMenu = menuID;
+        }
+        lastOrderID = newLast;
+    }
+
+    size_t itemRows() const { return itemQuantity.size(); }
+    size_t orderRows() const { return orderHour.size(); }
+    unsigned threads() const { return threadCount; }
+
+    std::vector<CategorySalesRow> categorySales() const {
+        size_t domain = menuIDs.size();
+        std::vector<int64_t> qty = groupSum(itemQuantity, domain);
+        std::vector<int64_t> cents = groupSum(itemCents, domain);
+
+        std::vector<int64_t> catQty(categoryIDs.size(), 0), catCents(categoryIDs.size(), 0);
+        for (size_t m = 0; m < domain; m++) {
+            if (!menuPresent[m] || menuCategory[m] < 0 || qty[m] == 0) continue;
+            catQty[menuCategory[m]] += qty[m];
+            catCents[menuCategory[m]] += cents[m];
+        }
+
+        std::vector<CategorySalesRow> rows;
+        for (size_t c = 0; c < categoryIDs.size(); c++) {
+            if (!categoryPresent[c] || catQty[c] == 0) continue;
+            CategorySalesRow row = { categoryIDs[c], categoryNames[c], catQty[c], catCents[c] / 100.0 };
+            rows.push_back(row);
+        }
+        std::sort(rows.begin(), rows.end(), [](const CategorySalesRow& a, const CategorySalesRow& b) {
+            return a.sales > b.sales;
+        });
+        return rows;
+    }
+
+    std::vector<TopSellerRow> topSellers(size_t limit = 10) const {
+        size_t domain = menuIDs.size();
+        std::vector<int64_t> qty = groupSum(itemQuantity, domain);
+        std::vector<int64_t> orders = groupSum(itemFirst, domain);
+        std::vector<int64_t> cents = groupSum(itemCents, domain);
+
+        std::vector<TopSellerRow> rows;
+        for (size_t m = 0; m < domain; m++) {
+            if (!menuPresent[m] || qty[m] == 0) continue;
+            TopSellerRow row = { menuIDs[m], menuNames[m], orders[m], qty[m], cents[m] / 100.0 };
+            rows.push_back(row);
+        }
+        size_t keep = std::min(limit, rows.size());
+        std::partial_sort(rows.begin(), rows.begin() + keep, rows.end(), [](const TopSellerRow& a, const TopSellerRow& b) {
+            return a.totalSold != b.totalSold ? a.totalSold > b.totalSold : a.menuID < b.menuID;
+        });
+        rows.resize(keep);
+        return rows;
+    }
+
+    // Orders per hour of day, 24 entries
+    std::vector<int64_t> hourlyOrders() const {
+        std::vector<int64_t> partials(threadCount * 24, 0);
+        unsigned parts = parallelFor(orderHour.size(), [&](size_t begin, size_t end, unsigned p) {
+            hourHistogramKernel(orderHour.data() + begin, end - begin, partials.data() + p * 24);
+        });
+        std::vector<int64_t> out(24, 0);
+        reduceLanes(partials, parts, 24, out.data());
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,565 @@
+#ifndef CLAIM_QUEUE_H
+#define CLAIM_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "geo.h"
+#include "order_events.h"
+#include "delivery_log.h"
+
+// Bounded multi-producer / multi-consumer queue (Vyukov). Each cell carries a
+// sequence number telling producers and consumers whose turn it is, so push
+// and pop are a single CAS on the tail / head index and never block.
+// Capacity is rounded up to a power of two.
+template <typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    char pad0[64];
+    std::atomic<size_t> tail;
+    char pad1[64];
+    std::atomic<size_t> head;
+    char pad2[64];
+
+public:
+    explicit MpmcQueue(size_t capacity = 4096) : tail(0), head(0) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // False when full
+    bool push(T value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // False when empty
+    bool pop(T& out) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->value = T();
+        cell->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t approxSize() const {
+        size_t t = tail.load(std::memory_order_relaxed), h = head.load(std::memory_order_relaxed);
+        return t > h ? t - h : 0;
+    }
+};
+
+enum ClaimState { CLAIM_OPEN, CLAIM_RESERVED, CLAIM_CONFIRMED, CLAIM_LOST };
+
+// One open order in the claim queues. `state` and `riderID` move forward
+// only by CAS: open -> reserved by a rider (in memory) -> confirmed or lost
+// once the conditional UPDATE has run. An order claimed through another
+// path (manual accept, dispatcher) goes straight from open to lost.
+struct ClaimTicket {
+    int orderID;
+    std::string zone;
+    std::atomic<int> state;
+    std::atomic<int> riderID;
+    int persistAttempts;                    // writer thread only
+    std::chrono::steady_clock::time_point retryAt;  // writer thread only
+    std::mutex doneLock;
+    std::condition_variable done;           // the rider waiting on this claim
+
+    ClaimTicket(int id, const std::string& zoneName) : orderID(id), zone(zoneName), state(CLAIM_OPEN), riderID(0), persistAttempts(0) {}
+};
+
+// Lock-free claim front for riders. Open orders sit in one MPMC queue per
+// zone (the delivery postcode). Each zone owns a slot of a fixed
+// open-addressed table, claimed by CAS with linear probing, so two busy
+// zones never share a queue. A rider's
+// claim is a pop plus a CAS on the ticket, so of many riders grabbing at
+// once each gets a different order and nobody waits on a row lock. A writer
+// thread then persists claims with the usual conditional UPDATE on its own
+// connection; if the database says the order was already taken, the claim
+// is marked lost and the rider simply grabs again.
+class ClaimService {
+public:
+    enum { ZONE_SLOTS = 256, QUEUE_CAPACITY = 4096 };
+
+private:
+    // A zone's queue, created the first time an order arrives for it and
+    // kept until the service is destroyed
+    struct Zone {
+        std::string name;
+        MpmcQueue<std::shared_ptr<ClaimTicket>> queue;
+
+        explicit Zone(const std::string& zoneName) : name(zoneName), queue(QUEUE_CAPACITY) {}
+    };
+
+    std::atomic<Zone*> zones[ZONE_SLOTS];
+    MpmcQueue<std::shared_ptr<ClaimTicket>> toPersist;
+
+    // orderID -> ticket, for status lookups and claims made elsewhere. Only
+    // touched when orders arrive or finish, never on the rider's pop path.
+    std::map<int, std::shared_ptr<ClaimTicket>> tickets;
+    std::unordered_map<int, std::string> customerZone;
+    std::mutex indexLock;
+
+    std::mutex wakeLock;
+    std::condition_variable wake;           // writer wake-up
+    std::atomic<bool> stopping;
+    std::thread writer;
+    OrderEvents* events = nullptr;
+    std::function<void(int, int)> onConfirmed;
+
+    std::atomic<long long> reserved, confirmed, lost, emptyPops;
+
+    enum { KEEP_FINISHED = 10000, PERSIST_ATTEMPTS = 3, RETRY_BACKOFF_MS = 50 };
+
+    // The zone's queue, or null if no order has arrived for it. With
+    // `create`, an empty slot along the probe is claimed for it; null then
+    // means every slot is taken by other zones.
+    Zone* findZone(const std::string& name, bool create) {
+        size_t home = std::hash<std::string>()(name) % ZONE_SLOTS;
+        for (size_t k = 0; k < ZONE_SLOTS; k++) {
+            std::atomic<Zone*>& slot = zones[(home + k) % ZONE_SLOTS];
+            Zone* zone = slot.load(std::memory_order_acquire);
+            if (!zone) {
+                if (!create) return nullptr;
+                std::unique_ptr<Zone> fresh(new Zone(name));
+                if (slot.compare_exchange_strong(zone, fresh.get(), std::memory_order_acq_rel)) return fresh.release();
+                // Lost the slot; `zone` now holds the winner
+            }
+            if (zone->name == name) return zone;
+        }
+        return nullptr;
+    }
+
+    void enqueue(int orderID, const std::string& zone) {
+        std::shared_ptr<ClaimTicket> ticket = std::make_shared<ClaimTicket>(orderID, zone);
+        {
+            std::lock_guard<std::mutex> lock(indexLock);
+            if (tickets.count(orderID)) return;
+            tickets[orderID] = ticket;
+        }
+        // A full zone (or zone table) leaves the order to manual accept by ID
+        Zone* slot = findZone(zone, true);
+        if (!slot || !slot->queue.push(ticket)) {
+            std::lock_guard<std::mutex> lock(indexLock);
+            tickets.erase(orderID);
+        }
+    }
+
+    // Postcode of the customer's address, cached per customer
+    std::string zoneOfCustomer(sql::Connection* con, int customerID) {
+        {
+            std::lock_guard<std::mutex> lock(indexLock);
+            auto it = customerZone.find(customerID);
+            if (it != customerZone.end()) return it->second;
+        }
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT Customer_Address FROM customer WHERE CustomerID=?"));
+        pstmt->setInt(1, customerID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        std::string zone = res->next() ? GeocodeTable::postcodeOf(res->getString("Customer_Address")) : "";
+        std::lock_guard<std::mutex> lock(indexLock);
+        customerZone[customerID] = zone;
+        return zone;
+    }
+
+    void finish(ClaimTicket& ticket, bool won) {
+        ticket.state.store(won ? CLAIM_CONFIRMED : CLAIM_LOST);
+        (won ? confirmed : lost)++;
+        {
+            std::lock_guard<std::mutex> lock(ticket.doneLock);
+        }
+        ticket.done.notify_all();
+    }
+
+    void prune() {
+        std::lock_guard<std::mutex> lock(indexLock);
+        if (tickets.size() <= KEEP_FINISHED) return;
+        for (auto it = tickets.begin(); it != tickets.end() && tickets.size() > KEEP_FINISHED / 2;) {
+            int state = it->second->state.load();
+            if (state == CLAIM_CONFIRMED || state == CLAIM_LOST) it = tickets.erase(it);
+            else ++it;
+        }
+    }
+
+    void writerLoop() {
+        sql::Driver* driver = get_driver_instance();
+        driver->threadInit();
+        std::unique_ptr<sql::Connection> con;
+        std::unique_ptr<sql::PreparedStatement> claim;
+        std::vector<std::shared_ptr<ClaimTicket>> retries;     // failed writes waiting out their backoff
+
+        while (true) {
+            // Retries whose backoff has passed go first, then new claims;
+            // a failing claim never holds up the ones queued behind it
+            std::shared_ptr<ClaimTicket> ticket;
+            auto now = std::chrono::steady_clock::now();
+            auto due = std::find_if(retries.begin(), retries.end(),
+                [&](const std::shared_ptr<ClaimTicket>& t) { return t->retryAt <= now; });
+            if (due != retries.end()) {
+                ticket = *due;
+                retries.erase(due);
+            }
+            else if (!toPersist.pop(ticket)) {
+                if (stopping.load() && retries.empty()) break;
+                std::unique_lock<std::mutex> lock(wakeLock);
+                wake.wait_for(lock, std::chrono::milliseconds(20));
+                continue;
+            }
+
+            int riderID = ticket->riderID.load();
+            bool won = false, failed = false;
+            try {
+                if (!con || !con->isValid()) {
+                    con.reset(openConnection());
+                    claim.reset(con->prepareStatement(
+                        "UPDATE orders SET DeliveryID=?, Orders_status='Accepted' WHERE OrdersID=? AND DeliveryID IS NULL"));
+                }
+                claim->setInt(1, riderID);
+                claim->setInt(2, ticket->orderID);
+                won = claim->executeUpdate() > 0;
+            }
+            catch (sql::SQLException&) {
+                claim.reset();
+                con.reset();
+                failed = true;
+            }
+            if (won) {
+                try {
+                    DeliveryLog::record(con.get(), ticket->orderID, riderID, "Accepted");
+                }
+                catch (sql::SQLException&) {}       // the claim stands without its timestamp
+            }
+            if (failed) {
+                // Nothing was written. The rider keeps the reservation while
+                // the UPDATE is retried on a fresh connection; if it still
+                // cannot be written the claim is lost and the order, still
+                // unassigned in the database, is left to manual accept and
+                // the next seed().
+                if (++ticket->persistAttempts < PERSIST_ATTEMPTS) {
+                    ticket->retryAt = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(RETRY_BACKOFF_MS * ticket->persistAttempts);
+                    retries.push_back(ticket);
+                    continue;
+                }
+                finish(*ticket, false);
+                std::lock_guard<std::mutex> lock(indexLock);
+                tickets.erase(ticket->orderID);
+                continue;
+            }
+            finish(*ticket, won);
+            if (won) {
+                if (onConfirmed) onConfirmed(ticket->orderID, riderID);
+                if (events) {
+                    OrderClaimedEvent event = { ticket->orderID, riderID, time(nullptr) };
+                    events->publish(event);
+                }
+            }
+            prune();
+        }
+
+        claim.reset();
+        con.reset();
+        driver->threadEnd();
+    }
+
+public:
+    ClaimService() : toPersist(QUEUE_CAPACITY), stopping(false), reserved(0), confirmed(0), lost(0), emptyPops(0) {
+        for (size_t i = 0; i < ZONE_SLOTS; i++) zones[i].store(nullptr);
+    }
+
+    ~ClaimService() {
+        stop();
+        for (size_t i = 0; i < ZONE_SLOTS; i++) delete zones[i].load();
+    }
+
+    ClaimService(const ClaimService&) = delete;
+    ClaimService& operator=(const ClaimService&) = delete;
+
+    // Set before start()
+    void setEventBus(OrderEvents* bus) { events = bus; }
+    void setConfirmedCallback(std::function<void(int orderID, int riderID)> callback) { onConfirmed = callback; }
+
+    void start() {
+        if (!writer.joinable()) writer = std::thread(&ClaimService::writerLoop, this);
+    }
+
+    // Drains claims already reserved, then stops the writer
+    void stop() {
+        stopping.store(true);
+        wake.notify_all();
+        if (writer.joinable()) writer.join();
+    }
+
+    // Queues the orders that are open now
+    void seed(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT o.OrdersID, o.CustomerID, c.Customer_Address FROM orders o "
+            "JOIN customer c ON o.CustomerID = c.CustomerID "
+            "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL "
+            "ORDER BY o.OrdersID"));
+        while (res->next()) {
+            std::string zone = GeocodeTable::postcodeOf(res->getString("Customer_Address"));
+            {
+                std::lock_guard<std::mutex> lock(indexLock);
+                customerZone[res->getInt("CustomerID")] = zone;
+            }
+            enqueue(res->getInt("OrdersID"), zone);
+        }
+    }
+
+    // New orders are queued in their customer's zone (looked up on `con` the
+    // first time a customer orders); claims made elsewhere retire tickets
+    void attach(OrderEvents& bus, sql::Connection* con) {
+        bus.onOrderPlaced([this, con](const OrderPlacedEvent& e) {
+            std::string zone;
+            try {
+                zone = zoneOfCustomer(con, e.customerID);
+            }
+            catch (sql::SQLException&) {}
+            enqueue(e.orderID, zone);
+        });
+        bus.onOrderClaimed([this](const OrderClaimedEvent& e) { claimedElsewhere(e.orderID); });
+    }
+
+    void claimedElsewhere(int orderID) {
+        std::shared_ptr<ClaimTicket> ticket;
+        {
+            std::lock_guard<std::mutex> lock(indexLock);
+            auto it = tickets.find(orderID);
+            if (it == tickets.end()) return;
+            ticket = it->second;
+        }
+        int open = CLAIM_OPEN;
+        if (ticket->state.compare_exchange_strong(open, CLAIM_LOST)) {
+            std::lock_guard<std::mutex> lock(indexLock);
+            tickets.erase(orderID);
+        }
+    }
+
+    // Reserves the oldest available order in `zone` ("" = any zone) for the
+    // rider. Returns the order ID, or 0 if none is open. No database access:
+    // persistence happens on the writer thread.
+    int claimNext(int riderID, const std::string& zone = "") {
+        Zone* only = zone.empty() ? nullptr : findZone(zone, false);
+        size_t slots = zone.empty() ? ZONE_SLOTS : (only ? 1 : 0);
+        for (size_t k = 0; k < slots; k++) {
+            Zone* z = only ? only : zones[k].load(std::memory_order_acquire);
+            if (!z) continue;
+            std::shared_ptr<ClaimTicket> ticket;
+            while (z->queue.pop(ticket)) {
+                int open = CLAIM_OPEN;
+                if (!ticket->state.compare_exchange_strong(open, CLAIM_RESERVED)) continue;  // taken elsewhere
+                ticket->riderID.store(riderID);
+                reserved++;
+                while (!toPersist.push(ticket)) std::this_thread::yield();
+                wake.notify_all();
+                return ticket->orderID;
+            }
+        }
+        emptyPops++;
+        return 0;
+    }
+
+    ClaimState state(int orderID) {
+        std::lock_guard<std::mutex> lock(indexLock);
+        auto it = tickets.find(orderID);
+        return it == tickets.end() ? CLAIM_LOST : static_cast<ClaimState>(it->second->state.load());
+    }
+
+    // Waits up to timeoutMs for a reserved claim to be confirmed or lost
+    ClaimState waitForResult(int orderID, int timeoutMs) {
+        std::shared_ptr<ClaimTicket> ticket;
+        {
+            std::lock_guard<std::mutex> lock(indexLock);
+            auto it = tickets.find(orderID);
+            if (it == tickets.end()) return CLAIM_LOST;
+            ticket = it->second;
+        }
+        std::unique_lock<std::mutex> lock(ticket->doneLock);
+        ticket->done.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return ticket->state.load() >= CLAIM_CONFIRMED; });
+        return static_cast<ClaimState>(ticket->state.load());
+    }
+
+    size_t queued() const {
+        size_t total = 0;
+        for (size_t i = 0; i < ZONE_SLOTS; i++) {
+            const Zone* zone = zones[i].load(std::memory_order_acquire);
+            if (zone) total += zone->queue.approxSize();
+        }
+        return total;
+    }
+
+    long long reservedCount() const { return reserved.load(); }
+    long long confirmedCount() const { return confirmed.load(); }
+    long long lostCount() const { return lost.load(); }
+};
+
+struct ClaimBenchmark {
+    int riders;
+    int orders;
+    double rowLockMs;               // wall time, riders claiming through the database
+    long long rowLockRoundTrips;    // conditional UPDATEs issued, including lost ones
+    double rowLockWaitMs;           // mean time a rider spent getting an order
+    double queueMs;                 // wall time, riders popping the claim queue
+    long long queueRoundTrips;      // one persisted UPDATE per order
+    double queueWaitUs;             // mean time a rider spent getting an order
+};
+
+// Riders grabbing `orders` orders at once. Row-lock mode models today's
+// accept: every rider goes for the oldest order it believes is free and
+// holds that row for one simulated round trip; losers retry on the next
+// order. Queue mode pops the MPMC queue and leaves the UPDATE to the writer.
+inline ClaimBenchmark benchmarkClaimContention(int riders = 64, int orders = 2000, int roundTripMicros = 300) {
+    ClaimBenchmark bench = {};
+    bench.riders = riders;
+    bench.orders = orders;
+
+    {
+        std::vector<std::unique_ptr<std::mutex>> rowLocks;
+        for (int i = 0; i < orders; i++) rowLocks.push_back(std::unique_ptr<std::mutex>(new std::mutex()));
+        std::unique_ptr<std::atomic<int>[]> owner(new std::atomic<int>[orders]);
+        for (int i = 0; i < orders; i++) owner[i].store(0);
+        std::atomic<int> oldestOpen(0);
+        std::atomic<long long> trips(0), waitNanos(0), claims(0);
+
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int r = 1; r <= riders; r++) {
+            workers.emplace_back([&, r] {
+                while (true) {
+                    auto start = std::chrono::steady_clock::now();
+                    bool got = false;
+                    for (int i = oldestOpen.load(); i < orders && !got; i++) {
+                        if (owner[i].load() != 0) continue;          // stale listing says free
+                        std::lock_guard<std::mutex> row(*rowLocks[i]);
+                        std::this_thread::sleep_for(std::chrono::microseconds(roundTripMicros));
+                        trips++;
+                        int none = 0;
+                        got = owner[i].compare_exchange_strong(none, r);
+                        if (got) {
+                            int expected = i;
+                            oldestOpen.compare_exchange_strong(expected, i + 1);
+                        }
+                    }
+                    if (!got) break;
+                    claims++;
+                    waitNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                }
+            });
+        }
+        for (std::thread& t : workers) t.join();
+        bench.rowLockMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        bench.rowLockRoundTrips = trips.load();
+        bench.rowLockWaitMs = claims.load() > 0 ? waitNanos.load() / 1e6 / claims.load() : 0.0;
+    }
+
+    {
+        MpmcQueue<int> queue(static_cast<size_t>(orders));
+        for (int i = 1; i <= orders; i++) queue.push(i);
+        MpmcQueue<int> persist(static_cast<size_t>(orders));
+        std::atomic<long long> waitNanos(0), claims(0), trips(0);
+        std::atomic<bool> done(false);
+
+        auto begin = std::chrono::steady_clock::now();
+        std::thread writerThread([&] {
+            int orderID;
+            while (true) {
+                if (persist.pop(orderID)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(roundTripMicros));
+                    trips++;
+                }
+                else if (done.load()) {
+                    break;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        std::vector<std::thread> workers;
+        for (int r = 1; r <= riders; r++) {
+            workers.emplace_back([&] {
+                int orderID;
+                while (true) {
+                    auto start = std::chrono::steady_clock::now();
+                    if (!queue.pop(orderID)) break;
+                    persist.push(orderID);
+                    claims++;
+                    waitNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                }
+            });
+        }
+        for (std::thread& t : workers) t.join();
+        bench.queueMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        done.store(true);
+        writerThread.join();
+        bench.queueRoundTrips = trips.load();
+        bench.queueWaitUs = claims.load() > 0 ? waitNanos.load() / 1e3 / claims.load() : 0.0;
+    }
+    return bench;
+}
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef COHORT_H
+#define COHORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+
+struct CohortRow {
+    int month;                          // YYYYMM of the customers' first order
+    long long customers;                // customers whose first order fell in that month
+    long long repeaters;                // ... who have ordered at least twice so far
+    std::vector<long long> active;      // active[k]: ordered again k months later (active[0] = customers)
+};
+
+struct CohortReport {
+    std::vector<CohortRow> cohorts;     // oldest first
+    std::vector<int> curveDays;         // repeat-rate curve thresholds
+    std::vector<double> repeatWithin;   // share of customers with a 2nd order within curveDays[i] days
+    long long customers;
+    long long orders;
+    int lastMonth;                      // YYYYMM of the newest order; later cells are not observed yet
+};
+
+// First-order cohorts and month-by-month retention over the whole order
+// history, in memory. Each order is one 64-bit key, (CustomerID << 16) | day
+// (days since 1970), so sorting the keys groups every customer's orders
+// together in date order. The sort is a parallel LSD radix sort over just the
+// bits in use; the scan then splits the sorted keys at customer boundaries
+// and each thread counts into its own cohort x month-offset table.
+class CohortEngine {
+private:
+    std::vector<uint64_t> keys;
+    bool sorted = true;
+    uint32_t maxCustomer = 0;
+    int minDay = 0, maxDay = 0;
+    int lastOrderID = 0;
+    std::set<int> recentOrderIDs;       // already counted, within REFRESH_OVERLAP of lastOrderID
+    unsigned threadCount;
+
+    // Refreshes re-read this many IDs below the newest one seen, so orders
+    // that commit out of ID order are still picked up
+    enum { DAY_BITS = 16, RADIX_BITS = 11, MIN_KEYS_PER_THREAD = 1 << 16, REFRESH_OVERLAP = 1000 };
+
+    static int dayOf(uint64_t key) { return static_cast<int>(key & 0xffff); }
+    static uint32_t customerOf(uint64_t key) { return static_cast<uint32_t>(key >> DAY_BITS); }
+
+    // Days since 1970-01-01 -> months since year 0 (proleptic Gregorian)
+    static int monthIndexOfDay(int day) {
+        int z = day + 719468;
+        int era = z / 146097;
+        int doe = z - era * 146097;
+        int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int mp = (5 * doy + 2) / 153;
+        int month = mp < 10 ? mp + 3 : mp - 9;
+        int year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+        return year * 12 + month - 1;
+    }
+
+    static int yyyymm(int monthIndex) { return (monthIndex / 12) * 100 + monthIndex % 12 + 1; }
+
+    unsigned partsFor(size_t n) const {
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threadCount, n / MIN_KEYS_PER_THREAD)));
+    }
+
+    template <typename Fn>
+    static void runParts(unsigned parts, Fn fn) {
+        std::vector<std::thread> workers;
+        for (unsigned p = 1; p < parts; p++) workers.emplace_back([=] { fn(p); });
+        fn(0u);
+        for (std::thread& t : workers) t.join();
+    }
+
+    // Stable LSD radix sort, RADIX_BITS per pass. Each thread histograms its
+    // slice, the per-(digit, thread) offsets are prefix-summed, and each thread
+    // scatters its slice, which keeps the pass stable. Passes whose digit is
+    // the same for every key are skipped.
+    void radixSort() {
+        size_t n = keys.size();
+        int bits = DAY_BITS;
+        while (bits < 64 && (static_cast<uint64_t>(maxCustomer) >> (bits - DAY_BITS)) != 0) bits++;
+
+        const size_t buckets = size_t(1) << RADIX_BITS;
+        unsigned parts = partsFor(n);
+        size_t step = (n + parts - 1) / parts;
+        std::vector<uint64_t> buffer(n);
+        std::vector<size_t> counts(parts * buckets);
+
+        for (int shift = 0; shift < bits; shift += RADIX_BITS) {
+            std::fill(counts.begin(), counts.end(), 0);
+            runParts(parts, [&](unsigned p) {
+                size_t* c = counts.data() + p * buckets;
+                size_t end = std::min(n, (p + 1) * step);
+                for (size_t i = p * step; i < end; i++) c[(keys[i] >> shift) & (buckets - 1)]++;
+            });
+
+            bool trivial = false;
+            size_t offset = 0;
+            for (size_t d = 0; d < buckets; d++) {
+                size_t total = 0;
+                for (unsigned p = 0; p < parts; p++) total += counts[p * buckets + d];
+                if (total == n) trivial = true;
+                for (unsigned p = 0; p < parts; p++) {
+                    size_t c = counts[p * buckets + d];
+                    counts[p * buckets + d] = offset;
+                    offset += c;
+                }
+            }
+            if (trivial) continue;
+
+            runParts(parts, [&](unsigned p) {
+                size_t* pos = counts.data() + p * buckets;
+                size_t end = std::min(n, (p + 1) * step);
+                for (size_t i = p * step; i < end; i++) buffer[pos[(keys[i] >> shift) & (buckets - 1)]++] = keys[i];
+            });
+            keys.swap(buffer);
+        }
+        sorted = true;
+    }
+
+    void add(uint32_t customerID, int day) {
+        if (day < 0) day = 0;
+        if (day > 0xffff) day = 0xffff;
+        if (keys.empty() || day < minDay) minDay = day;
+        if (keys.empty() || day > maxDay) maxDay = day;
+        if (customerID > maxCustomer) maxCustomer = customerID;
+        keys.push_back((static_cast<uint64_t>(customerID) << DAY_BITS) | static_cast<uint64_t>(day));
+        sorted = false;
+    }
+
+public:
+    CohortEngine() {
+        unsigned hw = std::thread::hardware_concurrency();
+        threadCount = hw > 0 ? hw : 1;
+    }
+
+    void clear() {
+        keys.clear();
+        sorted = true;
+        maxCustomer = 0;
+        minDay = maxDay = 0;
+        lastOrderID = 0;
+        recentOrderIDs.clear();
+    }
+
+    size_t orderCount() const { return keys.size(); }
+    unsigned threads() const { return threadCount; }
+
+    // Appends orders placed since the previous refresh
+    void refresh(sql::Connection* con) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT OrdersID, CustomerID, TO_DAYS(OrdersDate) - TO_DAYS('1970-01-01') AS d "
+            "FROM orders WHERE OrdersID > ? AND OrdersDate IS NOT NULL ORDER BY OrdersID"));
+        pstmt->setInt(1, std::max(0, lastOrderID - REFRESH_OVERLAP));
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        while (res->next()) {
+            int orderID = res->getInt("OrdersID");
+            if (!recentOrderIDs.insert(orderID).second) continue;
+            add(static_cast<uint32_t>(res->getInt("CustomerID")), res->getInt("d"));
+            lastOrderID = std::max(lastOrderID, orderID);
+        }
+        recentOrderIDs.erase(recentOrderIDs.begin(), recentOrderIDs.upper_bound(lastOrderID - REFRESH_OVERLAP));
+    }
+
+    // Replaces the data with `orders` synthetic orders from `customers`
+    // customers over the last two years (benchmarks)
+    void loadSynthetic(size_t orders, uint32_t customers, int today, uint64_t seed = 42) {
+        clear();
+        keys.reserve(orders);
+        uint64_t state = seed | 1;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (size_t i = 0; i < orders; i++) {
+            uint32_t customer = static_cast<uint32_t>(next() % customers) + 1;
+            // Each customer joins on a fixed day and orders on or after it
+            int join = today - 729 + static_cast<int>((customer * 2654435761u) % 730);
+            int day = join + static_cast<int>(next() % static_cast<uint64_t>(today - join + 1));
+            add(customer, day);
+        }
+    }
+
+    // Sorts if needed, then builds the cohort table: retention for
+    // monthOffsets months (including the first) and the repeat-rate curve
+    CohortReport compute(int monthOffsets = 7) {
+        if (!sorted) radixSort();
+
+        CohortReport report;
+        report.curveDays = { 7, 14, 30, 60, 90, 180 };
+        report.customers = 0;
+        report.orders = static_cast<long long>(keys.size());
+        report.lastMonth = keys.empty() ? 0 : yyyymm(monthIndexOfDay(maxDay));
+        if (keys.empty()) return report;
+
+        int firstMonth = monthIndexOfDay(minDay);
+        size_t cohortCount = static_cast<size_t>(monthIndexOfDay(maxDay) - firstMonth + 1);
+        size_t curveCount = report.curveDays.size();
+        size_t n = keys.size();
+
+        // Slice boundaries moved forward to the next customer change
+        unsigned parts = partsFor(n);
+        std::vector<size_t> bounds(parts + 1, n);
+        bounds[0] = 0;
+        for (unsigned p = 1; p < parts; p++) {
+            size_t b = std::max(bounds[p - 1], n * p / parts);
+            while (b > 0 && b < n && customerOf(keys[b]) == customerOf(keys[b - 1])) b++;
+            bounds[p] = b;
+        }
+
+        // Per part: [cohort][offset] active counts, then repeaters per cohort,
+        // then customers with a 2nd order within each curve threshold
+        size_t stride = cohortCount * monthOffsets + cohortCount + curveCount;
+        std::vector<long long> partials(parts * stride, 0);
+        runParts(parts, [&](unsigned p) {
+            long long* active = partials.data() + p * stride;
+            long long* repeaters = active + cohortCount * monthOffsets;
+            long long* curve = repeaters + cohortCount;
+            size_t i = bounds[p], end = bounds[p + 1];
+            while (i < end) {
+                uint32_t customer = customerOf(keys[i]);
+                int firstDay = dayOf(keys[i]);
+                int cohort = monthIndexOfDay(firstDay) - firstMonth;
+                int lastOffset = -1;
+                size_t orders = 0;
+                for (; i < end && customerOf(keys[i]) == customer; i++, orders++) {
+                    int day = dayOf(keys[i]);
+                    if (orders == 1) {
+                        repeaters[cohort]++;
+                        for (size_t c = 0; c < curveCount; c++) {
+                            if (day - firstDay <= report.curveDays[c]) curve[c]++;
+                        }
+                    }
+                    int offset = monthIndexOfDay(day) - firstMonth - cohort;
+                    if (offset != lastOffset && offset < monthOffsets) active[cohort * monthOffsets + offset]++;
+                    lastOffset = offset;
+                }
+            }
+        });
+
+        std::vector<long long> totals(stride, 0);
+        for (unsigned p = 0; p < parts; p++) {
+            const long long* src = partials.data() + p * stride;
+            for (size_t k = 0; k < stride; k++) totals[k] += src[k];
+        }
+
+        for (size_t c = 0; c < cohortCount; c++) {
+            CohortRow row;
+            row.month = yyyymm(firstMonth + static_cast<int>(c));
+            row.customers = totals[c * monthOffsets];
+            row.repeaters = totals[cohortCount * monthOffsets + c];
+            row.active.assign(totals.begin() + c * monthOffsets, totals.begin() + (c + 1) * monthOffsets);
+            report.customers += row.customers;
+            if (row.customers > 0) report.cohorts.push_back(row);
+        }
+        for (size_t k = 0; k < curveCount; k++) {
+            long long within = totals[cohortCount * monthOffsets + cohortCount + k];
+            report.repeatWithin.push_back(report.customers > 0 ? static_cast<double>(within) / report.customers : 0.0);
+        }
+        return report;
+    }
+
+    // The same report from a plain map of per-customer order days, without
+    // the radix sort or the partitioned scan; used to check compute()
+    CohortReport computeBruteForce(int monthOffsets = 7) const {
+        CohortReport report;
+        report.curveDays = { 7, 14, 30, 60, 90, 180 };
+        report.customers = 0;
+        report.orders = static_cast<long long>(keys.size());
+        report.lastMonth = keys.empty() ? 0 : yyyymm(monthIndexOfDay(maxDay));
+
+        std::map<uint32_t, std::multiset<int>> days;
+        for (uint64_t key : keys) days[customerOf(key)].insert(dayOf(key));
+
+        std::map<int, CohortRow> rows;
+        std::vector<long long> within(report.curveDays.size(), 0);
+        for (const auto& customer : days) {
+            int firstDay = *customer.second.begin();
+            int cohort = monthIndexOfDay(firstDay);
+            CohortRow& row = rows[cohort];
+            if (row.active.empty()) {
+                row.month = yyyymm(cohort);
+                row.customers = row.repeaters = 0;
+                row.active.assign(monthOffsets, 0);
+            }
+            row.customers++;
+            if (customer.second.size() >= 2) {
+                row.repeaters++;
+                int secondDay = *std::next(customer.second.begin());
+                for (size_t c = 0; c < report.curveDays.size(); c++) {
+                    if (secondDay - firstDay <= report.curveDays[c]) within[c]++;
+                }
+            }
+            std::set<int> offsets;
+            for (int day : customer.second) offsets.insert(monthIndexOfDay(day) - cohort);
+            for (int offset : offsets) {
+                if (offset < monthOffsets) row.active[offset]++;
+            }
+        }
+        for (const auto& row : rows) {
+            report.cohorts.push_back(row.second);
+            report.customers += row.second.customers;
+        }
+        for (long long w : within) {
+            report.repeatWithin.push_back(report.customers > 0 ? static_cast<double>(w) / report.customers : 0.0);
+        }
+        return report;
+    }
+
+    static bool sameReport(const CohortReport& a, const CohortReport& b) {
+        if (a.customers != b.customers || a.orders != b.orders || a.lastMonth != b.lastMonth
+            || a.cohorts.size() != b.cohorts.size() || a.repeatWithin != b.repeatWithin) return false;
+        for (size_t i = 0; i < a.cohorts.size(); i++) {
+            const CohortRow& x = a.cohorts[i];
+            const CohortRow& y = b.cohorts[i];
+            if (x.month != y.month || x.customers != y.customers || x.repeaters != y.repeaters || x.active != y.active) return false;
+        }
+        return true;
+    }
+};
+
+#endif
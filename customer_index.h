@@ -0,0 +1,104 @@
+#ifndef CUSTOMER_INDEX_H
+#define CUSTOMER_INDEX_H
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+
+// In-memory customer name index.
+// Names are split into lowercase alphanumeric tokens kept in one sorted array,
+// so "ali ah" resolves to every customer with a token starting with "ali" and
+// one starting with "ah" via two binary searches. New customers are picked up
+// incrementally by CustomerID; names are never edited by the app.
+class CustomerNameIndex {
+private:
+    std::vector<std::pair<std::string, int>> tokens;    // (token, CustomerID), sorted
+    std::unordered_map<int, std::string> names;
+    int maxLoadedID = 0;
+
+public:
+    static std::vector<std::string> tokenize(const std::string& text) {
+        std::vector<std::string> out;
+        std::string current;
+        for (char ch : text) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (isalnum(c)) {
+                current.push_back(static_cast<char>(tolower(c)));
+            }
+            else if (!current.empty()) {
+                out.push_back(current);
+                current.clear();
+            }
+        }
+        if (!current.empty()) out.push_back(current);
+        return out;
+    }
+
+    // Loads customers registered since the last refresh (PK range scan)
+    void refresh(sql::Connection* con) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT CustomerID, Customer_Name FROM customer WHERE CustomerID > ? ORDER BY CustomerID"));
+        pstmt->setInt(1, maxLoadedID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+        size_t before = tokens.size();
+        while (res->next()) {
+            int id = res->getInt("CustomerID");
+            std::string name = res->getString("Customer_Name");
+            for (const std::string& token : tokenize(name)) {
+                tokens.push_back(std::make_pair(token, id));
+            }
+            names[id] = name;
+            maxLoadedID = std::max(maxLoadedID, id);
+        }
+
+        if (tokens.size() != before) {
+            std::sort(tokens.begin() + before, tokens.end());
+            std::inplace_merge(tokens.begin(), tokens.begin() + before, tokens.end());
+        }
+    }
+
+    // CustomerIDs whose name has a token starting with each query token (ascending)
+    std::vector<int> lookup(const std::string& query) const {
+        std::vector<int> result;
+        bool first = true;
+
+        for (const std::string& prefix : tokenize(query)) {
+            std::vector<int> ids;
+            auto it = std::lower_bound(tokens.begin(), tokens.end(), std::make_pair(prefix, 0));
+            for (; it != tokens.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                ids.push_back(it->second);
+            }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+            if (first) {
+                result.swap(ids);
+                first = false;
+            }
+            else {
+                std::vector<int> both;
+                std::set_intersection(result.begin(), result.end(), ids.begin(), ids.end(), std::back_inserter(both));
+                result.swap(both);
+            }
+            if (result.empty()) break;
+        }
+        return result;
+    }
+
+    std::string nameOf(int customerID) const {
+        auto it = names.find(customerID);
+        return it == names.end() ? std::string() : it->second;
+    }
+
+    size_t customerCount() const { return names.size(); }
+};
+
+#endif
@@ -1,17 +1,102 @@
-#ifndef DATABASE_H
-#define DATABASE_H
-
-#include <memory>
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/connection.h>
-
-// Global database connection
-extern sql::Driver* driver;
-extern std::unique_ptr<sql::Connection> conn;
-
-// Database functions
-bool connectDatabase();
-void closeDatabase();
-
-#endif
+#ifndef DATABASE_H
+#define DATABASE_H
+
+#include <memory>
+#include <string>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/connection.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+
+// Connection settings shared by the main connection and worker connections
+#define DB_HOST     "tcp://127.0.0.1:3306"
+#define DB_USER     "root"
+#define DB_PASSWORD ""
+#define DB_SCHEMA   "fooddelivery"
+
+// Read replica for staleness-tolerant owner reads (see query_router.h)
+#define DB_REPLICA_HOST "tcp://127.0.0.1:3307"
+
+// Throwaway schema for load benchmarks that create large tables (--bench).
+// Empty disables them; never point it at DB_SCHEMA.
+#define DB_SCRATCH_SCHEMA ""
+
+// Global database connection
+extern sql::Driver* driver;
+extern std::unique_ptr<sql::Connection> conn;
+
+// Database functions
+bool connectDatabase();
+void closeDatabase();
+
+// Opens a new connection with the settings above (caller owns it)
+inline sql::Connection* openConnection() {
+    sql::Connection* con = get_driver_instance()->connect(DB_HOST, DB_USER, DB_PASSWORD);
+    con->setSchema(DB_SCHEMA);
+    return con;
+}
+
+// Null when no scratch schema is configured
+inline sql::Connection* openScratchConnection() {
+    if (std::string(DB_SCRATCH_SCHEMA).empty() || std::string(DB_SCRATCH_SCHEMA) == DB_SCHEMA) return nullptr;
+    sql::Connection* con = get_driver_instance()->connect(DB_HOST, DB_USER, DB_PASSWORD);
+    con->setSchema(DB_SCRATCH_SCHEMA);
+    return con;
+}
+
+inline sql::Connection* openReplicaConnection() {
+    sql::Connection* con = get_driver_instance()->connect(DB_REPLICA_HOST, DB_USER, DB_PASSWORD);
+    con->setSchema(DB_SCHEMA);
+    return con;
+}
+
+// Schema helpers for modules that add their own columns / indexes on first use
+inline bool tableExists(sql::Connection* con, const std::string& table) {
+    std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+        "SELECT COUNT(*) AS n FROM information_schema.TABLES "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ?"));
+    pstmt->setString(1, table);
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    return res->next() && res->getInt("n") > 0;
+}
+
+inline bool columnExists(sql::Connection* con, const std::string& table, const std::string& column) {
+    std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+        "SELECT COUNT(*) AS n FROM information_schema.COLUMNS "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND COLUMN_NAME = ?"));
+    pstmt->setString(1, table);
+    pstmt->setString(2, column);
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    return res->next() && res->getInt("n") > 0;
+}
+
+// Full column type as declared (e.g. "decimal(10,2)"), empty if the column is missing
+inline std::string columnType(sql::Connection* con, const std::string& table, const std::string& column) {
+    std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+        "SELECT COLUMN_TYPE FROM information_schema.COLUMNS "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND COLUMN_NAME = ?"));
+    pstmt->setString(1, table);
+    pstmt->setString(2, column);
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    return res->next() ? std::string(res->getString("COLUMN_TYPE")) : std::string();
+}
+
+// "?, ?, ?" for an IN (...) list or a VALUES row of n parameters
+inline std::string placeholders(size_t n) {
+    std::string out;
+    for (size_t i = 0; i < n; i++) out += i == 0 ? "?" : ", ?";
+    return out;
+}
+
+inline bool indexExists(sql::Connection* con, const std::string& table, const std::string& index) {
+    std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+        "SELECT COUNT(*) AS n FROM information_schema.STATISTICS "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND INDEX_NAME = ?"));
+    pstmt->setString(1, table);
+    pstmt->setString(2, index);
+    std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+    return res->next() && res->getInt("n") > 0;
+}
+
+#endif
@@ -1,120 +1,441 @@
-#ifndef DELIVERY_H
-#define DELIVERY_H
-
-#include <iostream>
-#include <string>
-#include <memory>
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-
-class Delivery {
-private:
-    sql::Connection* conn;
-
-public:
-    Delivery(sql::Connection* connection) : conn(connection) {}
-
-    int loginRider(std::string phone, std::string password) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "SELECT DeliveryID FROM delivery WHERE PhoneNUM=? AND Rider_pass=? AND Rider_Active='Y'"));
-            pstmt->setString(1, phone);
-            pstmt->setString(2, password);
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-            if (res->next()) return res->getInt("DeliveryID");
-            return -1;
-        }
-        catch (sql::SQLException& e) { return -1; }
-    }
-
-    void viewAvailableOrders() {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "SELECT o.OrdersID, o.OrdersDate, c.Customer_Name, c.Customer_Address FROM orders o "
-                "JOIN customer c ON o.CustomerID = c.CustomerID "
-                "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL"));
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-            std::cout << "\n=== Available Orders ===" << std::endl;
-            while (res->next()) {
-                std::cout << "ID: " << res->getInt("OrdersID") << " | Customer: " << res->getString("Customer_Name") << std::endl;
-            }
-        }
-        catch (sql::SQLException& e) { std::cerr << e.what(); }
-    }
-
-    bool acceptOrder(int orderID, int deliveryID) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "UPDATE orders SET DeliveryID=?, Orders_status='Out for Delivery' WHERE OrdersID=? AND DeliveryID IS NULL"));
-            pstmt->setInt(1, deliveryID);
-            pstmt->setInt(2, orderID);
-            return pstmt->executeUpdate() > 0;
-        }
-        catch (sql::SQLException& e) { return false; }
-    }
-
-    // FUNGSI PENTING: Untuk hilangkan error viewMyDeliveries
-    int viewMyDeliveries(int deliveryID) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "SELECT o.OrdersID, o.Orders_status, c.Customer_Name FROM orders o "
-                "JOIN customer c ON o.CustomerID = c.CustomerID WHERE o.DeliveryID=? AND o.Orders_status != 'Completed'"));
-            pstmt->setInt(1, deliveryID);
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-
-            std::cout << "\n=== My Current Deliveries ===" << std::endl;
-
-            int count = 0;
-            while (res->next()) {
-                std::cout << "Order ID: " << res->getInt("OrdersID")
-                    << " | Status: " << res->getString("Orders_status")
-                    << " | Customer: " << res->getString("Customer_Name") << std::endl;
-                count++;
-            }
-
-            if (count == 0) {
-                std::cout << "You have no active deliveries at the moment." << std::endl;
-            }
-            return count; // Pulangkan jumlah pesanan
-        }
-        catch (sql::SQLException& e) {
-            std::cerr << "Database error: " << e.what() << std::endl;
-            return 0;
-        }
-    }
-
-    // FUNGSI PENTING: Untuk hilangkan error updateDeliveryStatus
-    bool updateDeliveryStatus(int orderID, std::string status) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "UPDATE orders SET Orders_status=? WHERE OrdersID=?"));
-            pstmt->setString(1, status);
-            pstmt->setInt(2, orderID);
-            return pstmt->executeUpdate() > 0;
-        }
-        catch (sql::SQLException& e) { return false; }
-    }
-
-    bool completeDelivery(int orderID) {
-        return updateDeliveryStatus(orderID, "Completed");
-    }
-
-    // FUNGSI PENTING: Untuk hilangkan error viewDeliveryHistory
-    void viewDeliveryHistory(int deliveryID) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
-                "SELECT OrdersID, OrdersDate FROM orders WHERE DeliveryID=? AND Orders_status='Completed'"));
-            pstmt->setInt(1, deliveryID);
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-            std::cout << "\n=== My History ===" << std::endl;
-            while (res->next()) {
-                std::cout << "Order ID: " << res->getInt("OrdersID") << " | Date: " << res->getString("OrdersDate") << std::endl;
-            }
-        }
-        catch (sql::SQLException& e) { std::cerr << e.what(); }
-    }
-};
-
+#ifndef DELIVERY_H
+#define DELIVERY_H
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include "dispatch.h"
+#include "route_planner.h"
+#include "order_events.h"
+#include "open_orders_board.h"
+#include "claim_queue.h"
+#include "delivery_log.h"
+#include "location.h"
+#include "rider_rollup.h"
+
+class Delivery {
+private:
+    sql::Connection* conn;
+    DispatchEngine* dispatcher = nullptr;
+    OrderEvents* events = nullptr;
+    OpenOrdersBoard* board = nullptr;
+    ClaimService* claims = nullptr;
+    LocationService* locations = nullptr;
+    GeocodeTable geocodes;
+    bool geocodesLoaded = false;
+    RiderRollup rollup;
+
+    const GeocodeTable& geo() {
+        if (!geocodesLoaded) {
+            geocodes.load(conn);
+            geocodesLoaded = true;
+        }
+        return geocodes;
+    }
+
+    // A missing timestamp must not undo a change that already committed
+    void logEvent(int orderID, int deliveryID, const std::string& status) {
+        try {
+            if (deliveryID > 0) DeliveryLog::record(conn, orderID, deliveryID, status);
+            else DeliveryLog::record(conn, orderID, status);
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Delivery event not logged: " << e.what() << std::endl;
+        }
+    }
+
+public:
+    Delivery(sql::Connection* connection) : conn(connection), rollup(connection) {}
+
+    // Optional: keeps the auto-dispatcher's view of riders in step with
+    // orders accepted and completed by hand
+    void setDispatcher(DispatchEngine* engine) { dispatcher = engine; }
+
+    // Claims are published so the open-orders board drops them
+    void setEventBus(OrderEvents* bus) { events = bus; }
+
+    // Available orders are then listed from memory instead of the database
+    void setOpenOrdersBoard(OpenOrdersBoard* openOrders) { board = openOrders; }
+
+    OpenOrdersBoard* openOrdersBoard() const { return board; }
+
+    void setClaimService(ClaimService* service) { claims = service; }
+
+    void setLocationService(LocationService* service) { locations = service; }
+
+    // One GPS fix from the rider's device, timestamped now
+    bool shareLocation(int deliveryID, double lat, double lng) {
+        if (!locations) return false;
+        if (lat < -90.0 || lat > 90.0 || lng < -180.0 || lng > 180.0) {
+            std::cout << "Invalid coordinates." << std::endl;
+            return false;
+        }
+        LocationPing ping = { lat, lng, LocationService::nowMs() };
+        return locations->ingest(deliveryID, ping);
+    }
+
+    // Fast claim: reserves the next open order in the rider's zone (postcode,
+    // "" for any) from the in-memory claim queue and waits briefly for the
+    // database to confirm it. A lost claim moves straight on to the next
+    // order. Returns the confirmed order ID, or 0.
+    int grabNextOrder(int deliveryID, const std::string& zone) {
+        if (!claims) return 0;
+        for (int attempt = 0; attempt < 5; attempt++) {
+            int orderID = claims->claimNext(deliveryID, zone);
+            if (orderID == 0) {
+                std::cout << "No open orders" << (zone.empty() ? "" : " in " + zone) << " right now." << std::endl;
+                return 0;
+            }
+            ClaimState state = claims->waitForResult(orderID, 3000);
+            if (state == CLAIM_CONFIRMED) return orderID;
+            if (state == CLAIM_RESERVED) {
+                std::cout << "Order " << orderID << " is reserved for you; confirmation is still pending." << std::endl;
+                return orderID;
+            }
+            std::cout << "Order " << orderID << " was taken first, trying the next one..." << std::endl;
+        }
+        return 0;
+    }
+
+    int loginRider(std::string phone, std::string password) {
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "SELECT DeliveryID FROM delivery WHERE PhoneNUM=? AND Rider_pass=? AND Rider_Active='Y'"));
+            pstmt->setString(1, phone);
+            pstmt->setString(2, password);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            if (res->next()) return res->getInt("DeliveryID");
+            return -1;
+        }
+        catch (sql::SQLException& e) { return -1; }
+    }
+
+    void viewAvailableOrders() {
+        if (board) {
+            std::vector<OpenOrder> orders = board->snapshot();
+            std::cout << "\n=== Available Orders ===" << std::endl;
+            for (const OpenOrder& o : orders) printOpenOrder(o);
+            if (orders.empty()) std::cout << "No orders are waiting for a rider." << std::endl;
+            return;
+        }
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "SELECT o.OrdersID, o.OrdersDate, c.Customer_Name, c.Customer_Address FROM orders o "
+                "JOIN customer c ON o.CustomerID = c.CustomerID "
+                "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL"));
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            std::cout << "\n=== Available Orders ===" << std::endl;
+            while (res->next()) {
+                std::cout << "ID: " << res->getInt("OrdersID") << " | Customer: " << res->getString("Customer_Name") << std::endl;
+            }
+        }
+        catch (sql::SQLException& e) { std::cerr << e.what(); }
+    }
+
+    static void printOpenOrder(const OpenOrder& o) {
+        char placed[6] = "--:--";
+        struct tm t;
+#ifdef _WIN32
+        if (o.placedAt > 0 && localtime_s(&t, &o.placedAt) == 0) strftime(placed, sizeof(placed), "%H:%M", &t);
+#else
+        if (o.placedAt > 0 && localtime_r(&o.placedAt, &t)) strftime(placed, sizeof(placed), "%H:%M", &t);
+#endif
+        std::cout << "ID: " << o.orderID << " | Placed: " << placed << " | Items: " << o.items
+            << " | Total: RM" << std::fixed << std::setprecision(2) << o.total << std::endl;
+    }
+
+    bool acceptOrder(int orderID, int deliveryID) {
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "UPDATE orders SET DeliveryID=?, Orders_status='Accepted' WHERE OrdersID=? AND DeliveryID IS NULL"));
+            pstmt->setInt(1, deliveryID);
+            pstmt->setInt(2, orderID);
+            bool claimed = pstmt->executeUpdate() > 0;
+            if (claimed) logEvent(orderID, deliveryID, "Accepted");
+            if (claimed && dispatcher) dispatcher->orderClaimed(orderID, deliveryID);
+            if (claimed && events) {
+                OrderClaimedEvent event = { orderID, deliveryID, time(nullptr) };
+                events->publish(event);
+            }
+            return claimed;
+        }
+        catch (sql::SQLException& e) { return false; }
+    }
+
+    // Claims every order or none: one conditional UPDATE per order in a
+    // single transaction, rolled back if any order was already taken
+    bool acceptOrder(const std::vector<int>& orderIDs, int deliveryID) {
+        if (orderIDs.empty()) return false;
+        try {
+            DeliveryLog::ensureSchema(conn);        // DDL outside the transaction
+            conn->setAutoCommit(false);
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "UPDATE orders SET DeliveryID=?, Orders_status='Accepted' WHERE OrdersID=? AND DeliveryID IS NULL"));
+            for (int orderID : orderIDs) {
+                pstmt->setInt(1, deliveryID);
+                pstmt->setInt(2, orderID);
+                if (pstmt->executeUpdate() == 0) {
+                    conn->rollback();
+                    conn->setAutoCommit(true);
+                    std::cout << "Order " << orderID << " was already taken; no orders were claimed." << std::endl;
+                    return false;
+                }
+                DeliveryLog::record(conn, orderID, deliveryID, "Accepted");
+            }
+            conn->commit();
+            conn->setAutoCommit(true);
+
+            // In stop order, so the dispatcher frees the rider at the last drop-off
+            if (dispatcher) {
+                for (int orderID : orderIDs) dispatcher->orderClaimed(orderID, deliveryID);
+            }
+            if (events) {
+                for (int orderID : orderIDs) {
+                    OrderClaimedEvent event = { orderID, deliveryID, time(nullptr) };
+                    events->publish(event);
+                }
+            }
+            return true;
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Batch accept failed: " << e.what() << std::endl;
+            try {
+                if (!conn->getAutoCommit()) {
+                    conn->rollback();
+                    conn->setAutoCommit(true);
+                }
+            }
+            catch (sql::SQLException&) {}
+            return false;
+        }
+    }
+
+    // Next multi-drop trip: the oldest open order plus up to maxOrders - 1
+    // open orders delivering within radiusMeters of it, in driving order
+    // from the kitchen. Orders whose address cannot be located are left for
+    // single accepts. Empty when nothing can be planned.
+    RoutePlan planTrip(size_t maxOrders = 4, double radiusMeters = 3000.0) {
+        RoutePlan trip = {};
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "SELECT o.OrdersID, c.Customer_Address FROM orders o "
+                "JOIN customer c ON o.CustomerID = c.CustomerID "
+                "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL "
+                "ORDER BY o.OrdersID"));
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            std::vector<RouteStop> open;
+            while (res->next()) {
+                RouteStop stop;
+                stop.orderID = res->getInt("OrdersID");
+                if (geo().locate(res->getString("Customer_Address"), stop.at)) open.push_back(stop);
+            }
+            std::vector<std::vector<RouteStop>> trips = RoutePlanner::group(open, maxOrders, radiusMeters);
+            if (!trips.empty()) trip = RoutePlanner::plan(geocodes.kitchen(), trips[0]);
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Trip planning failed: " << e.what() << std::endl;
+        }
+        return trip;
+    }
+
+    // FUNGSI PENTING: Untuk hilangkan error viewMyDeliveries
+    // Lists the rider's active orders; their IDs go into `orderIDs` if given
+    int viewMyDeliveries(int deliveryID, std::vector<int>* orderIDs = nullptr) {
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "SELECT o.OrdersID, o.Orders_status, c.Customer_Name, c.Customer_Address FROM orders o "
+                "JOIN customer c ON o.CustomerID = c.CustomerID WHERE o.DeliveryID=? AND o.Orders_status != 'Completed'"));
+            pstmt->setInt(1, deliveryID);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+            std::cout << "\n=== My Current Deliveries ===" << std::endl;
+
+            int count = 0;
+            std::vector<RouteStop> stops;
+            while (res->next()) {
+                std::cout << "Order ID: " << res->getInt("OrdersID")
+                    << " | Status: " << res->getString("Orders_status")
+                    << " | Customer: " << res->getString("Customer_Name") << std::endl;
+                RouteStop stop;
+                stop.orderID = res->getInt("OrdersID");
+                if (orderIDs) orderIDs->push_back(stop.orderID);
+                if (geo().locate(res->getString("Customer_Address"), stop.at)) stops.push_back(stop);
+                count++;
+            }
+
+            if (count == 0) {
+                std::cout << "You have no active deliveries at the moment." << std::endl;
+            }
+            else if (stops.size() > 1) {
+                RoutePlan route = RoutePlanner::plan(geocodes.kitchen(), stops);
+                std::cout << "Suggested route from the kitchen:";
+                for (const RouteStop& stop : route.stops) std::cout << " -> #" << stop.orderID;
+                std::cout << " (" << static_cast<int>(route.meters / 100) / 10.0 << " km)" << std::endl;
+            }
+            return count; // Pulangkan jumlah pesanan
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Database error: " << e.what() << std::endl;
+            return 0;
+        }
+    }
+
+    // FUNGSI PENTING: Untuk hilangkan error updateDeliveryStatus
+    // One order, with the same ownership and forward-only checks as a batch
+    bool updateDeliveryStatus(int orderID, int deliveryID, const std::string& status) {
+        return !updateDeliveryStatus(std::vector<int>(1, orderID), deliveryID, status).empty();
+    }
+
+    // Statuses a rider moves their own orders through
+    static bool isRiderStatus(const std::string& status) {
+        return status == "Preparing" || status == "Out for Delivery" || status == "Arrived" || status == "Completed";
+    }
+
+    // Order lifecycle, for FIELD(): an order only ever moves right. A claim
+    // leaves it 'Accepted', before anything a rider can set; a status not in
+    // the list (FIELD() = 0) is treated as terminal
+    static const char* statusOrder() {
+        return "'Pending', 'Confirmed', 'Accepted', 'Preparing', 'Out for Delivery', 'Arrived', 'Completed'";
+    }
+
+    // Moves several of the rider's orders to `status` at once. The orders
+    // that may move (assigned to this rider and still before `status` in the
+    // lifecycle) are locked with one SELECT and updated with one UPDATE;
+    // their delivery_event rows go in as one INSERT, all in one transaction.
+    // Any other ID is reported and left alone. Each moved order is then
+    // published as its own status event. Returns the orders moved.
+    std::vector<int> updateDeliveryStatus(const std::vector<int>& orderIDs, int deliveryID, const std::string& status) {
+        std::vector<int> moved;
+        if (orderIDs.empty()) return moved;
+        if (!isRiderStatus(status)) {
+            std::cout << "Unknown delivery status: " << status << std::endl;
+            return moved;
+        }
+        std::vector<int> wanted(orderIDs);
+        std::sort(wanted.begin(), wanted.end());
+        wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+
+        try {
+            DeliveryLog::ensureSchema(conn);        // DDL outside the transaction
+            conn->setAutoCommit(false);
+
+            std::unique_ptr<sql::PreparedStatement> lock(conn->prepareStatement(
+                std::string("SELECT OrdersID FROM orders WHERE DeliveryID=? ")
+                + "AND FIELD(Orders_status, " + statusOrder() + ") > 0 "
+                + "AND FIELD(Orders_status, " + statusOrder() + ") < FIELD(?, " + statusOrder() + ") "
+                "AND OrdersID IN (" + placeholders(wanted.size()) + ") ORDER BY OrdersID FOR UPDATE"));
+            lock->setInt(1, deliveryID);
+            lock->setString(2, status);
+            for (size_t i = 0; i < wanted.size(); i++) lock->setInt(static_cast<unsigned int>(i + 3), wanted[i]);
+            std::unique_ptr<sql::ResultSet> res(lock->executeQuery());
+            while (res->next()) moved.push_back(res->getInt("OrdersID"));
+
+            if (!moved.empty()) {
+                std::unique_ptr<sql::PreparedStatement> update(conn->prepareStatement(
+                    "UPDATE orders SET Orders_status=? WHERE OrdersID IN (" + placeholders(moved.size()) + ")"));
+                update->setString(1, status);
+                for (size_t i = 0; i < moved.size(); i++) update->setInt(static_cast<unsigned int>(i + 2), moved[i]);
+                update->executeUpdate();
+                DeliveryLog::record(conn, moved, deliveryID, status);
+            }
+            conn->commit();
+            conn->setAutoCommit(true);
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Status update failed: " << e.what() << std::endl;
+            try {
+                if (!conn->getAutoCommit()) {
+                    conn->rollback();
+                    conn->setAutoCommit(true);
+                }
+            }
+            catch (sql::SQLException&) {}
+            return std::vector<int>();
+        }
+
+        for (int orderID : wanted) {
+            if (!std::binary_search(moved.begin(), moved.end(), orderID)) {
+                std::cout << "Order " << orderID << " skipped: not one of your active orders, or already " << status << " or past it." << std::endl;
+            }
+        }
+        if (status == "Completed") {
+            if (dispatcher) {
+                for (int orderID : moved) dispatcher->orderCompleted(orderID);
+            }
+            try {
+                rollup.recordCompletions(moved);
+            }
+            catch (sql::SQLException& e) {
+                std::cerr << "Rider stats not updated: " << e.what() << std::endl;
+            }
+        }
+        if (events) {
+            time_t now = time(nullptr);
+            for (int orderID : moved) {
+                OrderStatusEvent event = { orderID, status, now };
+                events->publish(event);
+            }
+        }
+        return moved;
+    }
+
+    // The batch path releases the rider and updates their stats
+    bool completeDelivery(int orderID, int deliveryID) {
+        return updateDeliveryStatus(orderID, deliveryID, "Completed");
+    }
+
+    // Performance over the last 30 days, from the rider rollups
+    void viewScorecard(int deliveryID) {
+        try {
+            RiderScore s = rollup.score(conn, deliveryID);
+            std::cout << "\n=== My Scorecard (last 30 days) ===" << std::endl;
+            std::cout << "Deliveries:        " << s.deliveries << " (" << s.deliveriesToday << " today)" << std::endl;
+            std::cout << "Per active day:    " << std::fixed << std::setprecision(1) << s.perActiveDay()
+                << " over " << s.activeDays << " days" << std::endl;
+            std::cout << "Pickup to drop:    ";
+            if (s.medianDropMinutes < 0) std::cout << "no timed deliveries yet" << std::endl;
+            else std::cout << "median " << s.medianDropMinutes << " min, average " << s.avgDropMinutes << " min" << std::endl;
+            std::cout << "Earnings:          RM" << std::setprecision(2) << s.earnings
+                << " (RM" << s.earningsToday << " today)" << std::endl;
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Scorecard unavailable: " << e.what() << std::endl;
+        }
+    }
+
+    // FUNGSI PENTING: Untuk hilangkan error viewDeliveryHistory
+    void viewDeliveryHistory(int deliveryID) {
+        try {
+            DeliveryLog::ensureSchema(conn);
+            std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+                "SELECT o.OrdersID, o.OrdersDate, "
+                "MIN(CASE WHEN e.Status = 'Accepted' THEN e.EventTime END) AS acceptedAt, "
+                "MIN(CASE WHEN e.Status = 'Out for Delivery' THEN e.EventTime END) AS outAt, "
+                "MIN(CASE WHEN e.Status = 'Completed' THEN e.EventTime END) AS completedAt "
+                "FROM orders o LEFT JOIN delivery_event e ON e.OrdersID = o.OrdersID "
+                "WHERE o.DeliveryID=? AND o.Orders_status='Completed' "
+                "GROUP BY o.OrdersID, o.OrdersDate ORDER BY o.OrdersID DESC"));
+            pstmt->setInt(1, deliveryID);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            std::cout << "\n=== My History ===" << std::endl;
+            while (res->next()) {
+                std::cout << "Order ID: " << res->getInt("OrdersID") << " | Date: " << res->getString("OrdersDate");
+                if (!res->isNull("acceptedAt")) std::cout << " | Accepted: " << res->getString("acceptedAt");
+                if (!res->isNull("outAt")) std::cout << " | Out: " << res->getString("outAt");
+                if (!res->isNull("completedAt")) std::cout << " | Delivered: " << res->getString("completedAt");
+                std::cout << std::endl;
+            }
+        }
+        catch (sql::SQLException& e) { std::cerr << e.what(); }
+    }
+};
+
 #endif
\ No newline at end of file
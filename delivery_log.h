@@ -0,0 +1,82 @@
+#ifndef DELIVERY_LOG_H
+#define DELIVERY_LOG_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "database.h"
+#include "mysql_connection.h"
+#include <cppconn/datatype.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/statement.h>
+
+// Timestamped delivery milestones (delivery_event), one row per status an
+// order reaches: 'Accepted' when a rider claims it, then whatever the rider
+// sets ('Preparing', 'Out for Delivery', 'Arrived', 'Completed'). Every path
+// that claims or moves an order writes here on its own connection.
+class DeliveryLog {
+private:
+    static std::atomic<bool>& schemaReady() {
+        static std::atomic<bool> ready(false);
+        return ready;
+    }
+
+public:
+    static void ensureSchema(sql::Connection* con) {
+        if (schemaReady().load()) return;
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS delivery_event ("
+            "EventID BIGINT AUTO_INCREMENT PRIMARY KEY, "
+            "OrdersID INT NOT NULL, "
+            "DeliveryID INT NULL, "
+            "Status VARCHAR(30) NOT NULL, "
+            "EventTime DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP, "
+            "INDEX idx_delivery_event_order (OrdersID, EventTime), "
+            "INDEX idx_delivery_event_rider (DeliveryID, EventTime))");
+        schemaReady().store(true);
+    }
+
+    // Rider taken from the order's current assignment
+    static void record(sql::Connection* con, int orderID, const std::string& status) {
+        ensureSchema(con);
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "INSERT INTO delivery_event (OrdersID, DeliveryID, Status) "
+            "SELECT OrdersID, DeliveryID, ? FROM orders WHERE OrdersID = ?"));
+        pstmt->setString(1, status);
+        pstmt->setInt(2, orderID);
+        pstmt->executeUpdate();
+    }
+
+    // riderID 0 when there is no rider
+    static void record(sql::Connection* con, int orderID, int riderID, const std::string& status) {
+        ensureSchema(con);
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "INSERT INTO delivery_event (OrdersID, DeliveryID, Status) VALUES (?, ?, ?)"));
+        pstmt->setInt(1, orderID);
+        if (riderID > 0) pstmt->setInt(2, riderID);
+        else pstmt->setNull(2, sql::DataType::INTEGER);
+        pstmt->setString(3, status);
+        pstmt->executeUpdate();
+    }
+
+    // Same status for several orders of one rider, as one multi-row INSERT
+    static void record(sql::Connection* con, const std::vector<int>& orderIDs, int riderID, const std::string& status) {
+        if (orderIDs.empty()) return;
+        ensureSchema(con);
+        std::string query = "INSERT INTO delivery_event (OrdersID, DeliveryID, Status) VALUES ";
+        for (size_t i = 0; i < orderIDs.size(); i++) query += (i == 0 ? "(" : ", (") + placeholders(3) + ")";
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(query));
+        unsigned int p = 1;
+        for (int orderID : orderIDs) {
+            pstmt->setInt(p++, orderID);
+            if (riderID > 0) pstmt->setInt(p++, riderID);
+            else pstmt->setNull(p++, sql::DataType::INTEGER);
+            pstmt->setString(p++, status);
+        }
+        pstmt->executeUpdate();
+    }
+};
+
+#endif
@@ -0,0 +1,595 @@
+#ifndef DELIVERY_ZONE_H
+#define DELIVERY_ZONE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "geo.h"
+#include "sales_rollup.h"
+
+struct ZoneBox {
+    double minLat, minLng, maxLat, maxLng;
+
+    bool contains(const GeoPoint& p) const {
+        return p.lat >= minLat && p.lat <= maxLat && p.lng >= minLng && p.lng <= maxLng;
+    }
+    void expand(const ZoneBox& b) {
+        minLat = std::min(minLat, b.minLat);
+        minLng = std::min(minLng, b.minLng);
+        maxLat = std::max(maxLat, b.maxLat);
+        maxLng = std::max(maxLng, b.maxLng);
+    }
+};
+
+struct FeeBand {
+    double upToKm;          // straight-line distance from the kitchen
+    double fee;
+};
+
+struct DeliveryZone {
+    int zoneID;
+    std::string name;
+    std::vector<GeoPoint> polygon;
+    std::vector<FeeBand> bands;     // by upToKm
+    ZoneBox box;
+    double area;                    // square degrees; the smaller zone wins an overlap
+};
+
+struct SurgeRule {
+    int zoneID;             // 0 = every zone
+    int startHour;          // inclusive
+    int endHour;            // exclusive, 1-24; below startHour wraps past midnight
+    double multiplier;
+
+    bool covers(int hour) const {
+        return startHour <= endHour ? hour >= startHour && hour < endHour : hour >= startHour || hour < endHour;
+    }
+};
+
+struct FeeQuote {
+    double fee;
+    double km;              // -1 when the address could not be located
+    double surge;           // multiplier applied
+    int zoneID;             // 0 when outside every zone
+    std::string zoneName;
+};
+
+// Ray casting, with longitude as x
+inline bool pointInPolygon(const std::vector<GeoPoint>& polygon, const GeoPoint& p) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const GeoPoint& a = polygon[i];
+        const GeoPoint& b = polygon[j];
+        if ((a.lat > p.lat) != (b.lat > p.lat)
+            && p.lng < (b.lng - a.lng) * (p.lat - a.lat) / (b.lat - a.lat) + a.lng) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+// "lat lng, lat lng, ..." (at least three corners)
+inline bool parsePolygon(const std::string& text, std::vector<GeoPoint>& out) {
+    out.clear();
+    std::stringstream corners(text);
+    std::string corner;
+    while (std::getline(corners, corner, ',')) {
+        std::istringstream in(corner);
+        GeoPoint p;
+        if (!(in >> p.lat >> p.lng)) return false;
+        out.push_back(p);
+    }
+    return out.size() >= 3;
+}
+
+// Static R-tree over zone bounding boxes, bulk-loaded with Sort-Tile-Recursive
+// packing: entries are sorted into vertical slices by longitude, each slice
+// by latitude, and cut into full nodes, level by level up to a single root.
+// Rebuilt from scratch whenever the zones change.
+class ZoneRTree {
+private:
+    struct Node {
+        ZoneBox box;
+        int first;          // into refs
+        int count;
+        bool leaf;          // refs are zone indexes, else node indexes
+    };
+    struct Entry {
+        ZoneBox box;
+        int ref;
+    };
+
+    enum { FANOUT = 8 };
+    std::vector<Node> nodes;
+    std::vector<int> refs;
+    int root = -1;
+
+    static void strSort(std::vector<Entry>& entries) {
+        size_t leaves = (entries.size() + FANOUT - 1) / FANOUT;
+        size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+        size_t perSlice = slices * FANOUT;
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.box.minLng + a.box.maxLng < b.box.minLng + b.box.maxLng;
+        });
+        for (size_t start = 0; start < entries.size(); start += perSlice) {
+            auto end = entries.begin() + std::min(entries.size(), start + perSlice);
+            std::sort(entries.begin() + start, end, [](const Entry& a, const Entry& b) {
+                return a.box.minLat + a.box.maxLat < b.box.minLat + b.box.maxLat;
+            });
+        }
+    }
+
+public:
+    void build(const std::vector<ZoneBox>& boxes) {
+        nodes.clear();
+        refs.clear();
+        root = -1;
+        if (boxes.empty()) return;
+
+        std::vector<Entry> level;
+        for (size_t i = 0; i < boxes.size(); i++) {
+            Entry e = { boxes[i], static_cast<int>(i) };
+            level.push_back(e);
+        }
+        bool leaf = true;
+        while (true) {
+            strSort(level);
+            std::vector<Entry> parents;
+            for (size_t start = 0; start < level.size(); start += FANOUT) {
+                size_t end = std::min(level.size(), start + FANOUT);
+                Node n = { level[start].box, static_cast<int>(refs.size()), static_cast<int>(end - start), leaf };
+                for (size_t i = start; i < end; i++) {
+                    n.box.expand(level[i].box);
+                    refs.push_back(level[i].ref);
+                }
+                nodes.push_back(n);
+                Entry parent = { n.box, static_cast<int>(nodes.size() - 1) };
+                parents.push_back(parent);
+            }
+            if (parents.size() == 1) {
+                root = parents[0].ref;
+                return;
+            }
+            level.swap(parents);
+            leaf = false;
+        }
+    }
+
+    // Calls visit(zoneIndex) for every zone whose box holds p
+    template <typename Visit>
+    void search(const GeoPoint& p, Visit visit) const {
+        if (root < 0) return;
+        int stack[64];
+        int depth = 0;
+        stack[depth++] = root;
+        while (depth > 0) {
+            const Node& n = nodes[stack[--depth]];
+            if (!n.box.contains(p)) continue;
+            for (int i = n.first; i < n.first + n.count; i++) {
+                if (n.leaf) visit(refs[i]);
+                else if (depth < 64) stack[depth++] = refs[i];
+            }
+        }
+    }
+
+    size_t nodeCount() const { return nodes.size(); }
+};
+
+// Delivery fee by zone. Zones (delivery_zone) are polygons with distance
+// bands (delivery_fee_band); surge rules (delivery_surge) multiply the fee
+// during given hours, for one zone or all. Everything a quote needs (zones,
+// their R-tree, surge rules, geocodes) is one immutable snapshot behind an
+// atomically swapped shared_ptr, so checkout reads it without locks. A
+// watcher thread compares a cheap fingerprint of the tables every few
+// seconds and swaps in a rebuilt snapshot when anything changed. Addresses
+// that cannot be located, or fall outside every zone, pay the flat default.
+class DeliveryFeeEngine {
+private:
+    struct Snapshot {
+        std::vector<DeliveryZone> zones;
+        ZoneRTree index;
+        std::vector<SurgeRule> surges;
+        GeocodeTable geocodes;
+    };
+
+    std::shared_ptr<const Snapshot> current;
+    double defaultFee;
+    int pollSeconds;
+    std::string fingerprint;            // of the tables behind `current`
+    std::atomic<long long> reloads;
+    std::mutex reloadLock;              // one rebuild at a time; guards fingerprint
+    bool schemaReady = false;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread watcher;
+
+    std::shared_ptr<const Snapshot> snapshot() const { return std::atomic_load(&current); }
+
+    static int hourOf(time_t when) {
+        struct tm t = {};
+#ifdef _WIN32
+        localtime_s(&t, &when);
+#else
+        localtime_r(&when, &t);
+#endif
+        return t.tm_hour;
+    }
+
+    // Microseconds, so an edit in the same second as the last reload still
+    // changes MAX(UpdatedAt)
+    static constexpr const char* UPDATED_AT =
+        "UpdatedAt TIMESTAMP(6) NOT NULL DEFAULT CURRENT_TIMESTAMP(6) ON UPDATE CURRENT_TIMESTAMP(6)";
+
+    static std::string readFingerprint(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT CONCAT_WS('/', "
+            "(SELECT COUNT(*) FROM delivery_zone), (SELECT IFNULL(MAX(UpdatedAt), '') FROM delivery_zone), "
+            "(SELECT COUNT(*) FROM delivery_fee_band), (SELECT IFNULL(MAX(UpdatedAt), '') FROM delivery_fee_band), "
+            "(SELECT COUNT(*) FROM delivery_surge), (SELECT IFNULL(MAX(UpdatedAt), '') FROM delivery_surge), "
+            "(SELECT COUNT(*) FROM address_geocode), (SELECT IFNULL(MAX(UpdatedAt), '') FROM address_geocode)) AS fp"));
+        return res->next() ? std::string(res->getString("fp")) : std::string();
+    }
+
+    void watchLoop() {
+        sql::Driver* driver = get_driver_instance();
+        driver->threadInit();
+        std::unique_ptr<sql::Connection> con;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait_for(lock, std::chrono::seconds(pollSeconds), [&] { return stopping; });
+                if (stopping) break;
+            }
+            try {
+                if (!con || !con->isValid()) con.reset(openConnection());
+                reload(con.get(), false);
+            }
+            catch (sql::SQLException&) {
+                con.reset();        // the current snapshot stays in use
+            }
+        }
+
+        con.reset();
+        driver->threadEnd();
+    }
+
+    double surgeFor(const Snapshot& s, int zoneID, int hour) const {
+        double multiplier = 1.0;
+        for (const SurgeRule& r : s.surges) {
+            if ((r.zoneID == 0 || r.zoneID == zoneID) && r.covers(hour)) multiplier = std::max(multiplier, r.multiplier);
+        }
+        return multiplier;
+    }
+
+public:
+    DeliveryFeeEngine(double flatFee = 5.00, int reloadPollSeconds = 5)
+        : current(std::make_shared<Snapshot>()), defaultFee(flatFee), pollSeconds(reloadPollSeconds), reloads(0) {}
+
+    ~DeliveryFeeEngine() { stop(); }
+
+    DeliveryFeeEngine(const DeliveryFeeEngine&) = delete;
+    DeliveryFeeEngine& operator=(const DeliveryFeeEngine&) = delete;
+
+    static void ensureSchema(sql::Connection* con) {
+        GeocodeTable::ensureSchema(con);
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS delivery_zone ("
+            "ZoneID INT AUTO_INCREMENT PRIMARY KEY, "
+            "Zone_Name VARCHAR(60) NOT NULL, "
+            "Polygon TEXT NOT NULL, "
+            "Active CHAR(1) NOT NULL DEFAULT 'Y', "
+            + std::string(UPDATED_AT) + ")");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS delivery_fee_band ("
+            "ZoneID INT NOT NULL, UpToKm DECIMAL(6,2) NOT NULL, Fee DECIMAL(8,2) NOT NULL, "
+            + std::string(UPDATED_AT) + ", PRIMARY KEY (ZoneID, UpToKm))");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS delivery_surge ("
+            "SurgeID INT AUTO_INCREMENT PRIMARY KEY, "
+            "ZoneID INT NULL, StartHour TINYINT NOT NULL, EndHour TINYINT NOT NULL, "
+            "Multiplier DECIMAL(4,2) NOT NULL, "
+            + std::string(UPDATED_AT) + ")");
+
+        // Tables from before microsecond stamps (and address_geocode, which
+        // had none) are brought up to date so every edit moves the fingerprint
+        const char* stamped[] = { "delivery_zone", "delivery_fee_band", "delivery_surge", "address_geocode" };
+        for (const char* table : stamped) {
+            std::string type = columnType(con, table, "UpdatedAt");
+            if (type == "timestamp(6)") continue;
+            stmt->execute(std::string("ALTER TABLE ") + table + (type.empty() ? " ADD COLUMN " : " MODIFY COLUMN ")
+                + UPDATED_AT);
+        }
+    }
+
+    // Builds a new snapshot from the tables and swaps it in; unless forced,
+    // only when the tables changed since the last build
+    void reload(sql::Connection* con, bool force = true) {
+        std::lock_guard<std::mutex> lock(reloadLock);
+        if (!schemaReady) {
+            ensureSchema(con);
+            schemaReady = true;
+        }
+        std::string fp = readFingerprint(con);
+        if (!force && fp == fingerprint) return;
+        std::shared_ptr<Snapshot> next = std::make_shared<Snapshot>();
+        next->geocodes.load(con);
+
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT ZoneID, Zone_Name, Polygon FROM delivery_zone WHERE Active = 'Y' ORDER BY ZoneID"));
+        std::map<int, size_t> byID;
+        while (res->next()) {
+            DeliveryZone z;
+            z.zoneID = res->getInt("ZoneID");
+            z.name = res->getString("Zone_Name");
+            if (!parsePolygon(res->getString("Polygon"), z.polygon)) continue;     // malformed rows are skipped
+            z.box = { z.polygon[0].lat, z.polygon[0].lng, z.polygon[0].lat, z.polygon[0].lng };
+            z.area = 0.0;
+            for (size_t i = 0, j = z.polygon.size() - 1; i < z.polygon.size(); j = i++) {
+                ZoneBox corner = { z.polygon[i].lat, z.polygon[i].lng, z.polygon[i].lat, z.polygon[i].lng };
+                z.box.expand(corner);
+                z.area += z.polygon[j].lng * z.polygon[i].lat - z.polygon[i].lng * z.polygon[j].lat;
+            }
+            z.area = std::fabs(z.area) / 2.0;
+            byID[z.zoneID] = next->zones.size();
+            next->zones.push_back(z);
+        }
+
+        std::unique_ptr<sql::ResultSet> bands(stmt->executeQuery(
+            "SELECT ZoneID, UpToKm, Fee FROM delivery_fee_band ORDER BY ZoneID, UpToKm"));
+        while (bands->next()) {
+            auto zone = byID.find(bands->getInt("ZoneID"));
+            if (zone == byID.end()) continue;
+            FeeBand b = { static_cast<double>(bands->getDouble("UpToKm")), static_cast<double>(bands->getDouble("Fee")) };
+            next->zones[zone->second].bands.push_back(b);
+        }
+
+        std::unique_ptr<sql::ResultSet> surges(stmt->executeQuery(
+            "SELECT IFNULL(ZoneID, 0) AS ZoneID, StartHour, EndHour, Multiplier FROM delivery_surge"));
+        while (surges->next()) {
+            SurgeRule r = { surges->getInt("ZoneID"), surges->getInt("StartHour"), surges->getInt("EndHour"),
+                static_cast<double>(surges->getDouble("Multiplier")) };
+            next->surges.push_back(r);
+        }
+
+        std::vector<ZoneBox> boxes;
+        for (const DeliveryZone& z : next->zones) boxes.push_back(z.box);
+        next->index.build(boxes);
+
+        std::atomic_store(&current, std::shared_ptr<const Snapshot>(next));
+        fingerprint = fp;
+        reloads++;
+    }
+
+    // Watches the zone tables on its own connection; call after reload()
+    void start() {
+        if (!watcher.joinable()) watcher = std::thread(&DeliveryFeeEngine::watchLoop, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        if (watcher.joinable()) watcher.join();
+    }
+
+    FeeQuote quote(const GeoPoint& at, time_t now = 0) const {
+        if (now == 0) now = time(nullptr);
+        std::shared_ptr<const Snapshot> s = snapshot();
+
+        const DeliveryZone* zone = nullptr;
+        s->index.search(at, [&](int i) {
+            const DeliveryZone& z = s->zones[i];
+            if ((!zone || z.area < zone->area) && pointInPolygon(z.polygon, at)) zone = &z;
+        });
+
+        FeeQuote q = { defaultFee, distanceMeters(s->geocodes.kitchen(), at) / 1000.0, 1.0, 0, "" };
+        if (!zone) return q;
+        q.zoneID = zone->zoneID;
+        q.zoneName = zone->name;
+        if (!zone->bands.empty()) {
+            q.fee = zone->bands.back().fee;             // beyond the last band
+            for (const FeeBand& b : zone->bands) {
+                if (q.km <= b.upToKm) {
+                    q.fee = b.fee;
+                    break;
+                }
+            }
+        }
+        q.surge = surgeFor(*s, zone->zoneID, hourOf(now));
+        q.fee = std::round(q.fee * q.surge * 100.0) / 100.0;
+        return q;
+    }
+
+    FeeQuote quote(const std::string& address, time_t now = 0) const {
+        GeoPoint at;
+        if (!snapshot()->geocodes.locate(address, at)) {
+            FeeQuote flat = { defaultFee, -1.0, 1.0, 0, "" };
+            return flat;
+        }
+        return quote(at, now);
+    }
+
+    std::vector<DeliveryZone> zones() const { return snapshot()->zones; }
+    std::vector<SurgeRule> surgeRules() const { return snapshot()->surges; }
+    long long reloadCount() const { return reloads.load(); }
+    double flatFee() const { return defaultFee; }
+
+    // Returns the new ZoneID; bands are (upToKm, fee) pairs. The zone is in
+    // the snapshot on return, not at the watcher's next poll.
+    int addZone(sql::Connection* con, const std::string& name, const std::string& polygon,
+        const std::vector<FeeBand>& bands) {
+        ensureSchema(con);
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "INSERT INTO delivery_zone (Zone_Name, Polygon) VALUES (?, ?)"));
+        pstmt->setString(1, name);
+        pstmt->setString(2, polygon);
+        pstmt->executeUpdate();
+
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT LAST_INSERT_ID() AS id"));
+        int zoneID = res->next() ? res->getInt("id") : 0;
+
+        std::unique_ptr<sql::PreparedStatement> band(con->prepareStatement(
+            "INSERT INTO delivery_fee_band (ZoneID, UpToKm, Fee) VALUES (?, ?, ?) "
+            "ON DUPLICATE KEY UPDATE Fee = VALUES(Fee)"));
+        for (const FeeBand& b : bands) {
+            band->setInt(1, zoneID);
+            band->setDouble(2, b.upToKm);
+            band->setDouble(3, b.fee);
+            band->executeUpdate();
+        }
+        reload(con);
+        return zoneID;
+    }
+
+    // Replaces the all-zone surge rules with `multiplier` during every hour
+    // whose order count (sales_rollup_hour, as in the peak hours chart) is
+    // at least `share` of the busiest hour, and reloads the snapshot. Returns
+    // the rules written.
+    std::vector<SurgeRule> setPeakSurge(sql::Connection* con, double multiplier, double share = 0.75) {
+        ensureSchema(con);
+        SalesRollup(con).ensureSchema();
+        int orders[24] = {};
+        int busiest = 0;
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT SalesHour, Orders FROM sales_rollup_hour"));
+        while (res->next()) {
+            int hour = res->getInt("SalesHour");
+            if (hour < 0 || hour > 23) continue;
+            orders[hour] = res->getInt("Orders");
+            busiest = std::max(busiest, orders[hour]);
+        }
+
+        std::vector<SurgeRule> rules;
+        for (int h = 0; h < 24 && busiest > 0; h++) {
+            if (orders[h] < share * busiest) continue;
+            if (!rules.empty() && rules.back().endHour == h) rules.back().endHour = h + 1;
+            else rules.push_back(SurgeRule{ 0, h, h + 1, multiplier });
+        }
+
+        stmt->execute("DELETE FROM delivery_surge WHERE ZoneID IS NULL");
+        std::unique_ptr<sql::PreparedStatement> insert(con->prepareStatement(
+            "INSERT INTO delivery_surge (ZoneID, StartHour, EndHour, Multiplier) VALUES (NULL, ?, ?, ?)"));
+        for (const SurgeRule& r : rules) {
+            insert->setInt(1, r.startHour);
+            insert->setInt(2, r.endHour);           // 24, not 0: 0-24 is all day, 0-0 would be never
+            insert->setDouble(3, r.multiplier);
+            insert->executeUpdate();
+        }
+        reload(con);
+        return rules;
+    }
+};
+
+struct ZoneBenchmark {
+    int zones;
+    int lookups;
+    size_t treeNodes;
+    double buildMs;
+    double treeUs;          // per lookup
+    double scanUs;          // per lookup, testing every zone
+    int mismatches;         // tree and scan disagreeing (should be 0)
+};
+
+// Lookup speed on a synthetic city: `zones` jittered, slightly overlapping
+// hexagons tiling a square around the kitchen, point-in-polygon through the
+// R-tree versus a scan of every zone (both pick the lowest-numbered match)
+inline ZoneBenchmark benchmarkZoneLookup(int zones = 2000, int lookups = 200000, uint64_t seed = 11) {
+    uint64_t state = seed;
+    auto uniform = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(zones))));
+    double cell = 0.3 / side;                           // ~33 km square
+    std::vector<std::vector<GeoPoint>> polygons;
+    std::vector<ZoneBox> boxes;
+    for (int i = 0; i < zones; i++) {
+        double cLat = KITCHEN_LAT - 0.15 + (i / side + 0.5) * cell;
+        double cLng = KITCHEN_LNG - 0.15 + (i % side + 0.5) * cell;
+        std::vector<GeoPoint> poly;
+        ZoneBox box = { cLat, cLng, cLat, cLng };
+        for (int k = 0; k < 6; k++) {
+            double angle = k * 3.14159265358979 / 3.0;
+            double r = cell * (0.45 + 0.1 * uniform());
+            GeoPoint p = { cLat + r * std::sin(angle), cLng + r * std::cos(angle) };
+            poly.push_back(p);
+            ZoneBox corner = { p.lat, p.lng, p.lat, p.lng };
+            box.expand(corner);
+        }
+        polygons.push_back(poly);
+        boxes.push_back(box);
+    }
+
+    ZoneBenchmark result = {};
+    result.zones = zones;
+    result.lookups = lookups;
+
+    auto start = std::chrono::steady_clock::now();
+    ZoneRTree tree;
+    tree.build(boxes);
+    result.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.treeNodes = tree.nodeCount();
+
+    std::vector<GeoPoint> points;
+    for (int i = 0; i < lookups; i++) {
+        GeoPoint p = { KITCHEN_LAT - 0.15 + uniform() * 0.3, KITCHEN_LNG - 0.15 + uniform() * 0.3 };
+        points.push_back(p);
+    }
+
+    std::vector<int> byTree(lookups, -1), byScan(lookups, -1);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++) {
+        int& found = byTree[i];
+        tree.search(points[i], [&](int z) {
+            if ((found < 0 || z < found) && pointInPolygon(polygons[z], points[i])) found = z;
+        });
+    }
+    result.treeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / lookups;
+
+    int scanned = std::min(lookups, 20000);         // the scan is slow; time a sample
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scanned; i++) {
+        for (int z = 0; z < zones; z++) {
+            if (boxes[z].contains(points[i]) && pointInPolygon(polygons[z], points[i])) {
+                byScan[i] = z;
+                break;
+            }
+        }
+    }
+    result.scanUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / scanned;
+    for (int i = 0; i < scanned; i++) {
+        if (byTree[i] != byScan[i]) result.mismatches++;
+    }
+    return result;
+}
+
+#endif
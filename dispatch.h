@@ -0,0 +1,712 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "geo.h"
+#include "order_events.h"
+#include "delivery_log.h"
+
+// Uniform grid over points with integer IDs (a flat geohash): each point
+// lives in one cellMeters x cellMeters cell and nearest() searches rings of
+// cells outwards until no closer point can remain.
+class PointGrid {
+private:
+    double cellMeters;
+    double refLat;
+    std::unordered_map<int64_t, std::vector<int>> cells;
+    std::unordered_map<int, std::pair<GeoPoint, int64_t>> where;
+
+    void cellOf(const GeoPoint& p, int32_t& cx, int32_t& cy) const {
+        const double metersPerDegree = 111320.0;
+        cx = static_cast<int32_t>(std::floor(p.lng * metersPerDegree * std::cos(refLat * 3.14159265358979 / 180.0) / cellMeters));
+        cy = static_cast<int32_t>(std::floor(p.lat * metersPerDegree / cellMeters));
+    }
+
+    static int64_t keyOf(int32_t cx, int32_t cy) {
+        return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+    }
+
+public:
+    PointGrid(double cellSizeMeters = 500.0, double referenceLat = KITCHEN_LAT)
+        : cellMeters(cellSizeMeters), refLat(referenceLat) {}
+
+    void insert(int id, const GeoPoint& p) {
+        remove(id);
+        int32_t cx, cy;
+        cellOf(p, cx, cy);
+        int64_t key = keyOf(cx, cy);
+        cells[key].push_back(id);
+        where[id] = std::make_pair(p, key);
+    }
+
+    void remove(int id) {
+        auto it = where.find(id);
+        if (it == where.end()) return;
+        std::vector<int>& cell = cells[it->second.second];
+        cell.erase(std::find(cell.begin(), cell.end(), id));
+        if (cell.empty()) cells.erase(it->second.second);
+        where.erase(it);
+    }
+
+    bool contains(int id) const { return where.count(id) > 0; }
+    size_t size() const { return where.size(); }
+
+    bool position(int id, GeoPoint& out) const {
+        auto it = where.find(id);
+        if (it == where.end()) return false;
+        out = it->second.first;
+        return true;
+    }
+
+    // Up to k (distance, id) pairs within maxMeters of p, nearest first
+    std::vector<std::pair<double, int>> nearest(const GeoPoint& p, size_t k, double maxMeters) const {
+        std::vector<std::pair<double, int>> found;
+        if (k == 0 || where.empty()) return found;
+        int32_t cx, cy;
+        cellOf(p, cx, cy);
+        int maxRing = static_cast<int>(maxMeters / cellMeters) + 1;
+
+        auto scan = [&](int32_t x, int32_t y) {
+            auto it = cells.find(keyOf(x, y));
+            if (it == cells.end()) return;
+            for (int id : it->second) {
+                double d = distanceMeters(p, where.at(id).first);
+                if (d <= maxMeters) found.push_back(std::make_pair(d, id));
+            }
+        };
+
+        for (int ring = 0; ring <= maxRing; ring++) {
+            // Perimeter of the (2 ring + 1)^2 square around the centre cell
+            if (ring == 0) scan(cx, cy);
+            for (int d = -ring; d <= ring && ring > 0; d++) {
+                scan(cx + d, cy - ring);
+                scan(cx + d, cy + ring);
+                if (d != -ring && d != ring) {
+                    scan(cx - ring, cy + d);
+                    scan(cx + ring, cy + d);
+                }
+            }
+            // Anything in ring + 1 is at least ring * cellMeters away
+            if (found.size() >= k) {
+                std::nth_element(found.begin(), found.begin() + (k - 1), found.end());
+                if (found[k - 1].first <= ring * cellMeters) break;
+            }
+            if (found.size() == where.size()) break;
+        }
+        std::sort(found.begin(), found.end());
+        if (found.size() > k) found.resize(k);
+        return found;
+    }
+};
+
+struct DispatchOrder {
+    int orderID;
+    GeoPoint pickup;
+    GeoPoint dropoff;
+    time_t placedAt;
+};
+
+struct DispatchAssignment {
+    int orderID;
+    int riderID;
+    double meters;          // rider to pickup
+};
+
+// Assigns orders to free riders minimising total rider-to-pickup distance.
+// Candidates come from the grid: orders sharing a pickup cell query it once
+// for (orders + spare) riders, so a single busy kitchen still sees enough
+// riders. The assignment itself is a forward auction (Bertsekas) over those
+// candidate edges: riders raise the price of their best pickup by the margin
+// over their second best and drop out once nothing beats staying free. The
+// result is within (matches x epsilon) metres of the optimum on those edges.
+class DispatchMatcher {
+public:
+    enum { SPARE_CANDIDATES = 8 };
+
+    static std::vector<DispatchAssignment> match(const std::vector<DispatchOrder>& orders, const PointGrid& freeRiders,
+        double maxMeters, bool greedy = false, double epsilonMeters = 1.0) {
+        std::vector<std::vector<std::pair<double, int>>> candidates(orders.size());
+        std::unordered_map<int64_t, std::vector<size_t>> byPickup;
+        for (size_t i = 0; i < orders.size(); i++) {
+            int64_t key = (static_cast<int64_t>(std::floor(orders[i].pickup.lat * 2000)) << 32)
+                | static_cast<uint32_t>(static_cast<int32_t>(std::floor(orders[i].pickup.lng * 2000)));
+            byPickup[key].push_back(i);
+        }
+        for (const auto& group : byPickup) {
+            const GeoPoint& at = orders[group.second[0]].pickup;
+            std::vector<std::pair<double, int>> near = freeRiders.nearest(at, group.second.size() + SPARE_CANDIDATES, maxMeters);
+            for (size_t i : group.second) {
+                for (const auto& c : near) {
+                    GeoPoint rider = {};
+                    freeRiders.position(c.second, rider);
+                    candidates[i].push_back(std::make_pair(distanceMeters(orders[i].pickup, rider), c.second));
+                }
+            }
+        }
+        return greedy ? greedyMatch(orders, candidates) : auctionMatch(orders, candidates, maxMeters, epsilonMeters);
+    }
+
+private:
+    static std::vector<DispatchAssignment> greedyMatch(const std::vector<DispatchOrder>& orders,
+        const std::vector<std::vector<std::pair<double, int>>>& candidates) {
+        std::vector<std::pair<double, std::pair<size_t, int>>> edges;
+        for (size_t i = 0; i < candidates.size(); i++) {
+            for (const auto& c : candidates[i]) edges.push_back(std::make_pair(c.first, std::make_pair(i, c.second)));
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<char> orderTaken(orders.size(), 0);
+        std::unordered_map<int, char> riderTaken;
+        std::vector<DispatchAssignment> result;
+        for (const auto& e : edges) {
+            size_t i = e.second.first;
+            int rider = e.second.second;
+            if (orderTaken[i] || riderTaken[rider]) continue;
+            orderTaken[i] = riderTaken[rider] = 1;
+            DispatchAssignment a = { orders[i].orderID, rider, e.first };
+            result.push_back(a);
+        }
+        return result;
+    }
+
+    // Orders with the same pickup are interchangeable (the cost is the
+    // rider's distance to the pickup), so each pickup is one object with as
+    // many slots as it has orders and riders bid for slots. A full pickup is
+    // priced at its lowest held bid; outbidding it evicts that rider, who bids
+    // again. Bidding per pickup instead of per order avoids the epsilon-sized
+    // price wars between identical orders.
+    static std::vector<DispatchAssignment> auctionMatch(const std::vector<DispatchOrder>& orders,
+        const std::vector<std::vector<std::pair<double, int>>>& candidates, double maxMeters, double epsilon) {
+        typedef std::pair<double, int> Bid;                 // (price, rider slot)
+        struct Pickup {
+            std::vector<size_t> orders;
+            std::priority_queue<Bid, std::vector<Bid>, std::greater<Bid>> held;
+        };
+
+        std::vector<Pickup> pickups;
+        std::map<std::pair<double, double>, size_t> pickupOf;
+        std::unordered_map<int, int> riderSlot;
+        std::vector<int> riderIDs;
+        std::vector<std::vector<std::pair<double, int>>> riderEdges;
+        for (size_t i = 0; i < orders.size(); i++) {
+            auto key = std::make_pair(orders[i].pickup.lat, orders[i].pickup.lng);
+            auto found = pickupOf.find(key);
+            bool first = found == pickupOf.end();
+            if (first) {
+                found = pickupOf.insert(std::make_pair(key, pickups.size())).first;
+                pickups.push_back(Pickup());
+            }
+            size_t c = found->second;
+            pickups[c].orders.push_back(i);
+            if (!first) continue;               // same pickup, same candidate riders
+
+            for (const auto& cand : candidates[i]) {
+                auto it = riderSlot.find(cand.second);
+                if (it == riderSlot.end()) {
+                    it = riderSlot.insert(std::make_pair(cand.second, static_cast<int>(riderIDs.size()))).first;
+                    riderIDs.push_back(cand.second);
+                    riderEdges.push_back(std::vector<std::pair<double, int>>());
+                }
+                riderEdges[it->second].push_back(std::make_pair(cand.first, static_cast<int>(c)));
+            }
+        }
+
+        auto priceOf = [&pickups](size_t c) {
+            const Pickup& p = pickups[c];
+            return p.held.size() < p.orders.size() ? 0.0 : p.held.top().first;
+        };
+
+        const double base = maxMeters + 1.0;
+        std::deque<int> queue;
+        for (size_t r = 0; r < riderIDs.size(); r++) queue.push_back(static_cast<int>(r));
+        while (!queue.empty()) {
+            int r = queue.front();
+            queue.pop_front();
+
+            double best = 0.0, second = 0.0;
+            int bestPickup = -1;
+            for (const auto& e : riderEdges[r]) {
+                double value = base - e.first - priceOf(e.second);
+                if (value > best) {
+                    second = best;
+                    best = value;
+                    bestPickup = e.second;
+                }
+                else if (value > second) {
+                    second = value;
+                }
+            }
+            if (bestPickup < 0) continue;       // priced out: stays free
+
+            Pickup& p = pickups[bestPickup];
+            p.held.push(Bid(priceOf(bestPickup) + best - second + epsilon, r));
+            if (p.held.size() > p.orders.size()) {
+                queue.push_back(p.held.top().second);
+                p.held.pop();
+            }
+        }
+
+        // Within a pickup any rider-to-order split costs the same: the
+        // nearest winner takes the oldest order
+        std::vector<DispatchAssignment> result;
+        for (size_t c = 0; c < pickups.size(); c++) {
+            std::vector<std::pair<double, int>> winners;
+            for (Pickup& p = pickups[c]; !p.held.empty(); p.held.pop()) {
+                int r = p.held.top().second;
+                for (const auto& e : riderEdges[r]) {
+                    if (e.second == static_cast<int>(c)) winners.push_back(std::make_pair(e.first, riderIDs[r]));
+                }
+            }
+            std::sort(winners.begin(), winners.end());
+            for (size_t k = 0; k < winners.size(); k++) {
+                DispatchAssignment a = { orders[pickups[c].orders[k]].orderID, winners[k].second, winners[k].first };
+                result.push_back(a);
+            }
+        }
+        return result;
+    }
+};
+
+struct DispatchStats {
+    long long batches;
+    long long assigned;
+    long long lostClaims;           // conditional update found the order already taken
+    double lastBatchMs;
+    size_t pendingOrders;
+    size_t freeRiders;
+    size_t busyRiders;
+    size_t heldForKitchen;          // pending orders whose food is not ready soon enough, last batch
+};
+
+// Background dispatcher: every few seconds it picks up new open orders,
+// matches the oldest ones against the riders who are online and free, and
+// claims each match with the same conditional UPDATE riders use, on its own
+// connection. Riders go online with a location, are taken off the grid while
+// delivering, and come back at their last drop-off when they complete it.
+class DispatchEngine {
+private:
+    int intervalSeconds;
+    double maxMeters;
+    GeocodeTable geocodes;
+    PointGrid freeRiders;
+    std::map<int, DispatchOrder> pending;               // by OrdersID, oldest first
+    std::unordered_map<int, int> riderOrder;            // busy rider -> order being delivered
+    std::unordered_map<int, GeoPoint> dropoffs;         // order -> drop-off, while delivering
+    std::vector<std::pair<int, GeoPoint>> riderUpdates; // queued from the UI thread
+    int lastOrderID = 0;
+    int ticks = 0;
+    DispatchStats stats = {};
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopping = false;
+    bool geocodesLoaded = false;
+    std::thread worker;
+    OrderEvents* events = nullptr;
+    std::function<time_t(int)> readyAt;                 // kitchen's expected ready time, 0 if unknown
+    int readyLeadSeconds = 0;
+
+    enum { FULL_RESCAN_TICKS = 12 };
+
+    void loadOrders(sql::Connection* con) {
+        bool full = ticks++ % FULL_RESCAN_TICKS == 0;
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT o.OrdersID, UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, c.Customer_Address FROM orders o "
+            "JOIN customer c ON o.CustomerID = c.CustomerID "
+            "WHERE o.OrdersID > ? AND o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL "
+            "ORDER BY o.OrdersID"));
+        // A periodic full rescan catches orders committed out of ID order and
+        // drops ones claimed or cancelled elsewhere
+        pstmt->setInt(1, full ? 0 : lastOrderID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+        std::vector<std::pair<DispatchOrder, std::string>> rows;
+        while (res->next()) {
+            DispatchOrder o;
+            o.orderID = res->getInt("OrdersID");
+            o.placedAt = static_cast<time_t>(res->getInt64("placedAt"));
+            rows.push_back(std::make_pair(o, std::string(res->getString("Customer_Address"))));
+            if (o.orderID > lastOrderID) lastOrderID = o.orderID;
+        }
+
+        // geocodes is shared with riderOnline(), so it is read under m
+        std::lock_guard<std::mutex> lock(m);
+        std::map<int, DispatchOrder> found;
+        for (auto& row : rows) {
+            DispatchOrder& o = row.first;
+            o.pickup = geocodes.kitchen();
+            if (!geocodes.locate(row.second, o.dropoff)) o.dropoff = o.pickup;
+            found[o.orderID] = o;
+        }
+        if (full) pending.swap(found);
+        else pending.insert(found.begin(), found.end());
+    }
+
+    // A database error part-way through the claims still publishes the claims
+    // that went through and returns the other riders to the grid, then
+    // rethrows so the worker reconnects
+    void runBatch(sql::Connection* con) {
+        std::vector<DispatchAssignment> matches;
+        std::vector<GeoPoint> riderAt;          // where each matched rider was
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m);
+            for (const auto& update : riderUpdates) freeRiders.insert(update.first, update.second);
+            riderUpdates.clear();
+            stats.heldForKitchen = 0;
+            if (pending.empty() || freeRiders.size() == 0) return;
+
+            // Only as many of the oldest orders as the free riders could take,
+            // skipping food that will not be ready by the time a rider gets there
+            std::vector<DispatchOrder> batch;
+            size_t limit = freeRiders.size() + freeRiders.size() / 2 + 1;
+            time_t readyBy = time(nullptr) + readyLeadSeconds;
+            for (auto it = pending.begin(); it != pending.end() && batch.size() < limit; ++it) {
+                if (readyAt && readyAt(it->first) > readyBy) {
+                    stats.heldForKitchen++;
+                    continue;
+                }
+                batch.push_back(it->second);
+            }
+            if (batch.empty()) return;
+            matches = DispatchMatcher::match(batch, freeRiders, maxMeters);
+            for (const DispatchAssignment& a : matches) {
+                GeoPoint at = geocodes.kitchen();
+                freeRiders.position(a.riderID, at);
+                riderAt.push_back(at);
+                freeRiders.remove(a.riderID);
+            }
+        }
+
+        std::vector<char> won(matches.size(), 0);
+        size_t attempted = 0;
+        std::unique_ptr<sql::SQLException> failure;
+        try {
+            std::unique_ptr<sql::PreparedStatement> claim(con->prepareStatement(
+                "UPDATE orders SET DeliveryID=?, Orders_status='Accepted' WHERE OrdersID=? AND DeliveryID IS NULL"));
+            for (; attempted < matches.size(); attempted++) {
+                size_t i = attempted;
+                claim->setInt(1, matches[i].riderID);
+                claim->setInt(2, matches[i].orderID);
+                won[i] = claim->executeUpdate() > 0;
+                if (!won[i]) continue;
+                try {
+                    DeliveryLog::record(con, matches[i].orderID, matches[i].riderID, "Accepted");
+                }
+                catch (sql::SQLException&) {}       // the claim stands without its timestamp
+            }
+        }
+        catch (sql::SQLException& e) {
+            failure.reset(new sql::SQLException(e));
+        }
+
+        if (events) {
+            for (size_t i = 0; i < matches.size(); i++) {
+                if (!won[i]) continue;
+                OrderClaimedEvent claimed = { matches[i].orderID, matches[i].riderID, time(nullptr) };
+                events->publish(claimed);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m);
+        for (size_t i = 0; i < matches.size(); i++) {
+            const DispatchAssignment& a = matches[i];
+            if (i >= attempted) {
+                // Never claimed: the rider goes back where they were, the order stays pending
+                freeRiders.insert(a.riderID, riderAt[i]);
+                continue;
+            }
+            auto order = pending.find(a.orderID);
+            if (won[i]) {
+                if (order != pending.end()) dropoffs[a.orderID] = order->second.dropoff;
+                riderOrder[a.riderID] = a.orderID;
+                stats.assigned++;
+            }
+            else {
+                GeoPoint back = order != pending.end() ? order->second.pickup : geocodes.kitchen();
+                freeRiders.insert(a.riderID, back);
+                stats.lostClaims++;
+            }
+            if (order != pending.end()) pending.erase(order);
+        }
+        stats.batches++;
+        stats.lastBatchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (failure) throw *failure;
+    }
+
+    // Caller holds m
+    bool dropQueuedUpdate(int riderID) {
+        size_t before = riderUpdates.size();
+        riderUpdates.erase(std::remove_if(riderUpdates.begin(), riderUpdates.end(),
+            [riderID](const std::pair<int, GeoPoint>& u) { return u.first == riderID; }), riderUpdates.end());
+        return riderUpdates.size() != before;
+    }
+
+    void workerLoop() {
+        sql::Driver* driver = get_driver_instance();
+        driver->threadInit();
+        std::unique_ptr<sql::Connection> con;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait_for(lock, std::chrono::seconds(intervalSeconds), [&] { return stopping; });
+                if (stopping) break;
+                if (freeRiders.size() == 0 && riderUpdates.empty()) continue;   // nobody to dispatch to
+            }
+            try {
+                if (!con || !con->isValid()) con.reset(openConnection());
+                bool haveGeocodes;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    haveGeocodes = geocodesLoaded;
+                }
+                if (!haveGeocodes) {
+                    GeocodeTable loaded;
+                    loaded.load(con.get());
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!geocodesLoaded) {
+                        geocodes = loaded;
+                        geocodesLoaded = true;
+                    }
+                }
+                loadOrders(con.get());
+                runBatch(con.get());
+            }
+            catch (sql::SQLException&) {
+                con.reset();        // retried on the next tick
+            }
+        }
+
+        con.reset();
+        driver->threadEnd();
+    }
+
+public:
+    DispatchEngine(int batchSeconds = 3, double maxPickupMeters = 15000.0)
+        : intervalSeconds(batchSeconds), maxMeters(maxPickupMeters) {}
+
+    ~DispatchEngine() { stop(); }
+
+    DispatchEngine(const DispatchEngine&) = delete;
+    DispatchEngine& operator=(const DispatchEngine&) = delete;
+
+    // Claims the worker makes are published here; set before start()
+    void setEventBus(OrderEvents* bus) { events = bus; }
+
+    // Orders are only matched once readyAt(orderID) is within leadSeconds
+    // (a rider's trip to the kitchen); set before start()
+    void setReadyGate(std::function<time_t(int)> estimator, int leadSeconds) {
+        readyAt = estimator;
+        readyLeadSeconds = leadSeconds;
+    }
+
+    void start() {
+        if (!worker.joinable()) worker = std::thread(&DispatchEngine::workerLoop, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    // Rider is available at `address` (geocoded, else the kitchen). Returns
+    // false when the address was not found and the kitchen was used.
+    bool riderOnline(sql::Connection* con, int riderID, const std::string& address) {
+        std::lock_guard<std::mutex> lock(m);
+        if (!geocodesLoaded) {
+            geocodes.load(con);
+            geocodesLoaded = true;
+        }
+        GeoPoint at;
+        bool known = geocodes.locate(address, at);
+        if (!known) at = geocodes.kitchen();
+        if (!riderOrder.count(riderID)) riderUpdates.push_back(std::make_pair(riderID, at));
+        cv.notify_all();
+        return known;
+    }
+
+    // Also forgets a delivery in progress, so the rider is not put back on
+    // the grid when it completes
+    void riderOffline(int riderID) {
+        std::lock_guard<std::mutex> lock(m);
+        freeRiders.remove(riderID);
+        dropQueuedUpdate(riderID);
+        auto busy = riderOrder.find(riderID);
+        if (busy != riderOrder.end()) {
+            dropoffs.erase(busy->second);
+            riderOrder.erase(busy);
+        }
+    }
+
+    bool isOnline(int riderID) {
+        std::lock_guard<std::mutex> lock(m);
+        if (freeRiders.contains(riderID) || riderOrder.count(riderID)) return true;
+        for (const auto& u : riderUpdates) {
+            if (u.first == riderID) return true;
+        }
+        return false;
+    }
+
+    // A rider claimed this order by hand (Delivery::acceptOrder)
+    void orderClaimed(int orderID, int riderID) {
+        std::lock_guard<std::mutex> lock(m);
+        auto order = pending.find(orderID);
+        if (order != pending.end()) {
+            dropoffs[orderID] = order->second.dropoff;
+            pending.erase(order);
+        }
+        bool queued = dropQueuedUpdate(riderID);
+        // A rider already delivering keeps going; they free up after the latest claim
+        if (freeRiders.contains(riderID) || queued || riderOrder.count(riderID)) {
+            freeRiders.remove(riderID);
+            riderOrder[riderID] = orderID;
+        }
+    }
+
+    // Delivery finished: an online rider becomes free at the drop-off
+    void orderCompleted(int orderID) {
+        std::lock_guard<std::mutex> lock(m);
+        auto drop = dropoffs.find(orderID);
+        GeoPoint at = drop != dropoffs.end() ? drop->second : geocodes.kitchen();
+        if (drop != dropoffs.end()) dropoffs.erase(drop);
+        for (auto it = riderOrder.begin(); it != riderOrder.end(); ++it) {
+            if (it->second != orderID) continue;
+            riderUpdates.push_back(std::make_pair(it->first, at));
+            riderOrder.erase(it);
+            break;
+        }
+    }
+
+    DispatchStats snapshot() {
+        std::lock_guard<std::mutex> lock(m);
+        DispatchStats s = stats;
+        s.pendingOrders = pending.size();
+        s.freeRiders = freeRiders.size() + riderUpdates.size();
+        s.busyRiders = riderOrder.size();
+        return s;
+    }
+
+    int batchSeconds() const { return intervalSeconds; }
+};
+
+struct DispatchSimulation {
+    int batches;
+    double totalMs;
+    double p50BatchMs;
+    double p99BatchMs;
+    double maxBatchMs;
+    double meanWaitBatches;         // batches an order waited before assignment
+    double auctionKm;               // total rider-to-pickup distance
+    double greedyKm;                // same batches matched greedily
+    long long assigned;
+    long long greedyAssigned;       // matches greedy found in those batches
+};
+
+// Synthetic city: riders and drop-offs spread over a square, pickups at a
+// number of kitchens; all orders arrive up front and each batch assigns the
+// free riders, who reappear at their drop-off for the next batch.
+inline DispatchSimulation simulateDispatch(int orderCount = 10000, int riderCount = 1000,
+    int kitchens = 40, double citySizeKm = 20.0, uint64_t seed = 7) {
+    uint64_t state = seed | 1;
+    auto uniform = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    const double degrees = citySizeKm * 1000.0 / 111320.0;
+    const double maxMeters = citySizeKm * 1500.0;       // beyond the city diagonal
+    auto randomPoint = [&]() {
+        GeoPoint p = { KITCHEN_LAT - degrees / 2 + uniform() * degrees, KITCHEN_LNG - degrees / 2 + uniform() * degrees };
+        return p;
+    };
+
+    std::vector<GeoPoint> kitchenPoints;
+    for (int k = 0; k < kitchens; k++) kitchenPoints.push_back(randomPoint());
+
+    std::deque<DispatchOrder> queue;
+    for (int i = 0; i < orderCount; i++) {
+        DispatchOrder o = { i + 1, kitchenPoints[static_cast<size_t>(uniform() * kitchens) % kitchens], randomPoint(), 0 };
+        queue.push_back(o);
+    }
+    PointGrid riders;
+    for (int r = 0; r < riderCount; r++) riders.insert(r + 1, randomPoint());
+
+    DispatchSimulation sim = {};
+    std::vector<double> batchMs;
+    double waitSum = 0.0;
+    while (!queue.empty() && sim.batches < orderCount) {
+        std::vector<DispatchOrder> batch;
+        size_t limit = riders.size() + riders.size() / 2 + 1;
+        for (size_t i = 0; i < queue.size() && batch.size() < limit; i++) batch.push_back(queue[i]);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<DispatchAssignment> matches = DispatchMatcher::match(batch, riders, maxMeters);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        batchMs.push_back(ms);
+        sim.totalMs += ms;
+
+        for (const DispatchAssignment& a : DispatchMatcher::match(batch, riders, maxMeters, true)) {
+            sim.greedyKm += a.meters / 1000.0;
+            sim.greedyAssigned++;
+        }
+        if (matches.empty()) break;
+
+        std::unordered_map<int, int> riderOf;
+        for (const DispatchAssignment& a : matches) {
+            riderOf[a.orderID] = a.riderID;
+            sim.auctionKm += a.meters / 1000.0;
+        }
+        std::deque<DispatchOrder> remaining;
+        for (const DispatchOrder& o : queue) {
+            auto it = riderOf.find(o.orderID);
+            if (it == riderOf.end()) {
+                remaining.push_back(o);
+                continue;
+            }
+            riders.insert(it->second, o.dropoff);
+            waitSum += sim.batches;
+            sim.assigned++;
+        }
+        queue.swap(remaining);
+        sim.batches++;
+    }
+
+    std::sort(batchMs.begin(), batchMs.end());
+    if (!batchMs.empty()) {
+        sim.p50BatchMs = batchMs[batchMs.size() / 2];
+        sim.p99BatchMs = batchMs[std::min(batchMs.size() - 1, batchMs.size() * 99 / 100)];
+        sim.maxBatchMs = batchMs.back();
+    }
+    sim.meanWaitBatches = sim.assigned > 0 ? waitSum / sim.assigned : 0.0;
+    return sim;
+}
+
+#endif
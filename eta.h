@@ -0,0 +1,275 @@
+#ifndef ETA_H
+#define ETA_H
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "delivery_log.h"
+#include "geo.h"
+#include "order_events.h"
+
+// Milestones an order passes on the way to 'Completed'
+enum EtaStage { ETA_PLACED, ETA_ACCEPTED, ETA_PREPARING, ETA_OUT, ETA_ARRIVED, ETA_STAGES };
+
+struct EtaEstimate {
+    int lowMinutes;
+    int highMinutes;
+    double expectedMinutes;     // still to go from now
+    long long samples;          // deliveries behind the estimate (0 = default)
+    std::string basis;          // "zone+hour", "zone", "hour", "all" or "default"
+};
+
+// Delivery ETA learned from completed deliveries. For every stage, the time
+// from reaching it to completion is kept as a running mean / variance
+// (Welford) at four levels: delivery zone (postcode) x hour of day, zone,
+// hour, and overall. A completion updates all four in O(1). An estimate uses
+// the most specific level with enough samples, counts back the time already
+// spent in the order's current stage, and reports the middle half of the
+// spread as a range.
+class EtaModel {
+private:
+    struct Running {
+        long long n = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double x) {
+            n++;
+            double d = x - mean;
+            mean += d / n;
+            m2 += d * (x - mean);
+        }
+        double stddev() const { return n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0; }
+    };
+
+    struct StageStats {
+        Running stage[ETA_STAGES];
+    };
+
+    struct InFlight {
+        std::string zone;
+        int hour;
+        time_t at[ETA_STAGES];
+    };
+
+    std::unordered_map<std::string, StageStats> stats;   // key: zone '#' hour, '*' for any
+    std::unordered_map<int, InFlight> inFlight;
+    long long learned = 0;
+    mutable std::mutex m;
+
+    enum { MIN_SAMPLES = 8 };
+
+    static std::string keyOf(const std::string& zone, int hour) {
+        return zone + "#" + (hour < 0 ? std::string("*") : std::to_string(hour));
+    }
+
+    static int hourOf(time_t when) {
+        struct tm t = {};
+#ifdef _WIN32
+        localtime_s(&t, &when);
+#else
+        localtime_r(&when, &t);
+#endif
+        return t.tm_hour;
+    }
+
+    // Caller holds m. Orders with no known zone only feed the hour and
+    // overall levels, the same ones an estimate without a zone reads.
+    void learn(const InFlight& order, time_t completedAt) {
+        const std::string keys[4] = {
+            keyOf(order.zone, order.hour), keyOf(order.zone, -1), keyOf("*", order.hour), keyOf("*", -1)
+        };
+        for (int s = 0; s < ETA_STAGES; s++) {
+            if (order.at[s] == 0 || completedAt < order.at[s]) continue;
+            double minutes = (completedAt - order.at[s]) / 60.0;
+            if (minutes > 24 * 60) continue;            // left open overnight, not a delivery time
+            for (int level = order.zone.empty() ? 2 : 0; level < 4; level++) stats[keys[level]].stage[s].add(minutes);
+        }
+        learned++;
+    }
+
+    // Caller holds m
+    EtaEstimate estimateLocked(const std::string& zone, int hour, int stage, double elapsedMinutes) const {
+        const std::string keys[4] = { keyOf(zone, hour), keyOf(zone, -1), keyOf("*", hour), keyOf("*", -1) };
+        const char* names[4] = { "zone+hour", "zone", "hour", "all" };
+        for (int level = 0; level < 4; level++) {
+            if (zone.empty() && level < 2) continue;
+            auto it = stats.find(keys[level]);
+            if (it == stats.end()) continue;
+            const Running& r = it->second.stage[stage];
+            if (r.n < MIN_SAMPLES) continue;
+
+            double remaining = std::max(1.0, r.mean - elapsedMinutes);
+            double half = std::max(2.5, 0.674 * r.stddev());     // interquartile half-width
+            EtaEstimate e;
+            e.expectedMinutes = remaining;
+            e.lowMinutes = std::max(1, static_cast<int>(std::floor(remaining - half)));
+            e.highMinutes = std::max(e.lowMinutes + 5, static_cast<int>(std::ceil(remaining + half)));
+            e.samples = r.n;
+            e.basis = names[level];
+            return e;
+        }
+        EtaEstimate fallback = { 30, 45, 37.5, 0, "default" };
+        return fallback;
+    }
+
+public:
+    static int stageOf(const std::string& status) {
+        if (status == "Accepted") return ETA_ACCEPTED;
+        if (status == "Preparing") return ETA_PREPARING;
+        if (status == "Out for Delivery") return ETA_OUT;
+        if (status == "Arrived") return ETA_ARRIVED;
+        return -1;
+    }
+
+    // Learns from the last `days` days of delivery_event history and picks
+    // up orders still on their way
+    void load(sql::Connection* con, int days = 90) {
+        DeliveryLog::ensureSchema(con);
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT o.OrdersID, UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, o.Orders_status, c.Customer_Address, "
+            "e.Status, UNIX_TIMESTAMP(e.EventTime) AS eventAt "
+            "FROM orders o JOIN customer c ON c.CustomerID = o.CustomerID "
+            "LEFT JOIN delivery_event e ON e.OrdersID = o.OrdersID "
+            "WHERE o.OrdersDate >= NOW() - INTERVAL " + std::to_string(days) + " DAY "
+            "ORDER BY o.OrdersID, e.EventTime, e.EventID"));
+
+        std::lock_guard<std::mutex> lock(m);
+        stats.clear();
+        inFlight.clear();
+        learned = 0;
+
+        int current = 0;
+        InFlight order = {};
+        time_t completedAt = 0;
+        bool open = false;
+        auto flush = [&]() {
+            if (current == 0) return;
+            if (completedAt > 0) learn(order, completedAt);
+            else if (open) inFlight[current] = order;
+        };
+        while (res->next()) {
+            int orderID = res->getInt("OrdersID");
+            if (orderID != current) {
+                flush();
+                current = orderID;
+                order = InFlight();
+                order.zone = GeocodeTable::postcodeOf(res->getString("Customer_Address"));
+                order.at[ETA_PLACED] = static_cast<time_t>(res->getInt64("placedAt"));
+                order.hour = hourOf(order.at[ETA_PLACED]);
+                completedAt = 0;
+                open = res->getString("Orders_status") != "Completed";
+            }
+            if (res->isNull("Status")) continue;
+            std::string status = res->getString("Status");
+            time_t at = static_cast<time_t>(res->getInt64("eventAt"));
+            if (status == "Completed") completedAt = at;
+            int stage = stageOf(status);
+            if (stage >= 0 && order.at[stage] == 0) order.at[stage] = at;
+        }
+        flush();
+    }
+
+    // New orders take their zone from the customer's current address (one
+    // primary-key read on `con`, so an address changed at checkout counts)
+    void attach(OrderEvents& events, sql::Connection* con) {
+        events.onOrderPlaced([this, con](const OrderPlacedEvent& e) {
+            std::string zone;
+            try {
+                zone = zoneOfCustomer(con, e.customerID);
+            }
+            catch (sql::SQLException&) {}
+            orderPlaced(e.orderID, e.placedAt, zone);
+        });
+        events.onOrderClaimed([this](const OrderClaimedEvent& e) { statusChanged(e.orderID, "Accepted", e.claimedAt); });
+        events.onStatusChanged([this](const OrderStatusEvent& e) { statusChanged(e.orderID, e.status, e.changedAt); });
+    }
+
+    static std::string zoneOfCustomer(sql::Connection* con, int customerID) {
+        if (!con) return "";
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT Customer_Address FROM customer WHERE CustomerID=?"));
+        pstmt->setInt(1, customerID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        return res->next() ? GeocodeTable::postcodeOf(res->getString("Customer_Address")) : "";
+    }
+
+    void orderPlaced(int orderID, time_t placedAt, const std::string& zone = "") {
+        std::lock_guard<std::mutex> lock(m);
+        InFlight& order = inFlight[orderID];
+        order = InFlight();
+        order.zone = zone;
+        order.at[ETA_PLACED] = placedAt;
+        order.hour = hourOf(placedAt);
+    }
+
+    void statusChanged(int orderID, const std::string& status, time_t when) {
+        std::lock_guard<std::mutex> lock(m);
+        auto it = inFlight.find(orderID);
+        if (it == inFlight.end()) return;
+        if (status == "Completed") {
+            learn(it->second, when);
+            inFlight.erase(it);
+            return;
+        }
+        int stage = stageOf(status);
+        if (stage >= 0 && it->second.at[stage] == 0) it->second.at[stage] = when;
+    }
+
+    // Time left for an order, from the latest stage it has reached. The
+    // delivery address (if given) fixes the order's zone the first time.
+    EtaEstimate estimate(int orderID, const std::string& address = "", time_t now = 0) {
+        if (now == 0) now = time(nullptr);
+        std::lock_guard<std::mutex> lock(m);
+        auto it = inFlight.find(orderID);
+        if (it == inFlight.end()) {
+            return estimateLocked(GeocodeTable::postcodeOf(address), hourOf(now), ETA_PLACED, 0.0);
+        }
+        InFlight& order = it->second;
+        if (order.zone.empty() && !address.empty()) order.zone = GeocodeTable::postcodeOf(address);
+        int stage = ETA_PLACED;
+        for (int s = ETA_STAGES - 1; s >= 0; s--) {
+            if (order.at[s] != 0) {
+                stage = s;
+                break;
+            }
+        }
+        double elapsed = std::max(0.0, (now - order.at[stage]) / 60.0);
+        return estimateLocked(order.zone, order.hour, stage, elapsed);
+    }
+
+    long long deliveriesLearned() const {
+        std::lock_guard<std::mutex> lock(m);
+        return learned;
+    }
+
+    size_t ordersInFlight() const {
+        std::lock_guard<std::mutex> lock(m);
+        return inFlight.size();
+    }
+
+    // Mean minutes from placing to completion by hour of day (all zones);
+    // negative where there are not enough samples
+    std::vector<double> placedToDoorByHour() const {
+        std::lock_guard<std::mutex> lock(m);
+        std::vector<double> out(24, -1.0);
+        for (int h = 0; h < 24; h++) {
+            auto it = stats.find(keyOf("*", h));
+            if (it != stats.end() && it->second.stage[ETA_PLACED].n >= MIN_SAMPLES) out[h] = it->second.stage[ETA_PLACED].mean;
+        }
+        return out;
+    }
+};
+
+#endif
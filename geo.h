@@ -0,0 +1,119 @@
+#ifndef GEO_H
+#define GEO_H
+
+#include <cctype>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "mysql_connection.h"
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+
+// Kitchen (pickup point) used when address_geocode has no 'KITCHEN' row
+#define KITCHEN_LAT 2.3139
+#define KITCHEN_LNG 102.3184
+
+struct GeoPoint {
+    double lat;
+    double lng;
+};
+
+// Equirectangular approximation: well under 0.1% off at city distances
+inline double distanceMeters(const GeoPoint& a, const GeoPoint& b) {
+    const double metersPerDegree = 111320.0;
+    double x = (b.lng - a.lng) * std::cos((a.lat + b.lat) * 0.5 * 3.14159265358979 / 180.0);
+    double y = b.lat - a.lat;
+    return std::sqrt(x * x + y * y) * metersPerDegree;
+}
+
+// Local address -> coordinate table (address_geocode), loaded into memory.
+// Rows are keyed by normalised address text; a row may also hold just a
+// 5-digit postcode, which then covers every address in that postcode.
+// Addresses found in neither place are reported as unknown.
+class GeocodeTable {
+private:
+    std::unordered_map<std::string, GeoPoint> entries;
+    GeoPoint kitchenPoint = { KITCHEN_LAT, KITCHEN_LNG };
+
+public:
+    // Lower case, punctuation dropped, runs of spaces collapsed
+    static std::string normalize(const std::string& address) {
+        std::string out;
+        bool space = false;
+        for (char ch : address) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (std::isalnum(c)) {
+                if (space && !out.empty()) out.push_back(' ');
+                out.push_back(static_cast<char>(std::tolower(c)));
+                space = false;
+            }
+            else {
+                space = true;
+            }
+        }
+        return out;
+    }
+
+    // Last standalone 5-digit number in the address, or ""
+    static std::string postcodeOf(const std::string& address) {
+        std::string found;
+        for (size_t i = 0; i < address.size(); i++) {
+            if (!std::isdigit(static_cast<unsigned char>(address[i]))) continue;
+            size_t j = i;
+            while (j < address.size() && std::isdigit(static_cast<unsigned char>(address[j]))) j++;
+            if (j - i == 5) found = address.substr(i, 5);
+            i = j;
+        }
+        return found;
+    }
+
+    static void ensureSchema(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS address_geocode ("
+            "Address VARCHAR(255) PRIMARY KEY, Lat DOUBLE NOT NULL, Lng DOUBLE NOT NULL, "
+            "UpdatedAt TIMESTAMP(6) NOT NULL DEFAULT CURRENT_TIMESTAMP(6) ON UPDATE CURRENT_TIMESTAMP(6))");
+    }
+
+    void load(sql::Connection* con) {
+        ensureSchema(con);
+        entries.clear();
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT Address, Lat, Lng FROM address_geocode"));
+        while (res->next()) {
+            GeoPoint p = { static_cast<double>(res->getDouble("Lat")), static_cast<double>(res->getDouble("Lng")) };
+            std::string key = normalize(res->getString("Address"));
+            if (key == "kitchen") kitchenPoint = p;
+            else entries[key] = p;
+        }
+    }
+
+    void add(sql::Connection* con, const std::string& address, const GeoPoint& p) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "INSERT INTO address_geocode (Address, Lat, Lng) VALUES (?, ?, ?) "
+            "ON DUPLICATE KEY UPDATE Lat = VALUES(Lat), Lng = VALUES(Lng)"));
+        pstmt->setString(1, address);
+        pstmt->setDouble(2, p.lat);
+        pstmt->setDouble(3, p.lng);
+        pstmt->executeUpdate();
+        entries[normalize(address)] = p;
+    }
+
+    bool locate(const std::string& address, GeoPoint& out) const {
+        auto it = entries.find(normalize(address));
+        if (it == entries.end()) {
+            std::string postcode = postcodeOf(address);
+            if (!postcode.empty()) it = entries.find(postcode);
+        }
+        if (it == entries.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    const GeoPoint& kitchen() const { return kitchenPoint; }
+    size_t size() const { return entries.size(); }
+};
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef GZIP_WRITER_H
+#define GZIP_WRITER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Minimal streaming gzip (RFC 1951/1952) writer so exports open with any
+// standard tool without pulling zlib into the project.
+// Each write() becomes one fixed-Huffman deflate block with LZ77 matches
+// (hash chains, 32 KB window) found within that chunk. That gives most of the
+// gain on repetitive CSV/NDJSON at a fraction of zlib's code size.
+class GzipWriter {
+private:
+    std::ofstream out;
+    uint32_t crc = 0xffffffffu;
+    uint32_t inputSize = 0;
+    uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    std::string pending;            // compressed bytes not yet written
+
+    enum { WINDOW = 32768, MIN_MATCH = 3, MAX_MATCH = 258, MAX_CHAIN = 32, HASH_BITS = 15 };
+    std::vector<int32_t> head, prev;
+
+    static const uint32_t* crcTable() {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            ready = true;
+        }
+        return table;
+    }
+
+    void putBits(uint32_t value, int count) {
+        bitBuffer |= value << bitCount;
+        bitCount += count;
+        while (bitCount >= 8) {
+            pending.push_back(static_cast<char>(bitBuffer & 0xff));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    // Huffman codes are defined MSB-first but packed LSB-first
+    void putCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++) {
+            reversed = (reversed << 1) | (code & 1);
+            code >>= 1;
+        }
+        putBits(reversed, length);
+    }
+
+    void putLiteral(int symbol) {
+        if (symbol < 144) putCode(0x30 + symbol, 8);
+        else if (symbol < 256) putCode(0x190 + (symbol - 144), 9);
+        else if (symbol < 280) putCode(symbol - 256, 7);
+        else putCode(0xc0 + (symbol - 280), 8);
+    }
+
+    void putMatch(int length, int distance) {
+        static const int lengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const int lengthExtra[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const int distBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const int distExtra[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        int l = 28;
+        while (lengthBase[l] > length) l--;
+        putLiteral(257 + l);
+        putBits(length - lengthBase[l], lengthExtra[l]);
+
+        int d = 29;
+        while (distBase[d] > distance) d--;
+        putCode(d, 5);
+        putBits(distance - distBase[d], distExtra[d]);
+    }
+
+    static uint32_t hash3(const unsigned char* p) {
+        return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & ((1u << HASH_BITS) - 1);
+    }
+
+    void deflateBlock(const unsigned char* data, size_t n, bool last) {
+        putBits(last ? 1 : 0, 1);
+        putBits(1, 2);      // fixed Huffman
+
+        std::fill(head.begin(), head.end(), -1);
+        if (prev.size() < n) prev.resize(n);
+
+        size_t i = 0;
+        while (i < n) {
+            int bestLen = 0, bestDist = 0;
+            if (i + MIN_MATCH <= n) {
+                uint32_t h = hash3(data + i);
+                int32_t candidate = head[h];
+                size_t maxLen = std::min(n - i, static_cast<size_t>(MAX_MATCH));
+                for (int chain = 0; candidate >= 0 && chain < MAX_CHAIN; chain++) {
+                    size_t dist = i - candidate;
+                    if (dist > WINDOW) break;
+                    size_t len = 0;
+                    while (len < maxLen && data[candidate + len] == data[i + len]) len++;
+                    if (static_cast<int>(len) > bestLen) {
+                        bestLen = static_cast<int>(len);
+                        bestDist = static_cast<int>(dist);
+                        if (len == maxLen) break;
+                    }
+                    candidate = prev[candidate];
+                }
+                prev[i] = head[h];
+                head[h] = static_cast<int32_t>(i);
+            }
+
+            if (bestLen >= MIN_MATCH) {
+                putMatch(bestLen, bestDist);
+                // Index the skipped positions so later matches can find them
+                for (size_t k = i + 1; k < i + bestLen && k + MIN_MATCH <= n; k++) {
+                    uint32_t h = hash3(data + k);
+                    prev[k] = head[h];
+                    head[h] = static_cast<int32_t>(k);
+                }
+                i += bestLen;
+            }
+            else {
+                putLiteral(data[i]);
+                i++;
+            }
+        }
+        putLiteral(256);    // end of block
+    }
+
+    void flushPending() {
+        out.write(pending.data(), pending.size());
+        pending.clear();
+    }
+
+public:
+    GzipWriter() : head(1 << HASH_BITS) {}
+
+    bool open(const std::string& path) {
+        out.open(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        static const unsigned char header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        return true;
+    }
+
+    void write(const char* data, size_t n) {
+        if (n == 0) return;
+        const uint32_t* table = crcTable();
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+        inputSize += static_cast<uint32_t>(n);
+
+        deflateBlock(p, n, false);
+        flushPending();
+    }
+
+    bool close() {
+        // Empty final block, byte-align, then CRC32 and size trailer
+        putBits(1, 1);
+        putBits(1, 2);
+        putLiteral(256);
+        if (bitCount > 0) putBits(0, 8 - bitCount);
+
+        uint32_t finalCrc = crc ^ 0xffffffffu;
+        for (int i = 0; i < 4; i++) pending.push_back(static_cast<char>((finalCrc >> (8 * i)) & 0xff));
+        for (int i = 0; i < 4; i++) pending.push_back(static_cast<char>((inputSize >> (8 * i)) & 0xff));
+        flushPending();
+        out.close();
+        return !out.fail();
+    }
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef HLL_H
+#define HLL_H
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// HyperLogLog distinct-count sketch (Flajolet et al., 64-bit hash, so no
+// large-range correction). 2^precision one-byte registers; the standard
+// error is 1.04 / sqrt(2^precision). Two sketches with the same precision
+// merge by taking the register-wise maximum, which is exactly the sketch of
+// the union of their inputs.
+class HyperLogLog {
+private:
+    int p;
+    std::vector<uint8_t> registers;
+
+    static uint64_t mix(uint64_t x) {
+        // splitmix64 finaliser: spreads sequential IDs over all 64 bits
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static void putVarint(std::string& out, uint32_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    static bool getVarint(const std::string& in, size_t& pos, uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 35 && pos < in.size(); shift += 7) {
+            uint8_t b = static_cast<uint8_t>(in[pos++]);
+            v |= static_cast<uint32_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+public:
+    enum { MIN_PRECISION = 4, MAX_PRECISION = 16 };
+
+    explicit HyperLogLog(int precision = 12) : p(precision), registers(size_t(1) << precision, 0) {}
+
+    // Smallest precision whose standard error is at most relativeError
+    static int precisionFor(double relativeError) {
+        int precision = MIN_PRECISION;
+        while (precision < MAX_PRECISION && 1.04 / std::sqrt(double(1 << precision)) > relativeError) precision++;
+        return precision;
+    }
+
+    int precision() const { return p; }
+    double standardError() const { return 1.04 / std::sqrt(double(registers.size())); }
+
+    void add(uint64_t value) {
+        uint64_t h = mix(value);
+        size_t index = static_cast<size_t>(h >> (64 - p));
+        uint64_t rest = h << p;
+        uint8_t rank = 1;
+        while (rank <= 64 - p && !(rest & 0x8000000000000000ULL)) {
+            rank++;
+            rest <<= 1;
+        }
+        if (rank > registers[index]) registers[index] = rank;
+    }
+
+    bool merge(const HyperLogLog& other) {
+        if (other.p != p) return false;
+        for (size_t i = 0; i < registers.size(); i++) {
+            if (other.registers[i] > registers[i]) registers[i] = other.registers[i];
+        }
+        return true;
+    }
+
+    double estimate() const {
+        double m = static_cast<double>(registers.size());
+        double alpha = (registers.size() == 16) ? 0.673
+            : (registers.size() == 32) ? 0.697
+            : (registers.size() == 64) ? 0.709
+            : 0.7213 / (1.0 + 1.079 / m);
+
+        double sum = 0.0;
+        int zeros = 0;
+        for (uint8_t r : registers) {
+            sum += std::ldexp(1.0, -r);
+            if (r == 0) zeros++;
+        }
+        double e = alpha * m * m / sum;
+        if (e <= 2.5 * m && zeros > 0) e = m * std::log(m / zeros);     // linear counting
+        return e;
+    }
+
+    // Compact form: precision byte, then either the non-zero registers as
+    // (index delta, value) varint pairs or, once that is larger, 6-bit packed
+    // dense registers. A sketch of a few dozen buyers stays under ~100 bytes.
+    std::string serialize() const {
+        std::string sparse;
+        uint32_t last = 0;
+        size_t dense = (registers.size() * 6 + 7) / 8;
+        for (uint32_t i = 0; i < registers.size() && sparse.size() < dense; i++) {
+            if (registers[i] == 0) continue;
+            putVarint(sparse, i - last);
+            sparse.push_back(static_cast<char>(registers[i]));
+            last = i;
+        }
+
+        std::string out;
+        out.push_back(static_cast<char>(p));
+        if (sparse.size() < dense) {
+            out.push_back(1);
+            out.append(sparse);
+            return out;
+        }
+
+        out.push_back(0);
+        uint32_t bits = 0;
+        int count = 0;
+        for (uint8_t r : registers) {
+            bits |= static_cast<uint32_t>(r & 0x3f) << count;
+            count += 6;
+            while (count >= 8) {
+                out.push_back(static_cast<char>(bits & 0xff));
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+        if (count > 0) out.push_back(static_cast<char>(bits & 0xff));
+        return out;
+    }
+
+    static bool deserialize(const std::string& in, HyperLogLog& out) {
+        if (in.size() < 2) return false;
+        int precision = static_cast<uint8_t>(in[0]);
+        if (precision < MIN_PRECISION || precision > MAX_PRECISION) return false;
+        HyperLogLog sketch(precision);
+
+        size_t pos = 2;
+        if (in[1] == 1) {
+            uint32_t index = 0, delta;
+            while (pos < in.size()) {
+                if (!getVarint(in, pos, delta) || pos >= in.size()) return false;
+                index += delta;
+                if (index >= sketch.registers.size()) return false;
+                sketch.registers[index] = static_cast<uint8_t>(in[pos++]);
+            }
+        }
+        else {
+            uint32_t bits = 0;
+            int count = 0;
+            for (size_t i = 0; i < sketch.registers.size(); i++) {
+                while (count < 6) {
+                    if (pos >= in.size()) return false;
+                    bits |= static_cast<uint32_t>(static_cast<uint8_t>(in[pos++])) << count;
+                    count += 8;
+                }
+                sketch.registers[i] = static_cast<uint8_t>(bits & 0x3f);
+                bits >>= 6;
+                count -= 6;
+            }
+        }
+        out = sketch;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,751 @@
+#ifndef KITCHEN_H
+#define KITCHEN_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "order_events.h"
+
+struct KitchenStation {
+    int stationID;
+    std::string name;
+    int cooks;              // tickets the station works on at once
+};
+
+struct KitchenLine {
+    int menuID;
+    int quantity;
+    std::string name;
+};
+
+struct KitchenTicket {
+    int ticketID;
+    int orderID;
+    int stationID;
+    std::vector<KitchenLine> lines;
+    double estimate;        // seconds
+    double dueAt;           // when the rider is expected at the pass
+    double queuedAt;
+    double startedAt;       // -1 while queued
+    double finishAt;        // -1 while queued; when cooking ends unless bumped
+    bool done;
+};
+
+struct StationBoard {
+    KitchenStation station;
+    std::vector<KitchenTicket> cooking;
+    std::vector<KitchenTicket> queued;      // in the order they will be cooked
+};
+
+// Single-threaded kitchen model with an explicit clock (seconds), shared by
+// the live KitchenService and the simulation. An order becomes one ticket
+// per station its items need. Each station has a priority queue of waiting
+// tickets keyed by the latest time the ticket can start and still be ready
+// when its rider arrives (due time - estimated prep), and starts the most
+// urgent one whenever a cook is free. Ready times are projected by playing
+// the queues forward with the estimates.
+class KitchenScheduler {
+public:
+    enum { DEFAULT_PREP_SECONDS = 300 };
+
+    // Seconds a ticket really takes; the live kitchen clears unbumped
+    // tickets at twice the estimate, the simulation draws noise
+    std::function<double(const KitchenTicket&)> actualSeconds;
+
+    // Called when an order's last ticket finishes
+    std::function<void(int orderID, double readyAt)> onReady;
+
+private:
+    struct Prep {
+        int stationID;
+        double seconds;
+    };
+    struct Station {
+        KitchenStation info;
+        std::set<std::pair<double, int>> queue;     // (priority key, ticketID)
+        std::vector<int> cooking;
+    };
+    struct OrderState {
+        double placedAt;
+        std::vector<int> tickets;
+        int open;
+        double readyAt;     // -1 until every ticket is done
+    };
+
+    std::map<int, Station> stations;
+    std::unordered_map<int, Prep> prep;
+    std::unordered_map<int, KitchenTicket> tickets;
+    std::unordered_map<int, OrderState> orders;
+    int nextTicketID = 1;
+    double promiseSeconds;
+    bool fifo;
+    long long version = 0;
+
+    // Projection cache
+    std::unordered_map<int, double> projectedReady;
+    long long projectedVersion = -1;
+    double projectedAt = 0.0;
+
+    double keyOf(const KitchenTicket& t) const {
+        return fifo ? t.queuedAt : t.dueAt - t.estimate;
+    }
+
+    // One unit at full time, each extra unit of the same item a quarter more
+    double lineSeconds(const KitchenLine& line) const {
+        auto p = prep.find(line.menuID);
+        double seconds = p != prep.end() ? p->second.seconds : static_cast<double>(DEFAULT_PREP_SECONDS);
+        return seconds * (1.0 + 0.25 * std::max(0, line.quantity - 1));
+    }
+
+    int stationOfLine(int menuID) const {
+        auto p = prep.find(menuID);
+        if (p != prep.end() && stations.count(p->second.stationID)) return p->second.stationID;
+        return stations.empty() ? 0 : stations.begin()->first;
+    }
+
+    void startNext(Station& s, double now) {
+        while (static_cast<int>(s.cooking.size()) < s.info.cooks && !s.queue.empty()) {
+            int id = s.queue.begin()->second;
+            s.queue.erase(s.queue.begin());
+            KitchenTicket& t = tickets[id];
+            t.startedAt = now;
+            t.finishAt = now + (actualSeconds ? actualSeconds(t) : t.estimate);
+            s.cooking.push_back(id);
+        }
+    }
+
+    void finish(Station& s, size_t slot, double at) {
+        int id = s.cooking[slot];
+        s.cooking.erase(s.cooking.begin() + slot);
+        KitchenTicket& t = tickets[id];
+        t.finishAt = at;
+        t.done = true;
+        ticketsDone++;
+        auto o = orders.find(t.orderID);
+        if (o != orders.end() && --o->second.open == 0) {
+            o->second.readyAt = at;
+            ordersReady++;
+            if (onReady) onReady(t.orderID, at);
+        }
+        startNext(s, at);
+        version++;
+    }
+
+    void project(double now) {
+        if (projectedVersion == version && std::fabs(now - projectedAt) < 1.0) return;
+        std::unordered_map<int, double> finish;
+        for (auto& entry : stations) {
+            Station& s = entry.second;
+            std::priority_queue<double, std::vector<double>, std::greater<double>> freeAt;
+            for (int id : s.cooking) {
+                const KitchenTicket& t = tickets[id];
+                double done = std::max(now, t.startedAt + t.estimate);
+                finish[id] = done;
+                freeAt.push(done);
+            }
+            for (int c = static_cast<int>(s.cooking.size()); c < s.info.cooks; c++) freeAt.push(now);
+            for (const auto& q : s.queue) {
+                double start = freeAt.top();
+                freeAt.pop();
+                double done = start + tickets[q.second].estimate;
+                finish[q.second] = done;
+                freeAt.push(done);
+            }
+        }
+        projectedReady.clear();
+        for (const auto& o : orders) {
+            if (o.second.readyAt >= 0) continue;
+            double ready = now;
+            for (int id : o.second.tickets) {
+                const KitchenTicket& t = tickets[id];
+                ready = std::max(ready, t.done ? t.finishAt : finish[id]);
+            }
+            projectedReady[o.first] = ready;
+        }
+        projectedVersion = version;
+        projectedAt = now;
+    }
+
+public:
+    long long ticketsDone = 0;
+    long long ordersReady = 0;
+
+    // fifoQueues = true cooks tickets strictly in arrival order (the baseline)
+    KitchenScheduler(double promiseMinutes = 20.0, bool fifoQueues = false)
+        : promiseSeconds(promiseMinutes * 60.0), fifo(fifoQueues) {}
+
+    void addStation(const KitchenStation& station) {
+        Station& s = stations[station.stationID];
+        s.info = station;
+        s.info.cooks = std::max(1, station.cooks);
+    }
+
+    void setPrep(int menuID, int stationID, double seconds) {
+        Prep p = { stationID, std::max(10.0, seconds) };
+        prep[menuID] = p;
+    }
+
+    int stationFor(int menuID) const { return stationOfLine(menuID); }
+
+    double prepSeconds(int menuID) const {
+        auto p = prep.find(menuID);
+        return p != prep.end() ? p->second.seconds : static_cast<double>(DEFAULT_PREP_SECONDS);
+    }
+
+    // Due at placedAt + the promise until a rider's arrival is known
+    void addOrder(int orderID, double placedAt, const std::vector<KitchenLine>& lines, double now) {
+        if (orders.count(orderID) || lines.empty() || stations.empty()) return;
+        std::map<int, std::vector<KitchenLine>> byStation;
+        for (const KitchenLine& line : lines) byStation[stationOfLine(line.menuID)].push_back(line);
+
+        OrderState& o = orders[orderID];
+        o.placedAt = placedAt;
+        o.open = 0;
+        o.readyAt = -1.0;
+        for (auto& entry : byStation) {
+            KitchenTicket t;
+            t.ticketID = nextTicketID++;
+            t.orderID = orderID;
+            t.stationID = entry.first;
+            t.lines = entry.second;
+            t.estimate = 0.0;
+            for (const KitchenLine& line : t.lines) t.estimate += lineSeconds(line);
+            t.dueAt = placedAt + promiseSeconds;
+            t.queuedAt = now;
+            t.startedAt = t.finishAt = -1.0;
+            t.done = false;
+            tickets[t.ticketID] = t;
+            o.tickets.push_back(t.ticketID);
+            o.open++;
+            stations[t.stationID].queue.insert(std::make_pair(keyOf(t), t.ticketID));
+        }
+        for (auto& entry : byStation) startNext(stations[entry.first], now);
+        version++;
+    }
+
+    // The rider will be at the pass at dueAt; waiting tickets are re-ranked
+    void setDue(int orderID, double dueAt) {
+        auto o = orders.find(orderID);
+        if (o == orders.end()) return;
+        for (int id : o->second.tickets) {
+            KitchenTicket& t = tickets[id];
+            if (t.startedAt < 0) {
+                Station& s = stations[t.stationID];
+                s.queue.erase(std::make_pair(keyOf(t), id));
+                t.dueAt = dueAt;
+                s.queue.insert(std::make_pair(keyOf(t), id));
+            }
+            else {
+                t.dueAt = dueAt;
+            }
+        }
+        version++;
+    }
+
+    // Finishes every ticket due by `now`, in time order, starting the next
+    // ticket on each freed cook at the moment it frees up
+    void advance(double now) {
+        while (true) {
+            Station* next = nullptr;
+            size_t slot = 0;
+            double at = std::numeric_limits<double>::infinity();
+            for (auto& entry : stations) {
+                Station& s = entry.second;
+                for (size_t i = 0; i < s.cooking.size(); i++) {
+                    double f = tickets[s.cooking[i]].finishAt;
+                    if (f < at) {
+                        at = f;
+                        next = &s;
+                        slot = i;
+                    }
+                }
+            }
+            if (!next || at > now) return;
+            finish(*next, slot, at);
+        }
+    }
+
+    // Marks a cooking ticket finished now. Returns the seconds it took, or
+    // -1 if it is not cooking.
+    double bump(int ticketID, double now) {
+        auto t = tickets.find(ticketID);
+        if (t == tickets.end() || t->second.done || t->second.startedAt < 0) return -1.0;
+        Station& s = stations[t->second.stationID];
+        auto slot = std::find(s.cooking.begin(), s.cooking.end(), ticketID);
+        if (slot == s.cooking.end()) return -1.0;
+        double took = now - t->second.startedAt;
+        finish(s, static_cast<size_t>(slot - s.cooking.begin()), now);
+        return took;
+    }
+
+    // Lines of a ticket with the prep seconds each should take from now on,
+    // learned from how long the ticket really took (moving average)
+    std::vector<std::pair<int, double>> learn(int ticketID, double took, double rate = 0.2) {
+        std::vector<std::pair<int, double>> updated;
+        auto t = tickets.find(ticketID);
+        if (t == tickets.end() || t->second.estimate <= 0.0) return updated;
+        double ratio = std::max(0.3, std::min(3.0, took / t->second.estimate));
+        for (const KitchenLine& line : t->second.lines) {
+            Prep& p = prep[line.menuID];
+            if (p.seconds <= 0.0) {
+                p.stationID = t->second.stationID;
+                p.seconds = DEFAULT_PREP_SECONDS;
+            }
+            p.seconds += rate * (p.seconds * ratio - p.seconds);
+            updated.push_back(std::make_pair(line.menuID, p.seconds));
+        }
+        return updated;
+    }
+
+    // Forgets an order (picked up or cancelled), queued tickets included
+    void remove(int orderID, double now) {
+        auto o = orders.find(orderID);
+        if (o == orders.end()) return;
+        for (int id : o->second.tickets) {
+            KitchenTicket& t = tickets[id];
+            Station& s = stations[t.stationID];
+            if (t.startedAt < 0) s.queue.erase(std::make_pair(keyOf(t), id));
+            auto slot = std::find(s.cooking.begin(), s.cooking.end(), id);
+            if (slot != s.cooking.end()) {
+                s.cooking.erase(slot);
+                startNext(s, now);
+            }
+            tickets.erase(id);
+        }
+        orders.erase(o);
+        version++;
+    }
+
+    // Ready orders older than maxAgeSeconds (collected without an event)
+    void expireReady(double now, double maxAgeSeconds) {
+        std::vector<int> stale;
+        for (const auto& o : orders) {
+            if (o.second.readyAt >= 0 && now - o.second.readyAt > maxAgeSeconds) stale.push_back(o.first);
+        }
+        for (int orderID : stale) remove(orderID, now);
+    }
+
+    bool hasOrder(int orderID) const { return orders.count(orderID) > 0; }
+
+    // Actual ready time if ready, else projected; -1 for unknown orders
+    double readyAt(int orderID, double now) {
+        auto o = orders.find(orderID);
+        if (o == orders.end()) return -1.0;
+        if (o->second.readyAt >= 0) return o->second.readyAt;
+        project(now);
+        return projectedReady[orderID];
+    }
+
+    std::vector<StationBoard> board() const {
+        std::vector<StationBoard> out;
+        for (const auto& entry : stations) {
+            StationBoard b;
+            b.station = entry.second.info;
+            for (int id : entry.second.cooking) b.cooking.push_back(tickets.at(id));
+            for (const auto& q : entry.second.queue) b.queued.push_back(tickets.at(q.second));
+            out.push_back(b);
+        }
+        return out;
+    }
+
+    std::vector<std::pair<int, double>> readyOrders() const {
+        std::vector<std::pair<int, double>> out;
+        for (const auto& o : orders) {
+            if (o.second.readyAt >= 0) out.push_back(std::make_pair(o.first, o.second.readyAt));
+        }
+        std::sort(out.begin(), out.end(), [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.second < b.second; });
+        return out;
+    }
+
+    std::vector<KitchenStation> stationList() const {
+        std::vector<KitchenStation> out;
+        for (const auto& entry : stations) out.push_back(entry.second.info);
+        return out;
+    }
+
+    size_t openOrders() const {
+        size_t n = 0;
+        for (const auto& o : orders) n += o.second.readyAt < 0 ? 1 : 0;
+        return n;
+    }
+};
+
+// Live kitchen: stations (kitchen_station) and per-item prep time and
+// station (menu_prep) from the database, tickets from order events. Riders'
+// arrival times re-rank waiting tickets; the dispatcher asks readyAt() so it
+// only sends riders for food that will be ready when they get there.
+// Tickets are cleared by bumping them (which teaches the item prep times)
+// or, if nobody does, at twice their estimate.
+class KitchenService {
+private:
+    KitchenScheduler scheduler;
+    double riderLeadSeconds;
+    mutable std::mutex m;
+
+    static double now() { return static_cast<double>(time(nullptr)); }
+
+    // Caller holds m
+    void tick() {
+        double t = now();
+        scheduler.advance(t);
+        scheduler.expireReady(t, 30 * 60);
+    }
+
+public:
+    KitchenService(double promiseMinutes = 20.0, int riderLeadSecs = 480) : scheduler(promiseMinutes), riderLeadSeconds(riderLeadSecs) {
+        scheduler.actualSeconds = [](const KitchenTicket& t) { return 2.0 * t.estimate; };
+    }
+
+    // Stations default to one per menu category with two cooks, items to
+    // their category's station at DEFAULT_PREP_SECONDS
+    static void ensureSchema(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS kitchen_station ("
+            "StationID INT PRIMARY KEY, Station_Name VARCHAR(50) NOT NULL, Cooks INT NOT NULL DEFAULT 2)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS menu_prep ("
+            "MenuID INT PRIMARY KEY, StationID INT NOT NULL, PrepSeconds INT NOT NULL)");
+        stmt->execute(
+            "INSERT IGNORE INTO kitchen_station (StationID, Station_Name, Cooks) "
+            "SELECT CategoryID, CategoryName, 2 FROM category");
+        stmt->execute(
+            "INSERT IGNORE INTO menu_prep (MenuID, StationID, PrepSeconds) "
+            "SELECT MenuID, CategoryID, " + std::to_string(KitchenScheduler::DEFAULT_PREP_SECONDS) + " FROM menu");
+    }
+
+    // Stations, prep times, and the orders already waiting for the kitchen
+    void load(sql::Connection* con) {
+        ensureSchema(con);
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::lock_guard<std::mutex> lock(m);
+
+        std::unique_ptr<sql::ResultSet> st(stmt->executeQuery("SELECT StationID, Station_Name, Cooks FROM kitchen_station"));
+        while (st->next()) {
+            KitchenStation s = { st->getInt("StationID"), st->getString("Station_Name"), st->getInt("Cooks") };
+            scheduler.addStation(s);
+        }
+        std::unique_ptr<sql::ResultSet> pr(stmt->executeQuery("SELECT MenuID, StationID, PrepSeconds FROM menu_prep"));
+        while (pr->next()) scheduler.setPrep(pr->getInt("MenuID"), pr->getInt("StationID"), pr->getInt("PrepSeconds"));
+
+        std::unique_ptr<sql::ResultSet> open(stmt->executeQuery(
+            "SELECT o.OrdersID, UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, oi.MenuID, oi.Quantity, m.Menu_Name "
+            "FROM orders o JOIN order_item oi ON oi.OrdersID = o.OrdersID JOIN menu m ON m.MenuID = oi.MenuID "
+            "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL "
+            "ORDER BY o.OrdersID"));
+        int current = 0;
+        double placedAt = 0.0;
+        std::vector<KitchenLine> lines;
+        double t = now();
+        while (open->next()) {
+            int orderID = open->getInt("OrdersID");
+            if (orderID != current) {
+                scheduler.addOrder(current, placedAt, lines, t);
+                current = orderID;
+                placedAt = static_cast<double>(open->getInt64("placedAt"));
+                lines.clear();
+            }
+            KitchenLine line = { open->getInt("MenuID"), open->getInt("Quantity"), open->getString("Menu_Name") };
+            lines.push_back(line);
+        }
+        scheduler.addOrder(current, placedAt, lines, t);
+    }
+
+    void attach(OrderEvents& events) {
+        events.onOrderPlaced([this](const OrderPlacedEvent& e) {
+            std::vector<KitchenLine> lines;
+            for (const OrderEventLine& l : e.lines) {
+                KitchenLine line = { l.menuID, l.quantity, l.menuName };
+                lines.push_back(line);
+            }
+            std::lock_guard<std::mutex> lock(m);
+            tick();
+            scheduler.addOrder(e.orderID, static_cast<double>(e.placedAt), lines, now());
+        });
+        events.onOrderClaimed([this](const OrderClaimedEvent& e) {
+            std::lock_guard<std::mutex> lock(m);
+            tick();
+            scheduler.setDue(e.orderID, static_cast<double>(e.claimedAt) + riderLeadSeconds);
+        });
+        events.onStatusChanged([this](const OrderStatusEvent& e) {
+            if (e.status != "Arrived" && e.status != "Completed") return;
+            std::lock_guard<std::mutex> lock(m);
+            scheduler.remove(e.orderID, now());
+        });
+    }
+
+    // Expected ready time (past if ready); 0 if the kitchen does not know the order
+    time_t readyAt(int orderID) {
+        std::lock_guard<std::mutex> lock(m);
+        tick();
+        double ready = scheduler.readyAt(orderID, now());
+        return ready < 0 ? 0 : static_cast<time_t>(ready);
+    }
+
+    int riderLead() const { return static_cast<int>(riderLeadSeconds); }
+
+    std::vector<StationBoard> board() {
+        std::lock_guard<std::mutex> lock(m);
+        tick();
+        return scheduler.board();
+    }
+
+    std::vector<std::pair<int, double>> readyOrders() {
+        std::lock_guard<std::mutex> lock(m);
+        tick();
+        return scheduler.readyOrders();
+    }
+
+    // Marks a ticket done and stores what it taught about its items' prep
+    // times. Returns false if the ticket is not cooking.
+    bool bump(sql::Connection* con, int ticketID) {
+        std::vector<std::pair<int, double>> learned;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            tick();
+            double took = scheduler.bump(ticketID, now());
+            if (took < 0) return false;
+            learned = scheduler.learn(ticketID, took);
+        }
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "UPDATE menu_prep SET PrepSeconds = ? WHERE MenuID = ?"));
+        for (const auto& item : learned) {
+            pstmt->setInt(1, static_cast<int>(std::lround(item.second)));
+            pstmt->setInt(2, item.first);
+            pstmt->executeUpdate();
+        }
+        return true;
+    }
+
+    std::vector<KitchenStation> stations() const {
+        std::lock_guard<std::mutex> lock(m);
+        return scheduler.stationList();
+    }
+
+    // (station, prep seconds) the kitchen would use for an item
+    std::pair<int, double> prepOf(int menuID) const {
+        std::lock_guard<std::mutex> lock(m);
+        return std::make_pair(scheduler.stationFor(menuID), scheduler.prepSeconds(menuID));
+    }
+};
+
+struct SimOrder {
+    int orderID;
+    double placedAt;
+    std::vector<KitchenLine> lines;
+};
+
+struct KitchenSimResult {
+    std::string policy;
+    int orders;
+    double avgReadyMinutes;         // placed -> food ready
+    double avgRiderWaitMinutes;     // rider at the pass before the food
+    double p90RiderWaitMinutes;
+    double riderIdleHours;          // total rider waiting at the pass
+    double avgFoodWaitMinutes;      // food at the pass before the rider
+    int lateOrders;                 // ready after the rider arrived, by more than 2 minutes
+};
+
+// Discrete-event replay of an order stream through a kitchen. Events are
+// order arrivals, cooking completions (advance) and, when gated, a dispatch
+// check every 15 s. Baseline: FIFO stations and a rider sent 1 minute after
+// each order. Scheduled: priority queues by latest start, and each rider sent
+// once the projected ready time is within their travel time (so they arrive
+// as the food does). Both see the same prep noise and rider travel times.
+inline KitchenSimResult simulateKitchen(const std::vector<SimOrder>& stream, const std::vector<KitchenStation>& stations,
+    const std::function<std::pair<int, double>(int menuID)>& prepOf, bool scheduled, uint64_t seed = 17) {
+    KitchenScheduler kitchen(20.0, !scheduled);
+    for (const KitchenStation& s : stations) kitchen.addStation(s);
+
+    // Per-ticket prep noise and per-order travel, identical for both policies
+    auto mix = [seed](uint64_t x) {
+        x += seed * 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<double>((x ^ (x >> 31)) >> 11) / 9007199254740992.0;
+    };
+    kitchen.actualSeconds = [&mix](const KitchenTicket& t) {
+        double u = mix(static_cast<uint64_t>(t.orderID) * 31 + static_cast<uint64_t>(t.stationID));
+        return t.estimate * (0.8 + 0.4 * u);                    // +-20%
+    };
+    auto travelOf = [&mix](int orderID) { return 240.0 + 480.0 * mix(static_cast<uint64_t>(orderID) * 7919); };   // 4-12 min
+
+    std::unordered_map<int, double> riderAt, readyAt, placed;
+    std::set<int> undispatched;
+    kitchen.onReady = [&readyAt](int orderID, double at) { readyAt[orderID] = at; };
+
+    for (const SimOrder& o : stream) {
+        for (const KitchenLine& line : o.lines) {
+            std::pair<int, double> p = prepOf(line.menuID);
+            kitchen.setPrep(line.menuID, p.first, p.second);
+        }
+    }
+
+    const double checkEvery = 15.0;
+    double clock = stream.empty() ? 0.0 : stream.front().placedAt;
+    double nextCheck = clock;
+    size_t next = 0;
+    while (next < stream.size() || !undispatched.empty() || kitchen.openOrders() > 0) {
+        double arrival = next < stream.size() ? stream[next].placedAt : std::numeric_limits<double>::infinity();
+        double t = scheduled && !undispatched.empty() ? std::min(arrival, nextCheck) : arrival;
+        if (t == std::numeric_limits<double>::infinity()) {
+            kitchen.advance(std::numeric_limits<double>::max());
+            break;
+        }
+        clock = std::max(clock, t);
+        kitchen.advance(clock);
+
+        if (arrival <= clock) {
+            const SimOrder& o = stream[next++];
+            placed[o.orderID] = o.placedAt;
+            kitchen.addOrder(o.orderID, o.placedAt, o.lines, clock);
+            if (scheduled) undispatched.insert(o.orderID);
+            else {
+                riderAt[o.orderID] = o.placedAt + 60.0 + travelOf(o.orderID);
+                kitchen.setDue(o.orderID, riderAt[o.orderID]);
+            }
+        }
+        if (scheduled && nextCheck <= clock) {
+            for (auto it = undispatched.begin(); it != undispatched.end();) {
+                double travel = travelOf(*it);
+                if (kitchen.readyAt(*it, clock) - travel <= clock) {
+                    riderAt[*it] = clock + travel;
+                    kitchen.setDue(*it, riderAt[*it]);
+                    it = undispatched.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            nextCheck = clock + checkEvery;
+        }
+    }
+
+    KitchenSimResult r = {};
+    r.policy = scheduled ? "Priority queues + gated dispatch" : "FIFO + dispatch on order";
+    std::vector<double> waits;
+    double readySum = 0.0, foodWait = 0.0, riderWait = 0.0;
+    for (const auto& o : readyAt) {
+        auto rider = riderAt.find(o.first);
+        if (rider == riderAt.end()) continue;
+        double wait = std::max(0.0, o.second - rider->second);
+        waits.push_back(wait / 60.0);
+        riderWait += wait;
+        foodWait += std::max(0.0, rider->second - o.second);
+        readySum += o.second - placed[o.first];
+        if (wait > 120.0) r.lateOrders++;
+    }
+    r.orders = static_cast<int>(waits.size());
+    if (r.orders > 0) {
+        std::sort(waits.begin(), waits.end());
+        r.avgReadyMinutes = readySum / r.orders / 60.0;
+        r.avgRiderWaitMinutes = riderWait / r.orders / 60.0;
+        r.p90RiderWaitMinutes = waits[static_cast<size_t>(0.9 * (waits.size() - 1))];
+        r.avgFoodWaitMinutes = foodWait / r.orders / 60.0;
+        r.riderIdleHours = riderWait / 3600.0;
+    }
+    return r;
+}
+
+struct KitchenBenchmark {
+    std::string source;             // "history" or "synthetic"
+    int orders;
+    double replayMs;
+    KitchenSimResult baseline;
+    KitchenSimResult scheduled;
+};
+
+// Replays the last `days` days of orders at their real times, day after
+// day, through both policies using the kitchen's current stations and prep
+// times. Falls back to a synthetic lunch and dinner rush when there are
+// fewer than 50 historical orders.
+inline KitchenBenchmark benchmarkKitchen(sql::Connection* con, KitchenService& service, int days = 30) {
+    KitchenBenchmark bench = {};
+    std::vector<SimOrder> stream;
+    std::vector<KitchenStation> stations = service.stations();
+    if (stations.empty()) {
+        const char* names[] = { "Grill", "Wok", "Fryer", "Drinks" };
+        for (int i = 0; i < 4; i++) stations.push_back(KitchenStation{ i + 1, names[i], i == 3 ? 2 : 3 });
+    }
+
+    if (con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT o.OrdersID, UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, oi.MenuID, oi.Quantity "
+            "FROM orders o JOIN order_item oi ON oi.OrdersID = o.OrdersID "
+            "WHERE o.OrdersDate >= NOW() - INTERVAL " + std::to_string(days) + " DAY "
+            "ORDER BY o.OrdersDate, o.OrdersID"));
+        while (res->next()) {
+            int orderID = res->getInt("OrdersID");
+            if (stream.empty() || stream.back().orderID != orderID) {
+                SimOrder o = { orderID, static_cast<double>(res->getInt64("placedAt")), std::vector<KitchenLine>() };
+                stream.push_back(o);
+            }
+            KitchenLine line = { res->getInt("MenuID"), res->getInt("Quantity"), "" };
+            stream.back().lines.push_back(line);
+        }
+    }
+    bench.source = "history";
+
+    // Thin history: one synthetic day instead
+    if (stream.size() < 50) {
+        bench.source = "synthetic";
+        stream.clear();
+        uint64_t state = 99;
+        auto uniform = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<double>(state >> 11) / 9007199254740992.0;
+        };
+        // Poisson arrivals: 20 orders/hour off-peak, 60 in the 12:00 and 19:00 rushes
+        double t = 10 * 3600.0;
+        int id = 1;
+        while (t < 22 * 3600.0) {
+            int hour = static_cast<int>(t / 3600.0);
+            double rate = (hour == 12 || hour == 13 || hour == 19 || hour == 20) ? 60.0 : 20.0;
+            t += -std::log(1.0 - uniform()) * 3600.0 / rate;
+            SimOrder o = { id++, t, std::vector<KitchenLine>() };
+            int lines = 1 + static_cast<int>(uniform() * 3);
+            for (int l = 0; l < lines; l++) {
+                KitchenLine line = { 1 + static_cast<int>(uniform() * 24), 1 + static_cast<int>(uniform() * 2), "" };
+                o.lines.push_back(line);
+            }
+            stream.push_back(o);
+        }
+    }
+    bench.orders = static_cast<int>(stream.size());
+
+    // Synthetic items are spread across the stations with made-up prep times
+    std::function<std::pair<int, double>(int)> prepOf = [&](int menuID) {
+        if (bench.source == "history") return service.prepOf(menuID);
+        int station = stations[static_cast<size_t>(menuID) % stations.size()].stationID;
+        return std::make_pair(station, 120.0 + (menuID * 37 % 10) * 20.0);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    bench.baseline = simulateKitchen(stream, stations, prepOf, false);
+    bench.scheduled = simulateKitchen(stream, stations, prepOf, true);
+    bench.replayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return bench;
+}
+
+#endif
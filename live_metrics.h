@@ -0,0 +1,184 @@
+#ifndef LIVE_METRICS_H
+#define LIVE_METRICS_H
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "order_events.h"
+
+struct WindowStats {
+    long long orders;
+    long long items;
+    long long payments;
+    long long revenueCents;
+
+    double ordersPerMinute(int seconds) const { return seconds > 0 ? orders * 60.0 / seconds : 0.0; }
+    double averageBasketItems() const { return orders > 0 ? static_cast<double>(items) / orders : 0.0; }
+    double averageOrderValue() const { return payments > 0 ? revenueCents / 100.0 / payments : 0.0; }
+};
+
+// Sliding-window order / revenue counters over the last 24 hours.
+// One bucket per second in a 24h ring; each window (5 min, 1 h, 24 h) keeps a
+// running total plus the oldest second it still includes. Moving time forward
+// subtracts the buckets that fell out of each window, so both recording and
+// querying cost O(1) amortised, independent of traffic.
+class LiveMetrics {
+public:
+    enum Window { FIVE_MINUTES, ONE_HOUR, ONE_DAY, WINDOW_COUNT };
+
+private:
+    enum { RING_SECONDS = 24 * 3600 };
+
+    struct Bucket {
+        long long second;
+        int32_t orders;
+        int32_t items;
+        int32_t payments;
+        int64_t revenueCents;
+    };
+
+    std::vector<Bucket> ring;
+    WindowStats totals[WINDOW_COUNT];
+    long long tail[WINDOW_COUNT];       // oldest second still counted in each window
+    long long head = 0;                 // latest second the windows have advanced to
+    mutable std::mutex m;
+
+    static int windowSeconds(int w) {
+        static const int seconds[WINDOW_COUNT] = { 5 * 60, 3600, 24 * 3600 };
+        return seconds[w];
+    }
+
+    static void apply(WindowStats& stats, const Bucket& b, int sign) {
+        stats.orders += sign * b.orders;
+        stats.items += sign * b.items;
+        stats.payments += sign * b.payments;
+        stats.revenueCents += sign * b.revenueCents;
+    }
+
+    void advance(long long now) {
+        if (now <= head) return;
+        if (now - head >= RING_SECONDS) {
+            for (Bucket& b : ring) b.second = -1;
+            for (int w = 0; w < WINDOW_COUNT; w++) {
+                totals[w] = WindowStats();
+                tail[w] = now - windowSeconds(w) + 1;
+            }
+            head = now;
+            return;
+        }
+        for (int w = 0; w < WINDOW_COUNT; w++) {
+            long long newTail = now - windowSeconds(w) + 1;
+            for (; tail[w] < newTail; tail[w]++) {
+                const Bucket& b = ring[tail[w] % RING_SECONDS];
+                if (b.second == tail[w]) apply(totals[w], b, -1);
+            }
+        }
+        head = now;
+    }
+
+    Bucket& bucketAt(long long second) {
+        Bucket& b = ring[second % RING_SECONDS];
+        if (b.second != second) {
+            Bucket fresh = { second, 0, 0, 0, 0 };
+            b = fresh;
+        }
+        return b;
+    }
+
+    // Adds a delta at `second` (clamped into the last 24h) to the bucket and
+    // to every window that currently covers it
+    void add(long long second, int orders, int items, int payments, int64_t revenueCents) {
+        long long now = static_cast<long long>(time(nullptr));
+        advance(now);
+        if (second > now) second = now;
+        if (second < tail[ONE_DAY]) return;
+
+        Bucket delta = { second, orders, items, payments, revenueCents };
+        Bucket& b = bucketAt(second);
+        b.orders += orders;
+        b.items += items;
+        b.payments += payments;
+        b.revenueCents += revenueCents;
+        for (int w = 0; w < WINDOW_COUNT; w++) {
+            if (second >= tail[w]) apply(totals[w], delta, +1);
+        }
+    }
+
+public:
+    LiveMetrics() : ring(RING_SECONDS) {
+        for (Bucket& b : ring) b.second = -1;
+        head = static_cast<long long>(time(nullptr));
+        for (int w = 0; w < WINDOW_COUNT; w++) {
+            totals[w] = WindowStats();
+            tail[w] = head - windowSeconds(w) + 1;
+        }
+    }
+
+    void attach(OrderEvents& events) {
+        events.onOrderPlaced([this](const OrderPlacedEvent& e) { recordOrder(e); });
+        events.onPayment([this](const PaymentEvent& e) { recordPayment(e); });
+    }
+
+    // Replays the last 24 hours so the windows are warm after a restart
+    void seed(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> orders(stmt->executeQuery(
+            "SELECT UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, IFNULL(SUM(oi.Quantity), 0) AS items "
+            "FROM orders o LEFT JOIN order_item oi ON oi.OrdersID = o.OrdersID "
+            "WHERE o.OrdersDate >= NOW() - INTERVAL 1 DAY GROUP BY o.OrdersID, o.OrdersDate"));
+        std::lock_guard<std::mutex> lock(m);
+        while (orders->next()) {
+            add(orders->getInt64("placedAt"), 1, orders->getInt("items"), 0, 0);
+        }
+
+        std::unique_ptr<sql::ResultSet> payments(stmt->executeQuery(
+            "SELECT UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, ROUND(p.Amount * 100) AS cents "
+            "FROM payment p JOIN orders o ON o.OrdersID = p.OrdersID "
+            "WHERE o.OrdersDate >= NOW() - INTERVAL 1 DAY"));
+        while (payments->next()) {
+            add(payments->getInt64("placedAt"), 0, 0, 1, payments->getInt64("cents"));
+        }
+    }
+
+    void recordOrder(const OrderPlacedEvent& e) {
+        int items = 0;
+        for (const OrderEventLine& line : e.lines) items += line.quantity;
+        std::lock_guard<std::mutex> lock(m);
+        add(static_cast<long long>(e.placedAt), 1, items, 0, 0);
+    }
+
+    void recordPayment(const PaymentEvent& e) {
+        std::lock_guard<std::mutex> lock(m);
+        add(static_cast<long long>(e.paidAt), 0, 0, 1, static_cast<int64_t>(e.amount * 100 + 0.5));
+    }
+
+    WindowStats window(Window w) {
+        std::lock_guard<std::mutex> lock(m);
+        advance(static_cast<long long>(time(nullptr)));
+        return totals[w];
+    }
+
+    static int seconds(Window w) { return windowSeconds(w); }
+
+    // Orders in each of the last `count` minutes, oldest first (for the sparkline)
+    std::vector<int> ordersPerMinute(int count) {
+        std::lock_guard<std::mutex> lock(m);
+        long long now = static_cast<long long>(time(nullptr));
+        advance(now);
+        std::vector<int> result(count, 0);
+        long long start = (now / 60 - count + 1) * 60;
+        for (long long s = start; s <= now; s++) {
+            if (s < tail[ONE_DAY]) continue;
+            const Bucket& b = ring[s % RING_SECONDS];
+            if (b.second == s) result[(s - start) / 60] += b.orders;
+        }
+        return result;
+    }
+};
+
+#endif
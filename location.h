@@ -0,0 +1,478 @@
+#ifndef LOCATION_H
+#define LOCATION_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "geo.h"
+
+struct LocationPing {
+    double lat;
+    double lng;
+    int64_t atMs;           // Unix time, milliseconds
+};
+
+// Single-producer / single-consumer ring: the rider's ping stream writes,
+// the flusher reads. Head and tail are each written by one side only, so a
+// push or pop is one acquire load and one release store. Full rings reject
+// the newest ping (counted as dropped) rather than block the producer.
+template <typename T, size_t Capacity>
+class SpscRing {
+private:
+    T items[Capacity];
+    std::atomic<size_t> head;       // next slot to read (consumer)
+    char pad[64];
+    std::atomic<size_t> tail;       // next slot to write (producer)
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[t % Capacity] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = items[h % Capacity];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Douglas-Peucker on a track in local metres: keeps the end points and any
+// point further than epsilonMeters from the line through its neighbours
+// that survived. Iterative, so long tracks cannot overflow the stack.
+inline std::vector<size_t> simplifyTrack(const std::vector<LocationPing>& track, double epsilonMeters) {
+    std::vector<size_t> kept;
+    if (track.size() <= 2) {
+        for (size_t i = 0; i < track.size(); i++) kept.push_back(i);
+        return kept;
+    }
+
+    const double metersPerDegree = 111320.0;
+    const double lngScale = std::cos(track[0].lat * 3.14159265358979 / 180.0) * metersPerDegree;
+    auto x = [&](size_t i) { return track[i].lng * lngScale; };
+    auto y = [&](size_t i) { return track[i].lat * metersPerDegree; };
+
+    std::vector<char> keep(track.size(), 0);
+    keep.front() = keep.back() = 1;
+    std::vector<std::pair<size_t, size_t>> stack(1, std::make_pair(size_t(0), track.size() - 1));
+    while (!stack.empty()) {
+        size_t a = stack.back().first, b = stack.back().second;
+        stack.pop_back();
+        if (b <= a + 1) continue;
+
+        double dx = x(b) - x(a), dy = y(b) - y(a);
+        double length2 = dx * dx + dy * dy;
+        double worst = -1.0;
+        size_t worstAt = a;
+        for (size_t i = a + 1; i < b; i++) {
+            double px = x(i) - x(a), py = y(i) - y(a);
+            double d2;
+            if (length2 == 0.0) {
+                d2 = px * px + py * py;
+            }
+            else {
+                double t = std::max(0.0, std::min(1.0, (px * dx + py * dy) / length2));
+                double ex = px - t * dx, ey = py - t * dy;
+                d2 = ex * ex + ey * ey;
+            }
+            if (d2 > worst) {
+                worst = d2;
+                worstAt = i;
+            }
+        }
+        if (worst > epsilonMeters * epsilonMeters) {
+            keep[worstAt] = 1;
+            stack.push_back(std::make_pair(a, worstAt));
+            stack.push_back(std::make_pair(worstAt, b));
+        }
+    }
+    for (size_t i = 0; i < track.size(); i++) {
+        if (keep[i]) kept.push_back(i);
+    }
+    return kept;
+}
+
+struct LocationStats {
+    long long received;
+    long long dropped;           // ring full
+    long long persisted;         // rows written after simplification
+    long long batches;           // INSERT statements
+    size_t riders;
+};
+
+// Rider GPS ingestion. Each rider gets a slot in a fixed open-addressed
+// table (claimed by CAS, never freed) holding an SPSC ring for incoming pings
+// and a seqlock-protected latest position, so ingest() and latest() are O(1)
+// and take no locks. A flusher thread drains the rings every second,
+// simplifies each rider's track with Douglas-Peucker once it spans
+// SEGMENT_SECONDS, and writes the kept points to rider_location in multi-row
+// INSERTs on its own connection. The last kept point starts the next
+// segment, so segments join up.
+class LocationService {
+public:
+    enum { MAX_RIDERS = 1 << 14, RING_PINGS = 256, SEGMENT_SECONDS = 30, INSERT_ROWS = 500 };
+
+private:
+    typedef SpscRing<LocationPing, RING_PINGS> Ring;
+
+    struct Slot {
+        std::atomic<int> riderID;
+        std::atomic<Ring*> ring;                // allocated by whoever claims the slot
+        std::atomic<uint32_t> seq;              // odd while `latest` is being written
+        std::atomic<double> lat, lng;
+        std::atomic<int64_t> atMs;
+        std::vector<LocationPing> segment;      // flusher only
+        bool segmentStartWritten;               // flusher only
+
+        Slot() : riderID(0), ring(nullptr), seq(0), lat(0.0), lng(0.0), atMs(0), segmentStartWritten(false) {}
+        ~Slot() { delete ring.load(); }
+    };
+
+    struct Row {
+        int riderID;
+        LocationPing ping;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<long long> received, dropped, persisted, batches;
+    std::atomic<size_t> riderCount;
+    double epsilonMeters;
+    bool persist;
+    std::atomic<bool> stopping;
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    std::thread flusher;
+
+    static size_t hashOf(int riderID) {
+        return (static_cast<uint32_t>(riderID) * 2654435761u) & (MAX_RIDERS - 1);
+    }
+
+    Slot* find(int riderID) const {
+        for (size_t i = hashOf(riderID), probes = 0; probes < MAX_RIDERS; i = (i + 1) & (MAX_RIDERS - 1), probes++) {
+            int id = slots[i].riderID.load(std::memory_order_acquire);
+            if (id == riderID) return &slots[i];
+            if (id == 0) return nullptr;
+        }
+        return nullptr;
+    }
+
+    Slot* findOrClaim(int riderID) {
+        for (size_t i = hashOf(riderID), probes = 0; probes < MAX_RIDERS; i = (i + 1) & (MAX_RIDERS - 1), probes++) {
+            int id = slots[i].riderID.load(std::memory_order_acquire);
+            if (id == riderID) return &slots[i];
+            if (id == 0) {
+                int empty = 0;
+                if (slots[i].riderID.compare_exchange_strong(empty, riderID)) {
+                    slots[i].ring.store(new Ring(), std::memory_order_release);
+                    riderCount++;
+                    return &slots[i];
+                }
+                if (empty == riderID) return &slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static void ensureSchema(sql::Connection* con) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS rider_location ("
+            "LocationID BIGINT AUTO_INCREMENT PRIMARY KEY, "
+            "DeliveryID INT NOT NULL, "
+            "Lat DOUBLE NOT NULL, Lng DOUBLE NOT NULL, "
+            "RecordedAt DATETIME(3) NOT NULL, "
+            "INDEX idx_rider_location (DeliveryID, RecordedAt))");
+    }
+
+    static std::string insertSql(size_t rows) {
+        std::string sql = "INSERT INTO rider_location (DeliveryID, Lat, Lng, RecordedAt) VALUES ";
+        for (size_t i = 0; i < rows; i++) {
+            if (i > 0) sql += ",";
+            sql += "(?, ?, ?, FROM_UNIXTIME(? / 1000))";
+        }
+        return sql;
+    }
+
+    void write(sql::Connection* con, std::unique_ptr<sql::PreparedStatement>& full, const std::vector<Row>& rows) {
+        for (size_t start = 0; start < rows.size(); start += INSERT_ROWS) {
+            size_t n = std::min<size_t>(INSERT_ROWS, rows.size() - start);
+            std::unique_ptr<sql::PreparedStatement> partial;
+            sql::PreparedStatement* pstmt;
+            if (n == INSERT_ROWS) {
+                if (!full) full.reset(con->prepareStatement(insertSql(INSERT_ROWS)));
+                pstmt = full.get();
+            }
+            else {
+                partial.reset(con->prepareStatement(insertSql(n)));
+                pstmt = partial.get();
+            }
+            for (size_t i = 0; i < n; i++) {
+                const Row& r = rows[start + i];
+                pstmt->setInt(static_cast<unsigned int>(i * 4 + 1), r.riderID);
+                pstmt->setDouble(static_cast<unsigned int>(i * 4 + 2), r.ping.lat);
+                pstmt->setDouble(static_cast<unsigned int>(i * 4 + 3), r.ping.lng);
+                pstmt->setInt64(static_cast<unsigned int>(i * 4 + 4), r.ping.atMs);
+            }
+            pstmt->executeUpdate();
+            batches++;
+        }
+    }
+
+    // Drains every ring; riders whose segment spans SEGMENT_SECONDS (or all
+    // riders, when final) are simplified into `rows` and their slots listed
+    // in `cut`, for written() once the rows are stored
+    void collect(std::vector<Row>& rows, std::vector<size_t>& cut, bool final) {
+        for (size_t i = 0; i < MAX_RIDERS; i++) {
+            Slot& slot = slots[i];
+            int riderID = slot.riderID.load(std::memory_order_acquire);
+            Ring* ring = slot.ring.load(std::memory_order_acquire);
+            if (riderID == 0 || !ring) continue;
+
+            LocationPing ping;
+            while (ring->pop(ping)) slot.segment.push_back(ping);
+            if (slot.segment.size() < 2) continue;
+
+            int64_t span = slot.segment.back().atMs - slot.segment.front().atMs;
+            if (!final && span < SEGMENT_SECONDS * 1000LL) continue;
+
+            // A segment's first point was written as the previous segment's last
+            std::vector<size_t> kept = simplifyTrack(slot.segment, epsilonMeters);
+            for (size_t k = slot.segmentStartWritten ? 1 : 0; k < kept.size(); k++) {
+                Row row = { riderID, slot.segment[kept[k]] };
+                rows.push_back(row);
+            }
+            LocationPing last = slot.segment.back();
+            slot.segment.assign(1, last);
+            cut.push_back(i);
+        }
+    }
+
+    // The carried-over first point of each cut segment is in the table only
+    // if the rows that ended the previous segment were written
+    void written(const std::vector<size_t>& cut, bool ok) {
+        for (size_t i : cut) slots[i].segmentStartWritten = ok;
+    }
+
+    void flushLoop() {
+        sql::Driver* driver = get_driver_instance();
+        if (persist) driver->threadInit();
+        std::unique_ptr<sql::Connection> con;
+        std::unique_ptr<sql::PreparedStatement> full;
+        bool schemaReady = false;
+
+        while (true) {
+            bool last;
+            {
+                std::unique_lock<std::mutex> lock(wakeLock);
+                wake.wait_for(lock, std::chrono::seconds(1), [&] { return stopping.load(); });
+                last = stopping.load();
+            }
+
+            std::vector<Row> rows;
+            std::vector<size_t> cut;
+            collect(rows, cut, last);
+            if (!rows.empty()) {
+                if (persist) {
+                    try {
+                        if (!con || !con->isValid()) {
+                            full.reset();
+                            con.reset(openConnection());
+                        }
+                        if (!schemaReady) {
+                            ensureSchema(con.get());
+                            schemaReady = true;
+                        }
+                        write(con.get(), full, rows);
+                        persisted += static_cast<long long>(rows.size());
+                        written(cut, true);
+                    }
+                    catch (sql::SQLException&) {
+                        full.reset();
+                        con.reset();            // these points are lost; tracks resume next flush
+                        written(cut, false);
+                    }
+                }
+                else {
+                    persisted += static_cast<long long>(rows.size());
+                    written(cut, true);
+                    batches += static_cast<long long>((rows.size() + INSERT_ROWS - 1) / INSERT_ROWS);
+                }
+            }
+            if (last) break;
+        }
+
+        full.reset();
+        con.reset();
+        if (persist) driver->threadEnd();
+    }
+
+public:
+    // persistPings = false keeps everything in memory (load tests)
+    LocationService(double simplifyMeters = 10.0, bool persistPings = true)
+        : slots(new Slot[MAX_RIDERS]), received(0), dropped(0), persisted(0), batches(0), riderCount(0),
+        epsilonMeters(simplifyMeters), persist(persistPings), stopping(false) {}
+
+    ~LocationService() { stop(); }
+
+    LocationService(const LocationService&) = delete;
+    LocationService& operator=(const LocationService&) = delete;
+
+    void start() {
+        if (!flusher.joinable()) flusher = std::thread(&LocationService::flushLoop, this);
+    }
+
+    // Flushes whatever is buffered, then stops
+    void stop() {
+        stopping.store(true);
+        wake.notify_all();
+        if (flusher.joinable()) flusher.join();
+    }
+
+    // One producer per rider at a time (the rider's ping stream)
+    bool ingest(int riderID, const LocationPing& ping) {
+        received++;
+        Slot* slot = riderID > 0 ? findOrClaim(riderID) : nullptr;
+        if (!slot) {
+            dropped++;
+            return false;
+        }
+
+        uint32_t s = slot->seq.load(std::memory_order_relaxed);
+        slot->seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->lat.store(ping.lat, std::memory_order_relaxed);
+        slot->lng.store(ping.lng, std::memory_order_relaxed);
+        slot->atMs.store(ping.atMs, std::memory_order_relaxed);
+        slot->seq.store(s + 2, std::memory_order_release);
+
+        Ring* ring = slot->ring.load(std::memory_order_acquire);
+        if (!ring || !ring->push(ping)) {
+            dropped++;
+            return false;
+        }
+        return true;
+    }
+
+    // Latest ping for a rider, O(1); false if the rider has never reported
+    bool latest(int riderID, LocationPing& out) const {
+        const Slot* slot = find(riderID);
+        if (!slot) return false;
+        while (true) {
+            uint32_t before = slot->seq.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            out.lat = slot->lat.load(std::memory_order_relaxed);
+            out.lng = slot->lng.load(std::memory_order_relaxed);
+            out.atMs = slot->atMs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->seq.load(std::memory_order_relaxed) == before) return out.atMs != 0;
+        }
+    }
+
+    LocationStats stats() const {
+        LocationStats s = { received.load(), dropped.load(), persisted.load(), batches.load(), riderCount.load() };
+        return s;
+    }
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+};
+
+struct LocationLoadResult {
+    int riders;
+    double seconds;
+    long long pings;
+    double pingsPerSecond;
+    long long dropped;
+    long long kept;                 // after Douglas-Peucker
+    long long insertBatches;
+    double latestLookupNs;
+};
+
+// Replays synthetic rider tracks (straight legs with turns and GPS jitter,
+// one ping per rider every `pingMs`) from `producers` threads, each owning
+// a share of the riders, against an in-memory LocationService
+inline LocationLoadResult runLocationLoad(int riders = 5000, int seconds = 5, int pingMs = 100,
+    int producers = 4, double simplifyMeters = 10.0) {
+    LocationService service(simplifyMeters, false);
+    service.start();
+
+    std::atomic<bool> running(true);
+    int64_t startMs = LocationService::nowMs();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            uint64_t state = 0x9e3779b97f4a7c15ULL * (p + 1);
+            auto uniform = [&state]() {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                return static_cast<double>(state >> 11) / 9007199254740992.0;
+            };
+            struct Track { int riderID; double lat, lng, heading; };
+            std::vector<Track> tracks;
+            for (int r = p + 1; r <= riders; r += producers) {
+                Track t = { r, KITCHEN_LAT + (uniform() - 0.5) * 0.1, KITCHEN_LNG + (uniform() - 0.5) * 0.1, uniform() * 6.283 };
+                tracks.push_back(t);
+            }
+
+            // Paced to the wall clock: tick n is sent at start + n * pingMs, so the
+            // offered load is riders * 1000 / pingMs pings/s (50k/s at the defaults)
+            for (int64_t tick = 0; running.load(); tick++) {
+                int64_t simMs = startMs + tick * pingMs;
+                for (Track& t : tracks) {
+                    if (uniform() < 0.05) t.heading += (uniform() < 0.5 ? -1.5708 : 1.5708);   // turn at a junction
+                    double step = 8.0 * pingMs / 1000.0 / 111320.0;                            // ~8 m/s
+                    t.lat += std::sin(t.heading) * step;
+                    t.lng += std::cos(t.heading) * step;
+                    LocationPing ping = { t.lat + (uniform() - 0.5) * 2e-5, t.lng + (uniform() - 0.5) * 2e-5, simMs };
+                    service.ingest(t.riderID, ping);
+                }
+                int64_t due = startMs + (tick + 1) * pingMs;
+                while (running.load() && LocationService::nowMs() < due) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running.store(false);
+    for (std::thread& t : threads) t.join();
+    double elapsed = (LocationService::nowMs() - startMs) / 1000.0;
+
+    LocationPing ping;
+    auto begin = std::chrono::steady_clock::now();
+    const int lookups = 1000000;
+    int found = 0;
+    for (int i = 0; i < lookups; i++) found += service.latest(i % riders + 1, ping) ? 1 : 0;
+    double lookupNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / lookups;
+
+    service.stop();
+    LocationStats s = service.stats();
+    LocationLoadResult result = { riders, elapsed, s.received, elapsed > 0 ? s.received / elapsed : 0.0,
+        s.dropped, s.persisted, s.batches, found > 0 ? lookupNs : 0.0 };
+    return result;
+}
+
+#endif
@@ -1,782 +1,1653 @@
-// Disable specific MSVC warnings at the top
-#ifdef _MSC_VER
-#pragma warning(disable: 4996)  // localtime
-#pragma warning(disable: 4267)  // size_t conversion
-#pragma warning(disable: 4101)  // unreferenced variable
-#endif
-
-#include <iostream>
-#include <string>
-#include <limits>
-#include <iomanip>
-#include <vector>
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-#include "customer.h"
-#include "menu.h"
-#include "order.h"
-#include "payment.h"
-#include "delivery.h"
-#include "owner.h"
-#include "receipt.h"
-#include "analytics.h"
-
-using namespace std;
-
-#define RESET   "\033[0m"
-#define BOLD    "\033[1m"
-#define CYAN    "\033[36m"
-#define GREEN   "\033[32m"
-#define YELLOW  "\033[33m"
-#define MAGENTA "\033[35m"
-
-void clearScreen() {
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
-}
-
-void pause() {
-    cout << "\n" << YELLOW << "Press Enter to continue..." << RESET;
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    cin.get();
-}
-
-void printCentered(string text, int width = 80) {
-    int textLen = static_cast<int>(text.length());
-    int padding = (width - textLen) / 2;
-    if (padding > 0) {
-        cout << string(padding, ' ') << text << endl;
-    }
-    else {
-        cout << text << endl;
-    }
-}
-
-// FORWARD DECLARATIONS - CRITICAL!
-void customerMenu(Customer& customer, Menu& menu, Order& order, Payment& payment, Receipt& receipt, int customerID);
-void riderMenu(Delivery& delivery, int riderID);
-void ownerMenu(Owner& owner, Menu& menu, Analytics& analytics, Receipt& receipt);
-
-int main() {
-    sql::Driver* driver;
-    std::unique_ptr<sql::Connection> con;
-
-    try {
-        driver = get_driver_instance();
-        con.reset(driver->connect("tcp://127.0.0.1:3306", "root", ""));
-        con->setSchema("fooddelivery");
-        cout << GREEN << "? Connected to database successfully!" << RESET << endl;
-    }
-    catch (sql::SQLException& e) {
-        cout << "Connection failed!" << endl;
-        cout << "# ERR: " << e.what() << endl;
-        system("pause");
-        return 1;
-    }
-
-    // Create objects
-    Customer customer(con.get());
-    Menu menu(con.get());
-    Order order(con.get());
-    Payment payment(con.get());
-    Delivery delivery(con.get());
-    Owner owner(con.get());
-    Receipt receipt(con.get());
-    Analytics analytics(con.get());
-
-    int choice;
-
-    while (true) {
-        clearScreen();
-
-        cout << "\n";
-        cout << BOLD << CYAN;
-        cout << " |~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|\n";
-        cout << " |                                                                                                                     |\n";
-        cout << " |                                          FOODIE EXPRESS DELIVERY SYSTEM                                             |\n";
-        cout << " |                                             Your Food, Our Priority!                                                |\n";
-        cout << " |                                                                                                                     |\n";
-        cout << " |~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|\n";
-        cout << RESET;
-
-        cout << "\n" << YELLOW;
-        printCentered("      ============================================================================================================");
-        cout << RESET;
-
-        cout << "\n";
-        cout << "                                                " << GREEN << " 1. Customer Login" << RESET << endl;
-        cout << "                                                " << GREEN << " 2. Customer Registration\n" << RESET << endl;
-        cout << "                                                " << CYAN << " 3. Rider Login\n" << RESET << endl;
-        cout << "                                                " << MAGENTA << " 4. Owner Login\n" << RESET << endl;
-        cout << "                                                " << YELLOW << " 5. View Menu (Guest)\n" << RESET << endl;
-        cout << "                                                 " << RED << "0. Exit System" << endl;
-
-        cout << "\n" << YELLOW;
-        printCentered("      ============================================================================================================");
-        cout << RESET;
-
-        cout << "\n          " << BOLD << "Enter your choice ? " << RESET;
-        cin >> choice;
-
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Invalid input! Please enter a number." << endl;
-            pause();
-            continue;
-        }
-
-        switch (choice) {
-        case 1: {
-            string phone, password;
-            cout << "\n" << BOLD << CYAN << "=== CUSTOMER LOGIN ===" << RESET << endl;
-            cout << " Phone Number: ";
-            cin >> phone;
-            cout << " Password: ";
-            cin >> password;
-
-            int customerID = customer.loginCustomer(phone, password);
-            if (customerID != -1) {
-                pause();
-                customerMenu(customer, menu, order, payment, receipt, customerID);
-            }
-            else {
-                pause();
-            }
-            break;
-        }
-
-        case 2: {
-            string name, phone, password, address;
-            cout << "\n" << BOLD << GREEN << "=====CUSTOMER REGISTRATION =====" << RESET << endl;
-            cin.ignore();
-            cout << "  Name: ";
-            getline(cin, name);
-            cout << "  Phone Number: ";
-            getline(cin, phone);
-            cout << "  Password: ";
-            getline(cin, password);
-            cout << "  Address: ";
-            getline(cin, address);
-
-            customer.registerCustomer(name, phone, password, address);
-            pause();
-            break;
-        }
-
-        case 3: {
-            string phone, password;
-            cout << "\n" << BOLD << CYAN << "==== RIDER LOGIN ====" << RESET << endl;
-            cout << " Phone Number: ";
-            cin >> phone;
-            cout << " Password: ";
-            cin >> password;
-
-            int riderID = delivery.loginRider(phone, password);
-            if (riderID != -1) {
-                pause();
-                riderMenu(delivery, riderID);
-            }
-            else {
-                pause();
-            }
-            break;
-        }
-
-        case 4: {
-            string username, password;
-            cout << "\n" << BOLD << MAGENTA << "==== OWNER LOGIN =====" << RESET << endl;
-            cout << " Username: ";
-            cin >> username;
-            cout << " Password: ";
-            cin >> password;
-
-            if (owner.loginOwner(username, password)) {
-                pause();
-                ownerMenu(owner, menu, analytics, receipt);
-            }
-            else {
-                pause();
-            }
-            break;
-        }
-
-        case 5: {
-            menu.displayMenu();
-            pause();
-            break;
-        }
-
-        case 0: {
-            cout << "\n" << GREEN;
-            printCentered("+++++++++++++++++++++++++++++++++++++++++");
-            printCentered("+  Thank you for using Foodie Express!  +");
-            printCentered("+      Have a delicious day!            +");
-            printCentered("+++++++++++++++++++++++++++++++++++++++++");
-            cout << RESET << "\n";
-            con->close();
-            return 0;
-        }
-
-        default: {
-            cout << "Invalid choice! Please try again." << endl;
-            pause();
-        }
-        }
-    }
-
-    return 0;
-}
-
-void customerMenu(Customer& customer, Menu& menu, Order& order, Payment& payment, Receipt& receipt, int customerID) {
-    int choice;
-    while (true) {
-        clearScreen();
-        cout << BOLD << GREEN;
-        cout << "  *****************************************************************\n";
-        cout << "  *                       CUSTOMER PORTAL                         *\n";
-        cout << "  *****************************************************************\n";
-        cout << RESET;
-
-        cout << "\n    MENU OPTIONS:\n";
-        cout << " 1. View Menu\n";
-        cout << " 2. Search Menu\n";
-        cout << " 3. Manage Cart (Add/Delete/Clear)\n";
-        cout << " 4. View Cart\n";
-        cout << " 5. Place Order & Checkout\n";
-        cout << " 6. View Order History\n";
-        cout << " 7. View Profile\n";
-        cout << " 8. Update Address\n";
-        cout << " 0. Logout\n";
-        cout << "\nEnter choice: ";
-        cin >> choice;
-
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Invalid input!" << endl;
-            pause();
-            continue;
-        }
-
-        switch (choice) {
-        case 1: {
-            menu.displayMenu();
-            pause();
-            break;
-        }
-
-        case 2: {
-            string keyword;
-            cout << "Enter search keyword: ";
-            cin.ignore();
-            getline(cin, keyword);
-            menu.searchMenu(keyword);
-            pause();
-            break;
-        }
-
-        case 3: {
-            int cartChoice;
-            do {
-                clearScreen();
-                cout << BOLD << CYAN << "============================ AVAILABLE MENU ===============================" << RESET << endl;
-                menu.displayMenu();
-
-                cout << "\n" << BOLD << YELLOW << "+-+-+-+-+-+-+- YOUR CART +-+-+-+-+-+-+-+-+-" << RESET << endl;
-                order.viewCart();
-
-                cout << "  \n" << BOLD << "Actions:" << RESET << endl;
-                cout << "       "<<"1.Add Item to Cart" << endl;
-                cout << "       "<<"2.Delete Specific Item" << endl;
-                cout << "       "<<"3.Clear Entire Cart" << endl;
-                cout << "       "<<"0.Back to Menu" << endl;
-                cout << "       "<<"Choice: ";
-                cin >> cartChoice;
-
-                if (cartChoice == 1) {
-                    int menuID, qty;
-                    cout << "\nEnter Menu ID (0 to cancel): ";
-                    cin >> menuID;
-                    if (menuID != 0) {
-                        cout << "Enter Quantity: ";
-                        cin >> qty;
-
-                        double price = menu.getMenuPrice(menuID);
-                        string name = menu.getMenuName(menuID);
-
-                        if (price > 0) {
-                            order.addToCart(menuID, qty, price, name);
-                        }
-                        else {
-                            cout << "Invalid Menu ID!" << endl;
-                        }
-                        pause();
-                    }
-                }
-                else if (cartChoice == 2) {
-                    if (!order.isCartEmpty()) {
-                        int idToDel;
-                        cout << "\nEnter Menu ID to remove: ";
-                        cin >> idToDel;
-                        order.deleteCartItem(idToDel);
-                    }
-                    pause();
-                }
-                else if (cartChoice == 3) {
-                    order.clearCart();
-                    pause();
-                }
-
-            } while (cartChoice != 0);
-            break;
-        }
-
-        case 4: {
-            order.viewCart();
-            pause();
-            break;
-        }
-
-              // FIXED CUSTOMER MENU - Place Order Section (Case 5)
-             // Replace case 5 in your customerMenu() function with this:
-
-        case 5: {
-            if (order.getCartSize() == 0) {
-                cout << RED << "Cart is empty! Add items first." << RESET << endl;
-                pause();
-                break;
-            }
-
-            // Show cart
-            order.viewCart();
-
-            // Ask for delivery address confirmation/update
-            cout << "\n" << YELLOW << "??? DELIVERY INFORMATION ???" << RESET << endl;
-            customer.viewProfile(customerID);
-
-            cout << "\n" << BOLD << "Is this delivery address correct? (y/n): " << RESET;
-            char addressConfirm;
-            cin >> addressConfirm;
-
-            if (addressConfirm == 'n' || addressConfirm == 'N') {
-                string newAddress;
-                cout << "\n" << YELLOW << "Enter new delivery address: " << RESET;
-                cin.ignore();
-                getline(cin, newAddress);
-
-                if (customer.updateAddress(customerID, newAddress)) {
-                    cout << GREEN << "? Delivery address updated!" << RESET << endl;
-                }
-            }
-
-            // Confirm order
-            cout << "\n" << BOLD << YELLOW << "Confirm order? (y/n): " << RESET;
-            char confirm;
-            cin >> confirm;
-
-            if (confirm == 'y' || confirm == 'Y') {
-                int orderID = order.createOrder(customerID);
-                if (orderID != -1) {
-                    payment.displayPaymentMethods();
-                    int paymentChoice;
-                    cout << "Select payment method (1-4): ";
-                    cin >> paymentChoice;
-
-                    string paymentMethod;
-                    switch (paymentChoice) {
-                    case 1: paymentMethod = "Cash"; break;
-                    case 2: paymentMethod = "Online Banking"; break;
-                    case 3: paymentMethod = "Credit Card"; break;
-                    case 4: paymentMethod = "E-Wallet"; break;
-                    default: paymentMethod = "Cash";
-                    }
-
-                    double total = order.getCartTotal();
-                    if (payment.createPayment(orderID, paymentMethod, total)) {
-                        // Generate receipt (will clear screen and show in new page)
-                        receipt.generateReceipt(orderID, customerID, paymentMethod, total);
-                        order.clearCart();
-                    }
-                }
-            }
-            else {
-                cout << "\n" << YELLOW << "Order cancelled. You can:" << RESET << endl;
-                cout << "- Modify your cart (option 3)" << endl;
-                cout << "- Update delivery address (option 8)" << endl;
-                cout << "- Try placing order again (option 5)" << endl;
-                pause();
-            }
-            break;
-        }
-
-        case 6: {
-            order.viewOrderHistory(customerID);
-            pause();
-            break;
-        }
-
-        case 7: {
-            customer.viewProfile(customerID);
-            pause();
-            break;
-        }
-
-        case 8: {
-            string newAddress;
-            cout << "Enter new address: ";
-            cin.ignore();
-            getline(cin, newAddress);
-            customer.updateAddress(customerID, newAddress);
-            pause();
-            break;
-        }
-
-        case 0: {
-            cout << "Logging out..." << endl;
-            return;
-        }
-
-        default: {
-            cout << "Invalid choice!" << endl;
-            pause();
-        }
-        }
-    }
-}
-
-void riderMenu(Delivery& delivery, int riderID) {
-    int choice;
-
-    while (true) {
-        clearScreen();
-        cout << BOLD << CYAN;
-        cout << "  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+\n";
-        cout << "  |                    RIDER DASHBOARD                            |\n";
-        cout << "  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+\n";
-        cout << RESET;
-
-        cout << "\n1. View Available Orders\n";
-        cout << "2. Accept Order\n";
-        cout << "3. View My Deliveries\n";
-        cout << "4. Update Delivery Status\n";
-        cout << "5.  Complete Order\n";
-        cout << "6. View History\n";
-        cout << "0. Logout\n";
-        cout << "\nEnter choice: ";
-        cin >> choice;
-
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            pause();
-            continue;
-        }
-
-        switch (choice) {
-        case 1: {
-            delivery.viewAvailableOrders();
-            pause();
-            break;
-        }
-
-        case 2: {
-            delivery.viewAvailableOrders();
-            int orderID;
-            cout << "\nEnter Order ID (0 to cancel): ";
-            cin >> orderID;
-            if (orderID != 0) {
-                delivery.acceptOrder(orderID, riderID);
-            }
-            pause();
-            break;
-        }
-
-        case 3: {
-            delivery.viewMyDeliveries(riderID);
-            pause();
-            break;
-        }
-
-        case 4: {
-            int activeOrders = delivery.viewMyDeliveries(riderID);
-            if (activeOrders > 0) {
-                int orderID;
-                cout << "\nEnter Order ID: ";
-                cin >> orderID;
-
-                cout << "\nSelect Status:\n";
-                cout << "1. Preparing\n";
-                cout << "2. Out for Delivery\n";
-                cout << "3. Arrived\n";
-                cout << "Choice: ";
-
-                int statusChoice;
-                cin >> statusChoice;
-
-                string status = (statusChoice == 1) ? "Preparing" :
-                    (statusChoice == 3) ? "Arrived" : "Out for Delivery";
-
-                delivery.updateDeliveryStatus(orderID, status);
-            }
-            pause();
-            break;
-        }
-
-        case 5: {
-            int activeOrders = delivery.viewMyDeliveries(riderID);
-            if (activeOrders > 0) {
-                int orderID;
-                cout << "\nEnter Order ID to complete: ";
-                cin >> orderID;
-                delivery.completeDelivery(orderID);
-            }
-            pause();
-            break;
-        }
-
-        case 6: {
-            delivery.viewDeliveryHistory(riderID);
-            pause();
-            break;
-        }
-
-        case 0: {
-            return;
-        }
-
-        default: {
-            pause();
-        }
-        }
-    }
-}
-
-// GANTI MENU DISPLAY dalam ownerMenu() dengan ni:
-
-void ownerMenu(Owner& owner, Menu& menu, Analytics& analytics, Receipt& receipt) {
-    int choice;
-
-    while (true) {
-        clearScreen();
-        cout << BOLD << MAGENTA;
-        cout << "   -_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-\n";
-        cout << "  ||                     OWNER DASHBOARD                         ||\n";
-        cout << "   -_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-\n";
-        cout << RESET;
-
-        cout << "\n" << CYAN << "==== MENU MANAGEMENT ===" << RESET << endl;
-        cout << "1. View All Menu Items\n";
-        cout << "2. Add Menu Item\n";
-        cout << "3. Update Menu Item\n";
-        cout << "4. Delete Menu Item\n";
-
-        cout << "\n" << GREEN << "=====STOCK MANAGEMENT ===" << RESET << endl;
-        cout << "5. Update Stock\n";
-        cout << "6. View Low Stock Alert\n";
-
-        cout << "\n" << YELLOW << "===== ANALYTICS & REPORTS ===" << RESET << endl;
-        cout << "7.  Category Sales Table\n";
-        cout << "8.  Sales Summary Report\n";
-        cout << "9.  Peak Hours Bar Chart\n";
-        cout << "10.  Top Selling Items Table\n";
-
-        cout << "\n" << BLUE << "===== RECEIPT MANAGEMENT ===" << RESET << endl;
-        cout << "11.  Search Receipts by Customer\n";
-        cout << "12.  View All Receipts History\n";
-        cout << "13.  View Specific Receipt Details\n";
-
-        cout << "\n" << MAGENTA << "===== OTHER MANAGEMENT ===" << RESET << endl;
-        cout << "14. View All Orders\n";
-        cout << "15. View All Customers\n";
-        cout << "16. View All Riders\n";
-
-        cout << "\n0. Logout\n";
-        cout << "\nEnter choice: ";
-        cin >> choice;
-
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            pause();
-            continue;
-        }
-
-        switch (choice) {
-        case 1: {
-            owner.viewAllMenuItems();
-            pause();
-            break;
-        }
-
-        case 2: {
-            string name, description;
-            double price;
-            int categoryID, stock;
-
-            owner.viewAllCategories();
-            cout << "\n=== ADD MENU ===" << endl;
-            cin.ignore();
-            cout << "Name: "; getline(cin, name);
-            cout << "Price: RM"; cin >> price;
-            cout << "Stock: "; cin >> stock;
-            cin.ignore();
-            cout << "Description: "; getline(cin, description);
-            cout << "Category ID: "; cin >> categoryID;
-
-            owner.addMenuItem(name, price, description, categoryID, stock);
-            pause();
-            break;
-        }
-
-        case 3: {
-            int menuID, categoryID, stock;
-            string name, description;
-            double price;
-
-            owner.viewAllMenuItems();
-            cout << "\nEnter Menu ID: "; cin >> menuID;
-            cin.ignore();
-            cout << "Name: "; getline(cin, name);
-            cout << "Price: RM"; cin >> price;
-            cout << "Stock: "; cin >> stock;
-            cin.ignore();
-            cout << "Description: "; getline(cin, description);
-            owner.viewAllCategories();
-            cout << "Category ID: "; cin >> categoryID;
-
-            owner.updateMenuItem(menuID, name, price, description, categoryID, stock);
-            pause();
-            break;
-        }
-
-        case 4: {
-            int menuID;
-            owner.viewAllMenuItems();
-            cout << "\nEnter Menu ID: "; cin >> menuID;
-            char confirm;
-            cout << "Are you sure? (y/n): "; cin >> confirm;
-            if (confirm == 'y' || confirm == 'Y') {
-                owner.deleteMenuItem(menuID);
-            }
-            pause();
-            break;
-        }
-
-        case 5: {
-            int menuID, stock;
-            owner.viewAllMenuItems();
-            cout << "\nEnter Menu ID: "; cin >> menuID;
-            cout << "New Stock: "; cin >> stock;
-            owner.updateStock(menuID, stock);
-            pause();
-            break;
-        }
-
-        case 6: {
-            owner.viewLowStockItems();
-            pause();
-            break;
-        }
-
-        case 7: {
-            analytics.showCategoryPerformance();
-            pause();
-            break;
-        }
-
-        case 8: {
-            analytics.showSalesSummary();
-            pause();
-            break;
-        }
-
-        case 9: {
-            analytics.showPeakHoursBarChart();
-            pause();
-            break;
-        }
-
-        case 10: {
-            analytics.showTopSellingTable();
-            pause();
-            break;
-        }
-
-        case 11: {
-            // ? SEARCH BY CUSTOMER NAME
-            string customerName;
-            cout << "\n" << BOLD << CYAN << "=== SEARCH RECEIPTS BY CUSTOMER ===" << RESET << endl;
-            cout << "Enter customer name: ";
-            cin.ignore();
-            getline(cin, customerName);
-
-            if (!customerName.empty()) {
-                receipt.searchReceiptsByCustomer(customerName);
-            }
-            else {
-                cout << RED << "Customer name cannot be empty!" << RESET << endl;
-            }
-            pause();
-            break;
-        }
-
-        case 12: {
-            receipt.viewAllReceipts();
-            pause();
-            break;
-        }
-
-        case 13: {
-            // ? SHOW ALL RECEIPTS FIRST, THEN LET OWNER CHOOSE
-            receipt.viewAllReceipts();  // Tunjuk list dulu
-
-            int receiptID;
-            cout << "\n" << YELLOW << "Enter Receipt ID to view details (0 to cancel): " << RESET;
-            cin >> receiptID;
-
-            if (receiptID != 0) {
-                receipt.viewReceiptDetails(receiptID);
-            }
-            else {
-                cout << GREEN << "Cancelled." << RESET << endl;
-            }
-            pause();
-            break;
-        }
-
-        case 14: {
-            owner.viewAllOrders();
-            pause();
-            break;
-        }
-
-        case 15: {
-            owner.viewAllCustomers();
-            pause();
-            break;
-        }
-
-        case 16: {
-            owner.viewAllRiders();
-            pause();
-            break;
-        }
-
-        case 0: {
-            return;
-        }
-
-        default: {
-            pause();
-        }
-        }
-    }
+// Disable specific MSVC warnings at the top
+#ifdef _MSC_VER
+#pragma warning(disable: 4996)  // localtime
+#pragma warning(disable: 4267)  // size_t conversion
+#pragma warning(disable: 4101)  // unreferenced variable
+#endif
+
+#include <iostream>
+#include <string>
+#include <limits>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include "customer.h"
+#include "menu.h"
+#include "order.h"
+#include "payment.h"
+#include "delivery.h"
+#include "owner.h"
+#include "receipt.h"
+#include "analytics.h"
+#include "order_events.h"
+#include "top_sellers.h"
+#include "live_metrics.h"
+#include "reach_tracker.h"
+#include "report_scheduler.h"
+#include "query_router.h"
+#include "partition_manager.h"
+#include "dispatch.h"
+#include "route_planner.h"
+#include "open_orders_board.h"
+#include "claim_queue.h"
+#include "eta.h"
+#include "location.h"
+#include "delivery_zone.h"
+#include "kitchen.h"
+#include "database.h"
+
+using namespace std;
+
+#define RESET   "\033[0m"
+#define BOLD    "\033[1m"
+#define CYAN    "\033[36m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define MAGENTA "\033[35m"
+
+void clearScreen() {
+#ifdef _WIN32
+    system("cls");
+#else
+    system("clear");
+#endif
+}
+
+void pause() {
+    cout << "\n" << YELLOW << "Press Enter to continue..." << RESET;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cin.get();
+}
+
+void printCentered(string text, int width = 80) {
+    int textLen = static_cast<int>(text.length());
+    int padding = (width - textLen) / 2;
+    if (padding > 0) {
+        cout << string(padding, ' ') << text << endl;
+    }
+    else {
+        cout << text << endl;
+    }
+}
+
+// FORWARD DECLARATIONS - CRITICAL!
+void customerMenu(Customer& customer, Menu& menu, Order& order, Payment& payment, Receipt& receipt, int customerID);
+void riderMenu(Delivery& delivery, DispatchEngine& dispatcher, sql::Connection* con, int riderID);
+void ownerMenu(Owner& owner, Menu& menu, Analytics& analytics, Receipt& receipt, PartitionManager& partitions,
+    DispatchEngine& dispatcher, EtaModel& eta, LocationService& locations,
+    DeliveryFeeEngine& fees, KitchenService& kitchen, sql::Connection* con);
+
+// Load benchmarks that build large synthetic histories run from the command
+// line, never from the owner menu:
+//   workshop1_utem --bench rollup [maxItemRows]    (needs DB_SCRATCH_SCHEMA)
+//   workshop1_utem --bench cohorts [orders]        (in memory, 5M by default)
+int runBenchmark(const string& name, long long size);
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && string(argv[1]) == "--bench") return runBenchmark(argv[2], argc > 3 ? atoll(argv[3]) : 0);
+
+    sql::Driver* driver;
+    std::unique_ptr<sql::Connection> con;
+
+    try {
+        driver = get_driver_instance();
+        con.reset(driver->connect(DB_HOST, DB_USER, DB_PASSWORD));
+        con->setSchema(DB_SCHEMA);
+        cout << GREEN << "? Connected to database successfully!" << RESET << endl;
+    }
+    catch (sql::SQLException& e) {
+        cout << "Connection failed!" << endl;
+        cout << "# ERR: " << e.what() << endl;
+        system("pause");
+        return 1;
+    }
+
+    // Create objects
+    Customer customer(con.get());
+    Menu menu(con.get());
+    Order order(con.get());
+    Payment payment(con.get());
+    Delivery delivery(con.get());
+    Owner owner(con.get());
+    Receipt receipt(con.get());
+    Analytics analytics(con.get());
+
+    // Checkout events feed the in-memory trackers
+    OrderEvents events;
+    order.setEventBus(&events);
+    payment.setEventBus(&events);
+
+    TopSellerTracker topSellers;
+    try {
+        topSellers.seed(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Top seller tracker seed failed: " << e.what() << endl;
+    }
+    topSellers.attach(events);
+    analytics.setTopSellerTracker(&topSellers);
+
+    LiveMetrics liveMetrics;
+    try {
+        liveMetrics.seed(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Live metrics seed failed: " << e.what() << endl;
+    }
+    liveMetrics.attach(events);
+    analytics.setLiveMetrics(&liveMetrics);
+
+    ReachTracker reach(con.get());
+    try {
+        reach.load();
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Reach sketch load failed: " << e.what() << endl;
+    }
+    reach.attach(events);
+    analytics.setReachTracker(&reach);
+
+    // Riders browse open orders from memory; claims and new orders keep it current
+    OpenOrdersBoard openOrders;
+    try {
+        openOrders.seed(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Open orders board seed failed: " << e.what() << endl;
+    }
+    openOrders.attach(events);
+    delivery.setEventBus(&events);
+    delivery.setOpenOrdersBoard(&openOrders);
+
+    // Delivery ETAs learned from past deliveries, kept current by status events
+    EtaModel eta;
+    try {
+        eta.load(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "ETA model load failed: " << e.what() << endl;
+    }
+    eta.attach(events, con.get());
+    receipt.setEtaModel(&eta);
+    order.setEtaModel(&eta);
+
+    // Owner reports run on their own read connections, at most 4 at a time
+    ReportScheduler reportScheduler(4);
+    analytics.setReportScheduler(&reportScheduler);
+
+    // Owner listings and reports read from the replica while it is < 5 s behind
+    QueryRouter router(con.get(), 5);
+    analytics.setQueryRouter(&router);
+    owner.setQueryRouter(&router);
+    receipt.setQueryRouter(&router);
+
+    // Monthly housekeeping: keep receipt_history to the last few months
+    receipt.runMonthlyArchival();
+
+    // Partitioned history tables always have the next few months ready
+    PartitionManager partitions(con.get());
+    try {
+        partitions.maintain(3);
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Partition maintenance failed: " << e.what() << endl;
+    }
+
+    // Kitchen tickets per station, ranked by when each rider will arrive
+    KitchenService kitchen;
+    try {
+        kitchen.load(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Kitchen load failed: " << e.what() << endl;
+    }
+    kitchen.attach(events);
+
+    // Open orders are matched to online riders in batches every 3 seconds,
+    // once the kitchen expects the food ready by the time a rider gets there
+    DispatchEngine dispatcher(3);
+    delivery.setDispatcher(&dispatcher);
+    dispatcher.setEventBus(&events);
+    dispatcher.setReadyGate([&kitchen](int orderID) { return kitchen.readyAt(orderID); }, kitchen.riderLead());
+    dispatcher.start();
+
+    // Riders grabbing the next order claim from per-zone in-memory queues;
+    // the database update follows on the claim writer thread
+    ClaimService claims;
+    claims.setEventBus(&events);
+    claims.setConfirmedCallback([&dispatcher](int orderID, int riderID) { dispatcher.orderClaimed(orderID, riderID); });
+    try {
+        claims.seed(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Claim queue seed failed: " << e.what() << endl;
+    }
+    claims.attach(events, con.get());
+    claims.start();
+    delivery.setClaimService(&claims);
+
+    // Rider GPS pings are buffered per rider and written to rider_location
+    // as simplified tracks once a second
+    LocationService locations;
+    locations.start();
+    delivery.setLocationService(&locations);
+    order.setLocationService(&locations);
+
+    // Delivery fees by zone polygon, distance band and peak-hour surge;
+    // zone and surge edits are picked up within a few seconds
+    DeliveryFeeEngine fees;
+    try {
+        fees.reload(con.get());
+    }
+    catch (sql::SQLException& e) {
+        cerr << "Delivery zones load failed: " << e.what() << endl;
+    }
+    fees.start();
+    receipt.setDeliveryFees(&fees);
+
+    int choice;
+
+    while (true) {
+        clearScreen();
+
+        cout << "\n";
+        cout << BOLD << CYAN;
+        cout << " |~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|\n";
+        cout << " |                                                                                                                     |\n";
+        cout << " |                                          FOODIE EXPRESS DELIVERY SYSTEM                                             |\n";
+        cout << " |                                             Your Food, Our Priority!                                                |\n";
+        cout << " |                                                                                                                     |\n";
+        cout << " |~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~|\n";
+        cout << RESET;
+
+        cout << "\n" << YELLOW;
+        printCentered("      ============================================================================================================");
+        cout << RESET;
+
+        cout << "\n";
+        cout << "                                                " << GREEN << " 1. Customer Login" << RESET << endl;
+        cout << "                                                " << GREEN << " 2. Customer Registration\n" << RESET << endl;
+        cout << "                                                " << CYAN << " 3. Rider Login\n" << RESET << endl;
+        cout << "                                                " << MAGENTA << " 4. Owner Login\n" << RESET << endl;
+        cout << "                                                " << YELLOW << " 5. View Menu (Guest)\n" << RESET << endl;
+        cout << "                                                 " << RED << "0. Exit System" << endl;
+
+        cout << "\n" << YELLOW;
+        printCentered("      ============================================================================================================");
+        cout << RESET;
+
+        cout << "\n          " << BOLD << "Enter your choice ? " << RESET;
+        cin >> choice;
+
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Invalid input! Please enter a number." << endl;
+            pause();
+            continue;
+        }
+
+        switch (choice) {
+        case 1: {
+            string phone, password;
+            cout << "\n" << BOLD << CYAN << "=== CUSTOMER LOGIN ===" << RESET << endl;
+            cout << " Phone Number: ";
+            cin >> phone;
+            cout << " Password: ";
+            cin >> password;
+
+            int customerID = customer.loginCustomer(phone, password);
+            if (customerID != -1) {
+                pause();
+                customerMenu(customer, menu, order, payment, receipt, customerID);
+            }
+            else {
+                pause();
+            }
+            break;
+        }
+
+        case 2: {
+            string name, phone, password, address;
+            cout << "\n" << BOLD << GREEN << "=====CUSTOMER REGISTRATION =====" << RESET << endl;
+            cin.ignore();
+            cout << "  Name: ";
+            getline(cin, name);
+            cout << "  Phone Number: ";
+            getline(cin, phone);
+            cout << "  Password: ";
+            getline(cin, password);
+            cout << "  Address: ";
+            getline(cin, address);
+
+            customer.registerCustomer(name, phone, password, address);
+            pause();
+            break;
+        }
+
+        case 3: {
+            string phone, password;
+            cout << "\n" << BOLD << CYAN << "==== RIDER LOGIN ====" << RESET << endl;
+            cout << " Phone Number: ";
+            cin >> phone;
+            cout << " Password: ";
+            cin >> password;
+
+            int riderID = delivery.loginRider(phone, password);
+            if (riderID != -1) {
+                pause();
+                riderMenu(delivery, dispatcher, con.get(), riderID);
+            }
+            else {
+                pause();
+            }
+            break;
+        }
+
+        case 4: {
+            string username, password;
+            cout << "\n" << BOLD << MAGENTA << "==== OWNER LOGIN =====" << RESET << endl;
+            cout << " Username: ";
+            cin >> username;
+            cout << " Password: ";
+            cin >> password;
+
+            if (owner.loginOwner(username, password)) {
+                pause();
+                ownerMenu(owner, menu, analytics, receipt, partitions, dispatcher, eta, locations, fees, kitchen, con.get());
+            }
+            else {
+                pause();
+            }
+            break;
+        }
+
+        case 5: {
+            menu.displayMenu();
+            pause();
+            break;
+        }
+
+        case 0: {
+            cout << "\n" << GREEN;
+            printCentered("+++++++++++++++++++++++++++++++++++++++++");
+            printCentered("+  Thank you for using Foodie Express!  +");
+            printCentered("+      Have a delicious day!            +");
+            printCentered("+++++++++++++++++++++++++++++++++++++++++");
+            cout << RESET << "\n";
+            con->close();
+            return 0;
+        }
+
+        default: {
+            cout << "Invalid choice! Please try again." << endl;
+            pause();
+        }
+        }
+    }
+
+    return 0;
+}
+
+int runBenchmark(const string& name, long long size) {
+    Analytics analytics(nullptr);       // benchmarks open their own connections
+    if (name == "rollup") {
+        analytics.benchmarkRollupScaling(size > 0 ? max(10000LL, min(10000000LL, size)) : 10000000LL);
+        return 0;
+    }
+    if (name == "cohorts") {
+        if (size > 0) analytics.benchmarkCohorts(static_cast<size_t>(size));
+        else analytics.benchmarkCohorts();
+        return 0;
+    }
+    cerr << "Unknown benchmark: " << name << " (rollup, cohorts)" << endl;
+    return 1;
+}
+
+void customerMenu(Customer& customer, Menu& menu, Order& order, Payment& payment, Receipt& receipt, int customerID) {
+    int choice;
+    while (true) {
+        clearScreen();
+        cout << BOLD << GREEN;
+        cout << "  *****************************************************************\n";
+        cout << "  *                       CUSTOMER PORTAL                         *\n";
+        cout << "  *****************************************************************\n";
+        cout << RESET;
+
+        cout << "\n    MENU OPTIONS:\n";
+        cout << " 1. View Menu\n";
+        cout << " 2. Search Menu\n";
+        cout << " 3. Manage Cart (Add/Delete/Clear)\n";
+        cout << " 4. View Cart\n";
+        cout << " 5. Place Order & Checkout\n";
+        cout << " 6. View Order History\n";
+        cout << " 7. View Profile\n";
+        cout << " 8. Update Address\n";
+        cout << " 9. Track My Rider\n";
+        cout << " 0. Logout\n";
+        cout << "\nEnter choice: ";
+        cin >> choice;
+
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Invalid input!" << endl;
+            pause();
+            continue;
+        }
+
+        switch (choice) {
+        case 1: {
+            menu.displayMenu();
+            pause();
+            break;
+        }
+
+        case 2: {
+            string keyword;
+            cout << "Enter search keyword: ";
+            cin.ignore();
+            getline(cin, keyword);
+            menu.searchMenu(keyword);
+            pause();
+            break;
+        }
+
+        case 3: {
+            int cartChoice;
+            do {
+                clearScreen();
+                cout << BOLD << CYAN << "============================ AVAILABLE MENU ===============================" << RESET << endl;
+                menu.displayMenu();
+
+                cout << "\n" << BOLD << YELLOW << "+-+-+-+-+-+-+- YOUR CART +-+-+-+-+-+-+-+-+-" << RESET << endl;
+                order.viewCart();
+
+                cout << "  \n" << BOLD << "Actions:" << RESET << endl;
+                cout << "       "<<"1.Add Item to Cart" << endl;
+                cout << "       "<<"2.Delete Specific Item" << endl;
+                cout << "       "<<"3.Clear Entire Cart" << endl;
+                cout << "       "<<"0.Back to Menu" << endl;
+                cout << "       "<<"Choice: ";
+                cin >> cartChoice;
+
+                if (cartChoice == 1) {
+                    int menuID, qty;
+                    cout << "\nEnter Menu ID (0 to cancel): ";
+                    cin >> menuID;
+                    if (menuID != 0) {
+                        cout << "Enter Quantity: ";
+                        cin >> qty;
+
+                        double price = menu.getMenuPrice(menuID);
+                        string name = menu.getMenuName(menuID);
+
+                        if (price > 0) {
+                            order.addToCart(menuID, qty, price, name);
+                        }
+                        else {
+                            cout << "Invalid Menu ID!" << endl;
+                        }
+                        pause();
+                    }
+                }
+                else if (cartChoice == 2) {
+                    if (!order.isCartEmpty()) {
+                        int idToDel;
+                        cout << "\nEnter Menu ID to remove: ";
+                        cin >> idToDel;
+                        order.deleteCartItem(idToDel);
+                    }
+                    pause();
+                }
+                else if (cartChoice == 3) {
+                    order.clearCart();
+                    pause();
+                }
+
+            } while (cartChoice != 0);
+            break;
+        }
+
+        case 4: {
+            order.viewCart();
+            pause();
+            break;
+        }
+
+              // FIXED CUSTOMER MENU - Place Order Section (Case 5)
+             // Replace case 5 in your customerMenu() function with this:
+
+        case 5: {
+            if (order.getCartSize() == 0) {
+                cout << RED << "Cart is empty! Add items first." << RESET << endl;
+                pause();
+                break;
+            }
+
+            // Show cart
+            order.viewCart();
+
+            // Ask for delivery address confirmation/update
+            cout << "\n" << YELLOW << "??? DELIVERY INFORMATION ???" << RESET << endl;
+            customer.viewProfile(customerID);
+
+            cout << "\n" << BOLD << "Is this delivery address correct? (y/n): " << RESET;
+            char addressConfirm;
+            cin >> addressConfirm;
+
+            if (addressConfirm == 'n' || addressConfirm == 'N') {
+                string newAddress;
+                cout << "\n" << YELLOW << "Enter new delivery address: " << RESET;
+                cin.ignore();
+                getline(cin, newAddress);
+
+                if (customer.updateAddress(customerID, newAddress)) {
+                    cout << GREEN << "? Delivery address updated!" << RESET << endl;
+                }
+            }
+
+            FeeQuote fee = receipt.quoteDeliveryFee(customer.getAddress(customerID));
+            cout << "\nDelivery fee: RM" << fixed << setprecision(2) << fee.fee;
+            if (!fee.zoneName.empty()) cout << " (" << fee.zoneName << ", " << setprecision(1) << fee.km << " km)";
+            if (fee.surge > 1.0) cout << RED << " x" << setprecision(2) << fee.surge << " peak hours" << RESET;
+            cout << endl;
+
+            // Confirm order
+            cout << "\n" << BOLD << YELLOW << "Confirm order? (y/n): " << RESET;
+            char confirm;
+            cin >> confirm;
+
+            if (confirm == 'y' || confirm == 'Y') {
+                payment.displayPaymentMethods();
+                int paymentChoice;
+                cout << "Select payment method (1-4): ";
+                cin >> paymentChoice;
+
+                string paymentMethod;
+                switch (paymentChoice) {
+                case 1: paymentMethod = "Cash"; break;
+                case 2: paymentMethod = "Online Banking"; break;
+                case 3: paymentMethod = "Credit Card"; break;
+                case 4: paymentMethod = "E-Wallet"; break;
+                default: paymentMethod = "Cash";
+                }
+
+                // Order, items, stock and payment are written in one transaction
+                double total = order.getCartTotal();
+                int orderID = order.createOrder(customerID, &payment, paymentMethod);
+                if (orderID != -1) {
+                    // Generate receipt (will clear screen and show in new page)
+                    receipt.generateReceipt(orderID, customerID, paymentMethod, total, fee);
+                    order.clearCart();
+                }
+            }
+            else {
+                cout << "\n" << YELLOW << "Order cancelled. You can:" << RESET << endl;
+                cout << "- Modify your cart (option 3)" << endl;
+                cout << "- Update delivery address (option 8)" << endl;
+                cout << "- Try placing order again (option 5)" << endl;
+                pause();
+            }
+            break;
+        }
+
+        case 6: {
+            order.viewOrderHistory(customerID);
+            pause();
+            break;
+        }
+
+        case 7: {
+            customer.viewProfile(customerID);
+            pause();
+            break;
+        }
+
+        case 8: {
+            string newAddress;
+            cout << "Enter new address: ";
+            cin.ignore();
+            getline(cin, newAddress);
+            customer.updateAddress(customerID, newAddress);
+            pause();
+            break;
+        }
+
+        case 9: {
+            order.trackMyRider(customerID);
+            pause();
+            break;
+        }
+
+        case 0: {
+            cout << "Logging out..." << endl;
+            return;
+        }
+
+        default: {
+            cout << "Invalid choice!" << endl;
+            pause();
+        }
+        }
+    }
+}
+
+// Order IDs typed on one line ("12 15 18"), or "all" for every active order
+vector<int> readOrderIDs(const vector<int>& active) {
+    cout << "\nEnter Order ID(s), separated by spaces, or 'all': ";
+    string line;
+    cin >> ws;
+    getline(cin, line);
+
+    vector<int> orderIDs;
+    istringstream in(line);
+    string token;
+    while (in >> token) {
+        if (token == "all" || token == "ALL") return active;
+        try {
+            orderIDs.push_back(stoi(token));
+        }
+        catch (const exception&) {
+            cout << YELLOW << "Ignoring '" << token << "'." << RESET << endl;
+        }
+    }
+    return orderIDs;
+}
+
+void riderMenu(Delivery& delivery, DispatchEngine& dispatcher, sql::Connection* con, int riderID) {
+    int choice;
+
+    while (true) {
+        clearScreen();
+        cout << BOLD << CYAN;
+        cout << "  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+\n";
+        cout << "  |                    RIDER DASHBOARD                            |\n";
+        cout << "  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+\n";
+        cout << RESET;
+
+        cout << "\n1. View Available Orders\n";
+        cout << "2. Accept Order\n";
+        cout << "3. View My Deliveries\n";
+        cout << "4. Update Delivery Status (One or More Orders)\n";
+        cout << "5.  Complete Order(s)\n";
+        cout << "6. View History\n";
+        if (dispatcher.isOnline(riderID)) {
+            cout << "7. Update My Location (Auto-Dispatch: " << GREEN << "ONLINE" << RESET << ")\n";
+            cout << "8. Go Offline\n";
+        }
+        else {
+            cout << "7. Go Online (Auto-Dispatch)\n";
+        }
+        cout << "9. Plan Multi-Order Trip\n";
+        cout << "10. Watch Available Orders (Live)\n";
+        cout << "11. Grab Next Order (Fast Claim)\n";
+        cout << "12. Share GPS Position\n";
+        cout << "13. My Scorecard\n";
+        cout << "0. Logout\n";
+        cout << "\nEnter choice: ";
+        cin >> choice;
+
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            pause();
+            continue;
+        }
+
+        switch (choice) {
+        case 1: {
+            delivery.viewAvailableOrders();
+            pause();
+            break;
+        }
+
+        case 2: {
+            delivery.viewAvailableOrders();
+            int orderID;
+            cout << "\nEnter Order ID (0 to cancel): ";
+            cin >> orderID;
+            if (orderID != 0) {
+                delivery.acceptOrder(orderID, riderID);
+            }
+            pause();
+            break;
+        }
+
+        case 3: {
+            delivery.viewMyDeliveries(riderID);
+            pause();
+            break;
+        }
+
+        case 4: {
+            vector<int> active;
+            if (delivery.viewMyDeliveries(riderID, &active) > 0) {
+                vector<int> orderIDs = readOrderIDs(active);
+                if (orderIDs.empty()) {
+                    pause();
+                    break;
+                }
+
+                cout << "\nSelect Status:\n";
+                cout << "1. Preparing\n";
+                cout << "2. Out for Delivery\n";
+                cout << "3. Arrived\n";
+                cout << "Choice: ";
+
+                int statusChoice;
+                cin >> statusChoice;
+
+                string status = (statusChoice == 1) ? "Preparing" :
+                    (statusChoice == 3) ? "Arrived" : "Out for Delivery";
+
+                vector<int> moved = delivery.updateDeliveryStatus(orderIDs, riderID, status);
+                if (!moved.empty()) {
+                    cout << GREEN << moved.size() << " order(s) now " << status << "." << RESET << endl;
+                }
+            }
+            pause();
+            break;
+        }
+
+        case 5: {
+            vector<int> active;
+            if (delivery.viewMyDeliveries(riderID, &active) > 0) {
+                vector<int> orderIDs = readOrderIDs(active);
+                vector<int> moved = delivery.updateDeliveryStatus(orderIDs, riderID, "Completed");
+                if (!moved.empty()) {
+                    cout << GREEN << moved.size() << " order(s) completed." << RESET << endl;
+                }
+            }
+            pause();
+            break;
+        }
+
+        case 6: {
+            delivery.viewDeliveryHistory(riderID);
+            pause();
+            break;
+        }
+
+        case 7: {
+            string location;
+            cout << "\nCurrent location (address or postcode): ";
+            cin.ignore();
+            getline(cin, location);
+            try {
+                if (!dispatcher.riderOnline(con, riderID, location)) {
+                    cout << YELLOW << "Location not recognised; you are placed at the kitchen." << RESET << endl;
+                }
+                cout << GREEN << "You are online. New orders are assigned to you automatically every "
+                    << dispatcher.batchSeconds() << " seconds (option 3)." << RESET << endl;
+            }
+            catch (sql::SQLException& e) {
+                cerr << RED << "Could not go online: " << e.what() << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 8: {
+            dispatcher.riderOffline(riderID);
+            cout << "You are offline and will not receive new orders." << endl;
+            pause();
+            break;
+        }
+
+        case 9: {
+            RoutePlan trip = delivery.planTrip();
+            if (trip.stops.empty()) {
+                cout << "\nNo open orders with a known delivery address." << endl;
+                pause();
+                break;
+            }
+            cout << "\n" << BOLD << CYAN << "=== SUGGESTED TRIP ===" << RESET << endl;
+            cout << "Kitchen";
+            for (const RouteStop& stop : trip.stops) cout << " -> Order #" << stop.orderID;
+            cout << "\n" << trip.stops.size() << " drop-offs, " << fixed << setprecision(1)
+                << trip.meters / 1000.0 << " km (planned in " << setprecision(2) << trip.planMs << " ms)" << endl;
+
+            cout << "\nAccept all " << trip.stops.size() << " orders? (y/n): ";
+            char confirm;
+            cin >> confirm;
+            if (confirm == 'y' || confirm == 'Y') {
+                vector<int> orderIDs;
+                for (const RouteStop& stop : trip.stops) orderIDs.push_back(stop.orderID);
+                if (delivery.acceptOrder(orderIDs, riderID)) {
+                    cout << GREEN << "Trip accepted. Deliver in the order shown." << RESET << endl;
+                }
+            }
+            pause();
+            break;
+        }
+
+        case 10: {
+            OpenOrdersBoard* board = delivery.openOrdersBoard();
+            if (!board) {
+                delivery.viewAvailableOrders();
+                pause();
+                break;
+            }
+            // Prints the board, then only what changes, for one minute
+            cout << "\n" << BOLD << CYAN << "=== AVAILABLE ORDERS (LIVE, 60 s) ===" << RESET << endl;
+            uint64_t cursor = 0;
+            auto until = chrono::steady_clock::now() + chrono::seconds(60);
+            while (chrono::steady_clock::now() < until) {
+                int waitMs = static_cast<int>(chrono::duration_cast<chrono::milliseconds>(until - chrono::steady_clock::now()).count());
+                for (const BoardDelta& d : board->waitForChanges(cursor, max(waitMs, 1))) {
+                    if (d.kind == BoardDelta::RESYNC) {
+                        cout << YELLOW << "-- " << board->size() << " open orders --" << RESET << endl;
+                    }
+                    else if (d.kind == BoardDelta::ADDED) {
+                        cout << GREEN << "+ " << RESET;
+                        Delivery::printOpenOrder(d.order);
+                    }
+                    else {
+                        cout << RED << "- Order " << d.order.orderID << " taken" << RESET << endl;
+                    }
+                }
+            }
+            pause();
+            break;
+        }
+
+        case 11: {
+            string zone;
+            cout << "\nYour area postcode (0 for any): ";
+            cin >> zone;
+            if (zone == "0") zone.clear();
+            int orderID = delivery.grabNextOrder(riderID, zone);
+            if (orderID != 0) {
+                cout << GREEN << "Order " << orderID << " is yours." << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 12: {
+            double lat, lng;
+            cout << "\nLatitude: ";
+            cin >> lat;
+            cout << "Longitude: ";
+            cin >> lng;
+            if (cin.fail()) {
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << RED << "Invalid coordinates." << RESET << endl;
+            }
+            else if (delivery.shareLocation(riderID, lat, lng)) {
+                cout << GREEN << "Position shared with your customers." << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 13: {
+            delivery.viewScorecard(riderID);
+            pause();
+            break;
+        }
+
+        case 0: {
+            dispatcher.riderOffline(riderID);
+            return;
+        }
+
+        default: {
+            pause();
+        }
+        }
+    }
+}
+
+// GANTI MENU DISPLAY dalam ownerMenu() dengan ni:
+
+void ownerMenu(Owner& owner, Menu& menu, Analytics& analytics, Receipt& receipt, PartitionManager& partitions,
+    DispatchEngine& dispatcher, EtaModel& eta, LocationService& locations,
+    DeliveryFeeEngine& fees, KitchenService& kitchen, sql::Connection* con) {
+    int choice;
+
+    while (true) {
+        clearScreen();
+        cout << BOLD << MAGENTA;
+        cout << "   -_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-\n";
+        cout << "  ||                     OWNER DASHBOARD                         ||\n";
+        cout << "   -_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-_-\n";
+        cout << RESET;
+
+        cout << "\n" << CYAN << "==== MENU MANAGEMENT ===" << RESET << endl;
+        cout << "1. View All Menu Items\n";
+        cout << "2. Add Menu Item\n";
+        cout << "3. Update Menu Item\n";
+        cout << "4. Delete Menu Item\n";
+
+        cout << "\n" << GREEN << "=====STOCK MANAGEMENT ===" << RESET << endl;
+        cout << "5. Update Stock\n";
+        cout << "6. View Low Stock Alert\n";
+        cout << "29. Set Item Unit Cost\n";
+        cout << "30. Rebuild Margins From Order History\n";
+
+        cout << "\n" << YELLOW << "===== ANALYTICS & REPORTS ===" << RESET << endl;
+        cout << "7.  Category Sales Table\n";
+        cout << "8.  Sales Summary Report\n";
+        cout << "9.  Peak Hours Bar Chart\n";
+        cout << "10.  Top Selling Items Table\n";
+        cout << "23.  Live Top Sellers (All Time / Today / Last Hour)\n";
+        cout << "24.  Live Sales Dashboard\n";
+        cout << "25.  Unique Buyers & Reach (Estimated)\n";
+        cout << "26.  Full Dashboard (All Reports)\n";
+        cout << "31.  Customer Cohorts & Retention\n";
+
+        cout << "\n" << BLUE << "===== RECEIPT MANAGEMENT ===" << RESET << endl;
+        cout << "11.  Search Receipts by Customer\n";
+        cout << "12.  View All Receipts History\n";
+        cout << "13.  View Specific Receipt Details\n";
+
+        cout << "\n" << MAGENTA << "===== OTHER MANAGEMENT ===" << RESET << endl;
+        cout << "14. View All Orders\n";
+        cout << "15. View All Customers\n";
+        cout << "16. View All Riders\n";
+
+        cout << "\n" << CYAN << "===== SYSTEM TOOLS ===" << RESET << endl;
+        cout << "17. Receipt Rendering Benchmark\n";
+        cout << "18. Receipt Storage Stats\n";
+        cout << "19. Archive Old Receipts\n";
+        cout << "20. Export Receipts (Date Range)\n";
+        cout << "21. Report Latency Benchmark\n";
+        cout << "22. Columnar Analytics Engine: " << (analytics.columnarEngineEnabled() ? "ON" : "OFF") << "\n";
+        cout << "27. Read Replica Routing Status\n";
+        cout << "28. History Partitions (Monthly)\n";
+        cout << "33. Rider Dispatch Status\n";
+        cout << "34. Dispatch Simulator (10k Orders / 1k Riders)\n";
+        cout << "35. Route Batching Benchmark\n";
+        cout << "36. Order Claim Contention Benchmark\n";
+        cout << "37. Delivery Time Model (ETA)\n";
+        cout << "38. Rider Location Ingestion Load Test\n";
+        cout << "39. Delivery Zones & Fees\n";
+        cout << "40. Add Delivery Zone\n";
+        cout << "41. Set Surge From Peak Hours\n";
+        cout << "42. Zone Lookup Benchmark\n";
+        cout << "43. Kitchen Ticket Board\n";
+        cout << "44. Kitchen Scheduling Simulation\n";
+
+        cout << "\n0. Logout\n";
+        cout << "\nEnter choice: ";
+        cin >> choice;
+
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            pause();
+            continue;
+        }
+
+        switch (choice) {
+        case 1: {
+            owner.viewAllMenuItems();
+            pause();
+            break;
+        }
+
+        case 2: {
+            string name, description;
+            double price;
+            int categoryID, stock;
+
+            owner.viewAllCategories();
+            cout << "\n=== ADD MENU ===" << endl;
+            cin.ignore();
+            cout << "Name: "; getline(cin, name);
+            cout << "Price: RM"; cin >> price;
+            cout << "Stock: "; cin >> stock;
+            cin.ignore();
+            cout << "Description: "; getline(cin, description);
+            cout << "Category ID: "; cin >> categoryID;
+
+            owner.addMenuItem(name, price, description, categoryID, stock);
+            pause();
+            break;
+        }
+
+        case 3: {
+            int menuID, categoryID, stock;
+            string name, description;
+            double price;
+
+            owner.viewAllMenuItems();
+            cout << "\nEnter Menu ID: "; cin >> menuID;
+            cin.ignore();
+            cout << "Name: "; getline(cin, name);
+            cout << "Price: RM"; cin >> price;
+            cout << "Stock: "; cin >> stock;
+            cin.ignore();
+            cout << "Description: "; getline(cin, description);
+            owner.viewAllCategories();
+            cout << "Category ID: "; cin >> categoryID;
+
+            owner.updateMenuItem(menuID, name, price, description, categoryID, stock);
+            pause();
+            break;
+        }
+
+        case 4: {
+            int menuID;
+            owner.viewAllMenuItems();
+            cout << "\nEnter Menu ID: "; cin >> menuID;
+            char confirm;
+            cout << "Are you sure? (y/n): "; cin >> confirm;
+            if (confirm == 'y' || confirm == 'Y') {
+                owner.deleteMenuItem(menuID);
+            }
+            pause();
+            break;
+        }
+
+        case 5: {
+            int menuID, stock;
+            owner.viewAllMenuItems();
+            cout << "\nEnter Menu ID: "; cin >> menuID;
+            cout << "New Stock: "; cin >> stock;
+            owner.updateStock(menuID, stock);
+            pause();
+            break;
+        }
+
+        case 6: {
+            owner.viewLowStockItems();
+            pause();
+            break;
+        }
+
+        case 7: {
+            analytics.showCategoryPerformance();
+            pause();
+            break;
+        }
+
+        case 8: {
+            analytics.showSalesSummary();
+            pause();
+            break;
+        }
+
+        case 9: {
+            analytics.showPeakHoursBarChart();
+            pause();
+            break;
+        }
+
+        case 10: {
+            analytics.showTopSellingTable();
+            pause();
+            break;
+        }
+
+        case 11: {
+            // ? SEARCH BY CUSTOMER NAME
+            string customerName;
+            cout << "\n" << BOLD << CYAN << "=== SEARCH RECEIPTS BY CUSTOMER ===" << RESET << endl;
+            cout << "Enter customer name: ";
+            cin.ignore();
+            getline(cin, customerName);
+
+            if (!customerName.empty()) {
+                receipt.searchReceiptsByCustomer(customerName);
+            }
+            else {
+                cout << RED << "Customer name cannot be empty!" << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 12: {
+            receipt.viewAllReceipts();
+            pause();
+            break;
+        }
+
+        case 13: {
+            // ? SHOW ALL RECEIPTS FIRST, THEN LET OWNER CHOOSE
+            receipt.viewAllReceipts();  // Tunjuk list dulu
+
+            int receiptID;
+            cout << "\n" << YELLOW << "Enter Receipt ID to view details (0 to cancel): " << RESET;
+            cin >> receiptID;
+
+            if (receiptID != 0) {
+                receipt.viewReceiptDetails(receiptID);
+            }
+            else {
+                cout << GREEN << "Cancelled." << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 14: {
+            owner.viewAllOrders();
+            pause();
+            break;
+        }
+
+        case 15: {
+            owner.viewAllCustomers();
+            pause();
+            break;
+        }
+
+        case 16: {
+            owner.viewAllRiders();
+            pause();
+            break;
+        }
+
+        case 17: {
+            receipt.benchmarkRendering();
+            pause();
+            break;
+        }
+
+        case 18: {
+            receipt.showStorageStats();
+            pause();
+            break;
+        }
+
+        case 19: {
+            int months;
+            cout << "\nKeep how many recent months in the live table? ";
+            cin >> months;
+            if (months >= 1) {
+                int moved = receipt.archiveOldReceipts(months);
+                if (moved >= 0) cout << GREEN << "Archived " << moved << " receipts." << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 20: {
+            string fromDate, toDate;
+            int format;
+            cout << "\nFrom date (YYYY-MM-DD): "; cin >> fromDate;
+            cout << "To date, exclusive (YYYY-MM-DD): "; cin >> toDate;
+            cout << "Format (1 = NDJSON, 2 = CSV): "; cin >> format;
+            receipt.exportReceipts(fromDate, toDate, format == 2);
+            pause();
+            break;
+        }
+
+        case 21: {
+            analytics.benchmarkReports();
+            cout << "\nFor the 10k-10M row scaling run: workshop1_utem --bench rollup (scratch schema only)" << endl;
+            pause();
+            break;
+        }
+
+        case 22: {
+            analytics.setColumnarEngine(!analytics.columnarEngineEnabled());
+            cout << GREEN << "Columnar analytics engine "
+                << (analytics.columnarEngineEnabled() ? "enabled" : "disabled") << "." << RESET << endl;
+            pause();
+            break;
+        }
+
+        case 23: {
+            analytics.showLiveTopSellers();
+            pause();
+            break;
+        }
+
+        case 24: {
+            analytics.showLiveDashboard();
+            break;
+        }
+
+        case 25: {
+            analytics.showReach();
+            pause();
+            break;
+        }
+
+        case 26: {
+            analytics.showFullDashboard();
+            pause();
+            break;
+        }
+
+        case 27: {
+            analytics.showRoutingStatus();
+            pause();
+            break;
+        }
+
+        case 28: {
+            try {
+                vector<string> tables = PartitionManager::tables();
+                cout << "\n" << BOLD << CYAN << "=== HISTORY TABLE PARTITIONS ===" << RESET << endl;
+                for (const string& table : tables) {
+                    vector<PartitionInfo> parts = partitions.partitions(table);
+                    cout << "\n" << BOLD << left << setw(16) << table << RESET;
+                    if (parts.empty()) {
+                        cout << YELLOW << "not partitioned" << RESET << endl;
+                        continue;
+                    }
+                    long long rows = 0;
+                    for (const PartitionInfo& p : parts) rows += p.rows;
+                    cout << parts.size() << " partitions by " << PartitionManager::dateColumn(table)
+                        << ", ~" << rows << " rows" << endl;
+                    for (const PartitionInfo& p : parts) {
+                        cout << "   " << left << setw(10) << p.name << right << setw(10) << p.rows << " rows" << endl;
+                    }
+                }
+
+                int action;
+                cout << "\n1. Partition tables by month\n";
+                cout << "2. Add upcoming month partitions\n";
+                cout << "3. Drop order history older than N months\n";
+                cout << "0. Back\n";
+                cout << "Choice: ";
+                cin >> action;
+
+                if (action == 1) {
+                    cout << YELLOW << "This rebuilds each table and removes every foreign key on or referencing the history\n"
+                        << "tables (MySQL does not allow them on partitioned tables). Order retention (3) then\n"
+                        << "deletes the rows that refer to old orders itself." << RESET << endl;
+                    cout << "Continue? (y/n): ";
+                    char confirm;
+                    cin >> confirm;
+                    if (confirm == 'y' || confirm == 'Y') {
+                        for (const string& table : tables) {
+                            string error;
+                            vector<string> droppedKeys;
+                            bool done = partitions.migrate(table, 3, error, &droppedKeys);
+                            for (const string& key : droppedKeys) cout << "   dropped foreign key " << key << endl;
+                            if (done) {
+                                cout << GREEN << table << ": partitioned by month." << RESET << endl;
+                            }
+                            else {
+                                cout << RED << table << ": skipped, " << error << "." << RESET << endl;
+                            }
+                        }
+                    }
+                }
+                else if (action == 2) {
+                    int added = partitions.maintain(3);
+                    cout << GREEN << "Added " << added << " month partitions." << RESET << endl;
+                }
+                else if (action == 3) {
+                    int months;
+                    cout << "Keep how many recent months of orders and payments? ";
+                    cin >> months;
+                    if (months >= 1) {
+                        cout << YELLOW << "Orders, order items and payments before "
+                            << PartitionManager::monthFromNow(-months) / 100 << "-"
+                            << setw(2) << setfill('0') << PartitionManager::monthFromNow(-months) % 100 << setfill(' ')
+                            << " are deleted permanently, together with their delivery events, the\n"
+                            << "daily sales, margin and rider stats for those days and rider GPS points\n"
+                            << "recorded before then. All-time item and category totals keep them;\n"
+                            << "receipts are archived separately (option 19)." << RESET << endl;
+                        cout << "Continue? (y/n): ";
+                        char confirm;
+                        cin >> confirm;
+                        if (confirm == 'y' || confirm == 'Y') {
+                            long long dependent = 0;
+                            long long dropped = partitions.retireBefore(PartitionManager::monthFromNow(-months), dependent);
+                            cout << GREEN << "Dropped ~" << dropped << " order, item and payment rows and "
+                                << dependent << " dependent rows." << RESET << endl;
+                        }
+                    }
+                }
+            }
+            catch (sql::SQLException& e) {
+                cerr << RED << "Partition error: " << e.what() << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 29: {
+            int menuID;
+            double unitCost;
+            string effectiveFrom;
+            owner.viewAllMenuItems();
+            cout << "\nEnter Menu ID: "; cin >> menuID;
+            cout << "Unit Cost: RM"; cin >> unitCost;
+            cout << "Effective from (YYYY-MM-DD, or 0 for now): "; cin >> effectiveFrom;
+            if (effectiveFrom == "0") effectiveFrom.clear();
+            if (unitCost >= 0) owner.setUnitCost(menuID, unitCost, effectiveFrom);
+            pause();
+            break;
+        }
+
+        case 30: {
+            owner.rebuildMargins();
+            pause();
+            break;
+        }
+
+        case 31: {
+            analytics.showCohortRetention();
+            pause();
+            break;
+        }
+
+        case 33: {
+            DispatchStats stats = dispatcher.snapshot();
+            cout << "\n" << BOLD << CYAN << "=== RIDER DISPATCH ===" << RESET << endl;
+            cout << "Batch interval:     " << dispatcher.batchSeconds() << " s" << endl;
+            cout << "Open orders queued: " << stats.pendingOrders << endl;
+            cout << "Riders free:        " << stats.freeRiders << endl;
+            cout << "Riders delivering:  " << stats.busyRiders << endl;
+            cout << "Batches run:        " << stats.batches << endl;
+            cout << "Orders assigned:    " << stats.assigned << endl;
+            cout << "Lost claims:        " << stats.lostClaims << " (taken by hand first)" << endl;
+            cout << "Held for kitchen:   " << stats.heldForKitchen << " (food not ready in time)" << endl;
+            cout << "Last batch:         " << fixed << setprecision(2) << stats.lastBatchMs << " ms" << endl;
+            pause();
+            break;
+        }
+
+        case 34: {
+            cout << "\nSimulating 10,000 orders and 1,000 riders across 40 kitchens..." << endl;
+            DispatchSimulation sim = simulateDispatch();
+            cout << "\n" << BOLD << CYAN << "=== DISPATCH SIMULATION ===" << RESET << endl;
+            cout << fixed << setprecision(2);
+            cout << "Batches:            " << sim.batches << " (" << sim.assigned << " orders assigned)" << endl;
+            cout << "Matching time:      " << sim.totalMs << " ms total, p50 " << sim.p50BatchMs
+                << " ms, p99 " << sim.p99BatchMs << " ms, max " << sim.maxBatchMs << " ms" << endl;
+            cout << "Mean wait:          " << sim.meanWaitBatches << " batches" << endl;
+            if (sim.assigned > 0 && sim.greedyAssigned > 0) {
+                double auctionAvg = sim.auctionKm / sim.assigned;
+                double greedyAvg = sim.greedyKm / sim.greedyAssigned;
+                cout << "Auction matching:   " << sim.assigned << " matches, " << auctionAvg << " km to pickup on average" << endl;
+                cout << "Greedy nearest:     " << sim.greedyAssigned << " matches, " << greedyAvg << " km to pickup on average" << endl;
+                cout << GREEN << "Auction saves " << (greedyAvg - auctionAvg) * 1000.0 << " m per pickup and matches "
+                    << (sim.assigned - sim.greedyAssigned) << " more orders." << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 35: {
+            cout << "\nBatching 2,000 synthetic orders around one kitchen (up to 4 drops within 2 km)..." << endl;
+            RouteBenchmark bench = benchmarkRouteBatching();
+            cout << "\n" << BOLD << CYAN << "=== ROUTE BATCHING BENCHMARK ===" << RESET << endl;
+            cout << fixed << setprecision(1);
+            cout << "Orders:               " << bench.orders << " in " << bench.trips << " trips" << endl;
+            cout << "One order per trip:   " << bench.singleKm << " km" << endl;
+            cout << "Batched, nearest:     " << bench.nearestKm << " km" << endl;
+            cout << "Batched, 2-opt:       " << bench.batchedKm << " km" << endl;
+            if (bench.singleKm > 0) {
+                cout << GREEN << "Saved " << bench.singleKm - bench.batchedKm << " km ("
+                    << 100.0 * (bench.singleKm - bench.batchedKm) / bench.singleKm << "%)" << RESET << endl;
+            }
+            cout << setprecision(3) << "Planning time:        " << bench.totalPlanMs << " ms total, "
+                << bench.maxPlanMs << " ms slowest trip" << endl;
+            pause();
+            break;
+        }
+
+        case 36: {
+            cout << "\n64 riders grabbing 2,000 orders at once (simulated 300 us database round trip)..." << endl;
+            ClaimBenchmark bench = benchmarkClaimContention();
+            cout << "\n" << BOLD << CYAN << "=== ORDER CLAIM CONTENTION ===" << RESET << endl;
+            cout << fixed << setprecision(2);
+            cout << left << setw(22) << "" << right << setw(14) << "Row locks" << setw(14) << "Claim queue" << endl;
+            cout << left << setw(22) << "All orders claimed" << right << setw(11) << bench.rowLockMs << " ms"
+                << setw(11) << bench.queueMs << " ms" << endl;
+            cout << left << setw(22) << "Rider wait per order" << right << setw(11) << bench.rowLockWaitMs * 1000.0 << " us"
+                << setw(11) << bench.queueWaitUs << " us" << endl;
+            cout << left << setw(22) << "Database updates" << right << setw(14) << bench.rowLockRoundTrips
+                << setw(14) << bench.queueRoundTrips << endl;
+            pause();
+            break;
+        }
+
+        case 37: {
+            cout << "\n" << BOLD << CYAN << "=== DELIVERY TIME MODEL ===" << RESET << endl;
+            cout << "Deliveries learned: " << eta.deliveriesLearned() << endl;
+            cout << "Orders in flight:   " << eta.ordersInFlight() << endl;
+            EtaEstimate now = eta.estimate(0);
+            cout << "New order now:      " << now.lowMinutes << "-" << now.highMinutes << " minutes (" << now.basis;
+            if (now.samples > 0) cout << ", " << now.samples << " deliveries";
+            cout << ")" << endl;
+
+            vector<double> byHour = eta.placedToDoorByHour();
+            cout << "\nAverage order-to-door time by hour:" << endl;
+            for (int h = 0; h < 24; h++) {
+                if (byHour[h] < 0) continue;
+                cout << "  " << right << setw(2) << setfill('0') << h << ":00" << setfill(' ') << "  "
+                    << fixed << setprecision(1) << setw(6) << byHour[h] << " min  "
+                    << string(static_cast<size_t>(min(60.0, byHour[h])), '#') << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 38: {
+            cout << "\n2,000 riders pinging every 500 ms, then 5,000 every 100 ms (5 s each)..." << endl;
+            LocationLoadResult runs[2] = { runLocationLoad(2000, 5, 500), runLocationLoad(5000, 5, 100) };
+            LocationStats live = locations.stats();
+            cout << "\n" << BOLD << CYAN << "=== RIDER LOCATION INGESTION ===" << RESET << endl;
+            cout << left << setw(22) << "" << right << setw(14) << "2k @ 2 Hz" << setw(14) << "5k @ 10 Hz" << endl;
+            cout << fixed << setprecision(0);
+            cout << left << setw(22) << "Pings / second" << right << setw(14) << runs[0].pingsPerSecond << setw(14) << runs[1].pingsPerSecond << endl;
+            cout << left << setw(22) << "Dropped" << right << setw(14) << runs[0].dropped << setw(14) << runs[1].dropped << endl;
+            cout << left << setw(22) << "Points kept" << right << setw(14) << runs[0].kept << setw(14) << runs[1].kept << endl;
+            cout << left << setw(22) << "Insert statements" << right << setw(14) << runs[0].insertBatches << setw(14) << runs[1].insertBatches << endl;
+            cout << setprecision(1);
+            cout << left << setw(22) << "Latest lookup" << right << setw(11) << runs[0].latestLookupNs << " ns"
+                << setw(11) << runs[1].latestLookupNs << " ns" << endl;
+            cout << "\nLive service: " << live.riders << " riders, " << live.received << " pings, "
+                << live.persisted << " points stored in " << live.batches << " inserts" << endl;
+            pause();
+            break;
+        }
+
+        case 39: {
+            cout << "\n" << BOLD << CYAN << "=== DELIVERY ZONES & FEES ===" << RESET << endl;
+            vector<DeliveryZone> zones = fees.zones();
+            if (zones.empty()) cout << "No zones defined; every order pays the flat RM" << fixed << setprecision(2) << fees.flatFee() << endl;
+            for (const DeliveryZone& z : zones) {
+                cout << left << setw(5) << z.zoneID << setw(24) << z.name << right << setw(3) << z.polygon.size() << " corners  ";
+                for (const FeeBand& b : z.bands) cout << "<=" << fixed << setprecision(1) << b.upToKm << "km RM" << setprecision(2) << b.fee << "  ";
+                cout << endl;
+            }
+            vector<SurgeRule> surges = fees.surgeRules();
+            for (const SurgeRule& r : surges) {
+                cout << "Surge x" << fixed << setprecision(2) << r.multiplier << " "
+                    << setw(2) << setfill('0') << r.startHour << ":00-" << setw(2) << r.endHour << ":00" << setfill(' ')
+                    << (r.zoneID == 0 ? " (all zones)" : " (zone " + to_string(r.zoneID) + ")") << endl;
+            }
+            cout << "Snapshots loaded: " << fees.reloadCount() << endl;
+
+            string address;
+            cout << "\nQuote an address (blank to skip): ";
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            getline(cin, address);
+            if (!address.empty()) {
+                FeeQuote q = fees.quote(address);
+                cout << "Fee RM" << fixed << setprecision(2) << q.fee;
+                if (q.km < 0) cout << " (address not located; flat fee)";
+                else if (q.zoneID == 0) cout << " (" << setprecision(1) << q.km << " km, outside every zone; flat fee)";
+                else cout << " (" << q.zoneName << ", " << setprecision(1) << q.km << " km, surge x" << setprecision(2) << q.surge << ")";
+                cout << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 40: {
+            string name, polygon, bandLine;
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "\nZone name: ";
+            getline(cin, name);
+            cout << "Corners as 'lat lng, lat lng, ...': ";
+            getline(cin, polygon);
+            cout << "Fee bands as 'km:fee km:fee ...' (e.g. 3:4.00 6:6.50 10:9.00): ";
+            getline(cin, bandLine);
+
+            vector<GeoPoint> corners;
+            if (!parsePolygon(polygon, corners)) {
+                cout << RED << "A zone needs at least three 'lat lng' corners." << RESET << endl;
+                pause();
+                break;
+            }
+            vector<FeeBand> bands;
+            istringstream in(bandLine);
+            string token;
+            while (in >> token) {
+                size_t colon = token.find(':');
+                try {
+                    if (colon == string::npos) throw invalid_argument(token);
+                    FeeBand b = { stod(token.substr(0, colon)), stod(token.substr(colon + 1)) };
+                    bands.push_back(b);
+                }
+                catch (const exception&) {
+                    cout << YELLOW << "Ignoring band '" << token << "'." << RESET << endl;
+                }
+            }
+            try {
+                int zoneID = fees.addZone(con, name, polygon, bands);
+                cout << GREEN << "Zone " << zoneID << " added and in effect." << RESET << endl;
+            }
+            catch (sql::SQLException& e) {
+                cerr << RED << "Could not add zone: " << e.what() << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 41: {
+            double multiplier;
+            cout << "\nSurge multiplier for peak hours (e.g. 1.5): ";
+            cin >> multiplier;
+            if (cin.fail() || multiplier < 1.0 || multiplier > 5.0) {
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << RED << "Enter a multiplier between 1.0 and 5.0." << RESET << endl;
+                pause();
+                break;
+            }
+            try {
+                vector<SurgeRule> rules = fees.setPeakSurge(con, multiplier);
+                if (rules.empty()) cout << "No order history yet; surge cleared." << endl;
+                for (const SurgeRule& r : rules) {
+                    cout << GREEN << "Surge x" << fixed << setprecision(2) << r.multiplier << " from "
+                        << setw(2) << setfill('0') << r.startHour << ":00 to " << setw(2) << r.endHour % 24 << ":00"
+                        << setfill(' ') << RESET << endl;
+                }
+            }
+            catch (sql::SQLException& e) {
+                cerr << RED << "Could not set surge: " << e.what() << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 42: {
+            cout << "\nResolving 200,000 random points against 2,000 synthetic zones..." << endl;
+            ZoneBenchmark bench = benchmarkZoneLookup();
+            cout << "\n" << BOLD << CYAN << "=== ZONE LOOKUP BENCHMARK ===" << RESET << endl;
+            cout << fixed << setprecision(2);
+            cout << "R-tree build:      " << bench.buildMs << " ms (" << bench.treeNodes << " nodes)" << endl;
+            cout << setprecision(3);
+            cout << "R-tree lookup:     " << bench.treeUs << " us" << endl;
+            cout << "Scan of all zones: " << bench.scanUs << " us" << endl;
+            cout << "Disagreements:     " << bench.mismatches << endl;
+            pause();
+            break;
+        }
+
+        case 43: {
+            time_t now = time(nullptr);
+            vector<StationBoard> board = kitchen.board();
+            cout << "\n" << BOLD << CYAN << "=== KITCHEN TICKET BOARD ===" << RESET << endl;
+            for (const StationBoard& station : board) {
+                cout << "\n" << BOLD << station.station.name << RESET << " (" << station.station.cooks << " cooks, "
+                    << station.queued.size() << " waiting)" << endl;
+                for (const KitchenTicket& t : station.cooking) {
+                    double remaining = t.startedAt + t.estimate - static_cast<double>(now);
+                    cout << "  " << GREEN << "#" << left << setw(5) << t.ticketID << RESET << "  Order " << setw(6) << t.orderID
+                        << (remaining >= 0 ? "  done in " : "  over by ") << fixed << setprecision(1) << fabs(remaining) / 60.0 << " min  ";
+                    for (const KitchenLine& line : t.lines) cout << line.quantity << "x " << line.name << "  ";
+                    cout << endl;
+                }
+                for (const KitchenTicket& t : station.queued) {
+                    cout << "  " << YELLOW << "#" << left << setw(5) << t.ticketID << RESET << "  Order " << setw(6) << t.orderID
+                        << "  due in " << fixed << setprecision(1) << (t.dueAt - static_cast<double>(now)) / 60.0 << " min  ";
+                    for (const KitchenLine& line : t.lines) cout << line.quantity << "x " << line.name << "  ";
+                    cout << endl;
+                }
+            }
+            vector<pair<int, double>> ready = kitchen.readyOrders();
+            if (!ready.empty()) {
+                cout << "\n" << BOLD << "Ready, waiting for rider:" << RESET << endl;
+                for (const auto& r : ready) {
+                    cout << "  Order " << setw(6) << r.first << "  for " << fixed << setprecision(1)
+                        << (static_cast<double>(now) - r.second) / 60.0 << " min" << endl;
+                }
+            }
+
+            int ticketID;
+            cout << "\nBump ticket # (0 to go back): ";
+            cin >> ticketID;
+            if (ticketID > 0) {
+                try {
+                    if (kitchen.bump(con, ticketID)) cout << GREEN << "Ticket " << ticketID << " done." << RESET << endl;
+                    else cout << RED << "Ticket " << ticketID << " is not cooking." << RESET << endl;
+                }
+                catch (sql::SQLException& e) {
+                    cerr << RED << "Could not save prep times: " << e.what() << RESET << endl;
+                }
+            }
+            pause();
+            break;
+        }
+
+        case 44: {
+            cout << "\nReplaying the last 30 days of orders through the kitchen..." << endl;
+            try {
+                KitchenBenchmark bench = benchmarkKitchen(con, kitchen);
+                cout << "\n" << BOLD << CYAN << "=== KITCHEN SCHEDULING SIMULATION ===" << RESET << endl;
+                cout << "Order stream:  " << bench.orders << " orders (" << bench.source << "), replayed in "
+                    << fixed << setprecision(1) << bench.replayMs << " ms" << endl;
+                const KitchenSimResult* results[] = { &bench.baseline, &bench.scheduled };
+                for (const KitchenSimResult* r : results) {
+                    cout << "\n" << BOLD << r->policy << RESET << endl;
+                    cout << fixed << setprecision(2);
+                    cout << "  Order to food ready:  " << r->avgReadyMinutes << " min avg" << endl;
+                    cout << "  Rider wait at pass:   " << r->avgRiderWaitMinutes << " min avg, p90 " << r->p90RiderWaitMinutes
+                        << " min, " << setprecision(1) << r->riderIdleHours << " rider-hours" << endl;
+                    cout << setprecision(2);
+                    cout << "  Food wait at pass:    " << r->avgFoodWaitMinutes << " min avg" << endl;
+                    cout << "  Riders kept > 2 min:  " << r->lateOrders << endl;
+                }
+            }
+            catch (sql::SQLException& e) {
+                cerr << RED << "Could not load order history: " << e.what() << RESET << endl;
+            }
+            pause();
+            break;
+        }
+
+        case 0: {
+            return;
+        }
+
+        default: {
+            pause();
+        }
+        }
+    }
 }
\ No newline at end of file
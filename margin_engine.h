@@ -0,0 +1,262 @@
+#ifndef MARGIN_ENGINE_H
+#define MARGIN_ENGINE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "sales_rollup.h"
+
+struct MarginTotals {
+    double revenue;             // item revenue at checkout prices
+    double cost;                // cost of goods for the costed part of that revenue
+    double uncostedRevenue;     // revenue from items with no unit cost on record
+
+    double costedRevenue() const { return revenue - uncostedRevenue; }
+    bool hasCost() const { return costedRevenue() > 0.005; }
+    double marginPercent() const { return hasCost() ? (costedRevenue() - cost) * 100.0 / costedRevenue() : 0.0; }
+    double costedPercent() const { return revenue > 0 ? costedRevenue() * 100.0 / revenue : 0.0; }
+};
+
+// Cost of goods and gross margin, kept current at checkout and restock.
+//   menu_cost        : unit cost per MenuID with the date it takes effect
+//   margin_item      : per MenuID   (quantity, revenue, cost, uncosted revenue)
+//   margin_category  : per Category (revenue, cost, uncosted revenue)
+//   margin_day       : per calendar day (revenue, cost, uncosted revenue)
+//   margin_inventory : one row, retail value of the stock on hand
+// Each sale is costed at the unit cost in effect when it was placed and
+// valued at the price charged (order_item.UnitPrice, as in the sales
+// rollups); sales of items with no cost yet are kept apart so they do not
+// inflate the margin.
+class MarginEngine {
+private:
+    sql::Connection* conn;
+    bool schemaChecked = false;
+
+    static MarginTotals totalsFrom(sql::ResultSet* res) {
+        MarginTotals t = { 0.0, 0.0, 0.0 };
+        if (res->next()) {
+            t.revenue = res->getDouble("Revenue");
+            t.cost = res->getDouble("Cost");
+            t.uncostedRevenue = res->getDouble("Uncosted");
+        }
+        return t;
+    }
+
+public:
+    MarginEngine(sql::Connection* connection) : conn(connection) {}
+
+    // Creates the cost and margin tables on first use and backfills them
+    void ensureSchema() {
+        if (schemaChecked) return;
+        SalesRollup(conn).ensureSchema();       // order_item.UnitPrice, read by rebuild()
+        bool fresh = !tableExists(conn, "margin_item");
+
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS menu_cost ("
+            "MenuID INT NOT NULL, EffectiveFrom DATETIME NOT NULL, UnitCost DECIMAL(10,2) NOT NULL, "
+            "PRIMARY KEY (MenuID, EffectiveFrom))");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS margin_item ("
+            "MenuID INT PRIMARY KEY, Quantity BIGINT NOT NULL DEFAULT 0, "
+            "Revenue DECIMAL(14,2) NOT NULL DEFAULT 0, Cost DECIMAL(14,2) NOT NULL DEFAULT 0, "
+            "Uncosted DECIMAL(14,2) NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS margin_category ("
+            "CategoryID INT PRIMARY KEY, Revenue DECIMAL(14,2) NOT NULL DEFAULT 0, "
+            "Cost DECIMAL(14,2) NOT NULL DEFAULT 0, Uncosted DECIMAL(14,2) NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS margin_day ("
+            "SalesDate DATE PRIMARY KEY, Revenue DECIMAL(14,2) NOT NULL DEFAULT 0, "
+            "Cost DECIMAL(14,2) NOT NULL DEFAULT 0, Uncosted DECIMAL(14,2) NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS margin_inventory ("
+            "Id TINYINT PRIMARY KEY, RetailValue DECIMAL(14,2) NOT NULL DEFAULT 0)");
+
+        schemaChecked = true;
+        if (fresh) rebuild();
+    }
+
+    // Recomputes every aggregate from order history, costing each line at the
+    // unit cost in effect on its order date (backfill / repair after a cost
+    // correction)
+    void rebuild() {
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        stmt->execute("DELETE FROM margin_item");
+        stmt->execute("DELETE FROM margin_category");
+        stmt->execute("DELETE FROM margin_day");
+        stmt->execute("DELETE FROM margin_inventory");
+
+        const std::string lines =
+            "(SELECT oi.MenuID, m.CategoryID, DATE(o.OrdersDate) AS SalesDate, oi.Quantity, "
+            "oi.Quantity * IFNULL(oi.UnitPrice, m.Price) AS Revenue, "
+            "oi.Quantity * (SELECT c.UnitCost FROM menu_cost c WHERE c.MenuID = oi.MenuID "
+            "AND c.EffectiveFrom <= o.OrdersDate ORDER BY c.EffectiveFrom DESC LIMIT 1) AS Cost "
+            "FROM order_item oi JOIN orders o ON o.OrdersID = oi.OrdersID JOIN menu m ON m.MenuID = oi.MenuID) x ";
+        const std::string sums =
+            "SUM(Revenue), SUM(IFNULL(Cost, 0)), SUM(IF(Cost IS NULL, Revenue, 0)) FROM ";
+
+        stmt->execute("INSERT INTO margin_item (MenuID, Quantity, Revenue, Cost, Uncosted) "
+            "SELECT MenuID, SUM(Quantity), " + sums + lines + "GROUP BY MenuID");
+        stmt->execute("INSERT INTO margin_category (CategoryID, Revenue, Cost, Uncosted) "
+            "SELECT CategoryID, " + sums + lines + "GROUP BY CategoryID");
+        stmt->execute("INSERT INTO margin_day (SalesDate, Revenue, Cost, Uncosted) "
+            "SELECT SalesDate, " + sums + lines + "GROUP BY SalesDate");
+        stmt->execute("INSERT INTO margin_inventory (Id, RetailValue) "
+            "SELECT 1, IFNULL(SUM(Stock * Price), 0) FROM menu");
+    }
+
+    // Records a unit cost taking effect at effectiveFrom ("" = now). Sales
+    // already made keep the cost they were booked at.
+    void setUnitCost(int menuID, double unitCost, const std::string& effectiveFrom) {
+        ensureSchema();
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(effectiveFrom.empty()
+            ? "INSERT INTO menu_cost (MenuID, EffectiveFrom, UnitCost) VALUES (?, NOW(), ?) "
+              "ON DUPLICATE KEY UPDATE UnitCost = VALUES(UnitCost)"
+            : "INSERT INTO menu_cost (MenuID, UnitCost, EffectiveFrom) VALUES (?, ?, ?) "
+              "ON DUPLICATE KEY UPDATE UnitCost = VALUES(UnitCost)"));
+        pstmt->setInt(1, menuID);
+        pstmt->setDouble(2, unitCost);
+        if (!effectiveFrom.empty()) pstmt->setString(3, effectiveFrom);
+        pstmt->executeUpdate();
+    }
+
+    // Unit cost in effect now; negative when the item has none
+    double currentUnitCost(int menuID) {
+        ensureSchema();
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+            "SELECT UnitCost FROM menu_cost WHERE MenuID = ? AND EffectiveFrom <= NOW() "
+            "ORDER BY EffectiveFrom DESC LIMIT 1"));
+        pstmt->setInt(1, menuID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        return res->next() ? static_cast<double>(res->getDouble("UnitCost")) : -1.0;
+    }
+
+    // Called inside the checkout transaction, after stock has been deducted
+    void recordOrder(const std::vector<RollupLine>& lines) {
+        ensureSchema();
+
+        std::map<int, std::pair<int, double>> perItem;
+        for (const RollupLine& line : lines) {
+            perItem[line.menuID].first += line.quantity;
+            perItem[line.menuID].second += line.quantity * line.price;
+        }
+
+        std::unique_ptr<sql::PreparedStatement> itemStmt(conn->prepareStatement(
+            "INSERT INTO margin_item (MenuID, Quantity, Revenue, Cost, Uncosted) VALUES (?, ?, ?, ?, ?) "
+            "ON DUPLICATE KEY UPDATE Quantity = Quantity + VALUES(Quantity), Revenue = Revenue + VALUES(Revenue), "
+            "Cost = Cost + VALUES(Cost), Uncosted = Uncosted + VALUES(Uncosted)"));
+        std::unique_ptr<sql::PreparedStatement> catStmt(conn->prepareStatement(
+            "INSERT INTO margin_category (CategoryID, Revenue, Cost, Uncosted) "
+            "SELECT CategoryID, ?, ?, ? FROM menu WHERE MenuID = ? "
+            "ON DUPLICATE KEY UPDATE Revenue = Revenue + VALUES(Revenue), "
+            "Cost = Cost + VALUES(Cost), Uncosted = Uncosted + VALUES(Uncosted)"));
+        std::unique_ptr<sql::PreparedStatement> invStmt(conn->prepareStatement(
+            "UPDATE margin_inventory SET RetailValue = RetailValue - ? * (SELECT Price FROM menu WHERE MenuID = ?) "
+            "WHERE Id = 1"));
+
+        MarginTotals day = { 0.0, 0.0, 0.0 };
+        for (const auto& entry : perItem) {
+            int quantity = entry.second.first;
+            double revenue = entry.second.second;
+            double unitCost = currentUnitCost(entry.first);
+            double cost = unitCost >= 0 ? quantity * unitCost : 0.0;
+            double uncosted = unitCost >= 0 ? 0.0 : revenue;
+
+            itemStmt->setInt(1, entry.first);
+            itemStmt->setInt(2, quantity);
+            itemStmt->setDouble(3, revenue);
+            itemStmt->setDouble(4, cost);
+            itemStmt->setDouble(5, uncosted);
+            itemStmt->executeUpdate();
+
+            catStmt->setDouble(1, revenue);
+            catStmt->setDouble(2, cost);
+            catStmt->setDouble(3, uncosted);
+            catStmt->setInt(4, entry.first);
+            catStmt->executeUpdate();
+
+            invStmt->setInt(1, quantity);
+            invStmt->setInt(2, entry.first);
+            invStmt->executeUpdate();
+
+            day.revenue += revenue;
+            day.cost += cost;
+            day.uncostedRevenue += uncosted;
+        }
+
+        std::unique_ptr<sql::PreparedStatement> dayStmt(conn->prepareStatement(
+            "INSERT INTO margin_day (SalesDate, Revenue, Cost, Uncosted) VALUES (CURDATE(), ?, ?, ?) "
+            "ON DUPLICATE KEY UPDATE Revenue = Revenue + VALUES(Revenue), "
+            "Cost = Cost + VALUES(Cost), Uncosted = Uncosted + VALUES(Uncosted)"));
+        dayStmt->setDouble(1, day.revenue);
+        dayStmt->setDouble(2, day.cost);
+        dayStmt->setDouble(3, day.uncostedRevenue);
+        dayStmt->executeUpdate();
+    }
+
+    // Retail value (Stock * Price) of one item; owner edits read it before
+    // and after the change and pass the difference to adjustInventory()
+    double stockValue(int menuID) {
+        ensureSchema();
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+            "SELECT Stock * Price AS v FROM menu WHERE MenuID = ?"));
+        pstmt->setInt(1, menuID);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        return res->next() ? static_cast<double>(res->getDouble("v")) : 0.0;
+    }
+
+    void adjustInventory(double delta) {
+        ensureSchema();
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+            "INSERT INTO margin_inventory (Id, RetailValue) VALUES (1, ?) "
+            "ON DUPLICATE KEY UPDATE RetailValue = RetailValue + VALUES(RetailValue)"));
+        pstmt->setDouble(1, delta);
+        pstmt->executeUpdate();
+    }
+
+    // Readers below take any connection so reports can run on the replica or
+    // a worker connection; ensureSchema() must have run on the primary
+
+    static MarginTotals monthToDate(sql::Connection* db) {
+        std::unique_ptr<sql::Statement> stmt(db->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT IFNULL(SUM(Revenue), 0) AS Revenue, IFNULL(SUM(Cost), 0) AS Cost, "
+            "IFNULL(SUM(Uncosted), 0) AS Uncosted FROM margin_day "
+            "WHERE SalesDate >= DATE_FORMAT(CURDATE(), '%Y-%m-01') "
+            "AND SalesDate < DATE_FORMAT(CURDATE(), '%Y-%m-01') + INTERVAL 1 MONTH"));
+        return totalsFrom(res.get());
+    }
+
+    static double inventoryValue(sql::Connection* db) {
+        std::unique_ptr<sql::Statement> stmt(db->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT RetailValue FROM margin_inventory WHERE Id = 1"));
+        return res->next() ? static_cast<double>(res->getDouble("RetailValue")) : 0.0;
+    }
+
+    static std::vector<std::pair<std::string, MarginTotals>> byCategory(sql::Connection* db) {
+        std::unique_ptr<sql::Statement> stmt(db->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT c.CategoryName, IFNULL(g.Revenue, 0) AS Revenue, IFNULL(g.Cost, 0) AS Cost, "
+            "IFNULL(g.Uncosted, 0) AS Uncosted FROM category c "
+            "LEFT JOIN margin_category g ON g.CategoryID = c.CategoryID ORDER BY Revenue DESC"));
+        std::vector<std::pair<std::string, MarginTotals>> rows;
+        while (res->next()) {
+            MarginTotals t = { 0.0, 0.0, 0.0 };
+            t.revenue = res->getDouble("Revenue");
+            t.cost = res->getDouble("Cost");
+            t.uncostedRevenue = res->getDouble("Uncosted");
+            rows.push_back(std::make_pair(std::string(res->getString("CategoryName")), t));
+        }
+        return rows;
+    }
+};
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef OPEN_ORDERS_BOARD_H
+#define OPEN_ORDERS_BOARD_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "order_events.h"
+#include "sales_rollup.h"
+
+struct OpenOrder {
+    int orderID;
+    int customerID;
+    time_t placedAt;
+    int items;
+    double total;
+};
+
+struct BoardDelta {
+    enum Kind { ADDED, REMOVED, RESYNC };
+    Kind kind;
+    uint64_t seq;
+    OpenOrder order;        // as added / as removed; empty for RESYNC
+};
+
+// Orders waiting for a rider, kept in memory from order events so riders
+// never query the database just to look. Every change gets a sequence
+// number and goes into a bounded delta log. Readers hold a cursor (the last
+// seq they saw) and either block in waitForChanges() or register a callback.
+// A cursor of 0, or one that has fallen off the log, gets a RESYNC followed
+// by the whole board as ADDED deltas.
+class OpenOrdersBoard {
+private:
+    std::map<int, OpenOrder> open;              // by OrdersID, oldest first
+    std::deque<BoardDelta> log;
+    uint64_t nextSeq = 2;                       // seq 1 stands for the initial board
+    std::map<int, std::function<void(const BoardDelta&)>> callbacks;
+    int nextCallbackID = 1;
+    size_t logLimit;
+    mutable std::mutex m;
+    std::condition_variable changed;
+
+    // Caller holds m
+    BoardDelta append(BoardDelta::Kind kind, const OpenOrder& order) {
+        BoardDelta d = { kind, nextSeq++, order };
+        log.push_back(d);
+        if (log.size() > logLimit) log.pop_front();
+        return d;
+    }
+
+    void notify(const BoardDelta& d) {
+        std::vector<std::function<void(const BoardDelta&)>> listeners;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            for (const auto& c : callbacks) listeners.push_back(c.second);
+        }
+        changed.notify_all();
+        for (const auto& listener : listeners) listener(d);
+    }
+
+    // Caller holds m
+    std::vector<BoardDelta> since(uint64_t& cursor) const {
+        std::vector<BoardDelta> out;
+        if (cursor == 0 || log.empty() || cursor + 1 < log.front().seq) {
+            BoardDelta reset = { BoardDelta::RESYNC, nextSeq - 1, OpenOrder() };
+            out.push_back(reset);
+            for (const auto& o : open) {
+                BoardDelta d = { BoardDelta::ADDED, nextSeq - 1, o.second };
+                out.push_back(d);
+            }
+        }
+        else {
+            auto first = std::upper_bound(log.begin(), log.end(), cursor,
+                [](uint64_t seq, const BoardDelta& d) { return seq < d.seq; });
+            out.assign(first, log.end());
+        }
+        cursor = nextSeq - 1;
+        return out;
+    }
+
+public:
+    OpenOrdersBoard(size_t deltaLogLimit = 4096) : logLimit(deltaLogLimit) {}
+
+    // One read at startup; afterwards the board is fed by events only.
+    // Totals use the price charged at checkout, as the events carry.
+    void seed(sql::Connection* con) {
+        SalesRollup(con).ensureSchema();        // order_item.UnitPrice
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT o.OrdersID, o.CustomerID, UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, "
+            "IFNULL(SUM(oi.Quantity), 0) AS items, IFNULL(SUM(oi.Quantity * IFNULL(oi.UnitPrice, m.Price)), 0) AS total "
+            "FROM orders o LEFT JOIN order_item oi ON oi.OrdersID = o.OrdersID "
+            "LEFT JOIN menu m ON m.MenuID = oi.MenuID "
+            "WHERE o.Orders_status IN ('Pending', 'Confirmed') AND o.DeliveryID IS NULL "
+            "GROUP BY o.OrdersID, o.CustomerID, o.OrdersDate"));
+        std::lock_guard<std::mutex> lock(m);
+        open.clear();
+        while (res->next()) {
+            OpenOrder o = { res->getInt("OrdersID"), res->getInt("CustomerID"),
+                static_cast<time_t>(res->getInt64("placedAt")), res->getInt("items"),
+                static_cast<double>(res->getDouble("total")) };
+            open[o.orderID] = o;
+        }
+        log.clear();
+        nextSeq++;              // cursors from before the reseed fall off the log
+    }
+
+    void attach(OrderEvents& events) {
+        events.onOrderPlaced([this](const OrderPlacedEvent& e) { orderPlaced(e); });
+        events.onOrderClaimed([this](const OrderClaimedEvent& e) { orderClaimed(e.orderID); });
+    }
+
+    void orderPlaced(const OrderPlacedEvent& e) {
+        OpenOrder o = { e.orderID, e.customerID, e.placedAt, 0, 0.0 };
+        for (const OrderEventLine& line : e.lines) {
+            o.items += line.quantity;
+            o.total += line.quantity * line.price;
+        }
+        BoardDelta d;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            open[o.orderID] = o;
+            d = append(BoardDelta::ADDED, o);
+        }
+        notify(d);
+    }
+
+    void orderClaimed(int orderID) {
+        BoardDelta d;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            auto it = open.find(orderID);
+            if (it == open.end()) return;
+            d = append(BoardDelta::REMOVED, it->second);
+            open.erase(it);
+        }
+        notify(d);
+    }
+
+    std::vector<OpenOrder> snapshot() const {
+        std::lock_guard<std::mutex> lock(m);
+        std::vector<OpenOrder> out;
+        for (const auto& o : open) out.push_back(o.second);
+        return out;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m);
+        return open.size();
+    }
+
+    // Deltas after `cursor`, waiting up to timeoutMs for the first one.
+    // Advances the cursor; empty on timeout.
+    std::vector<BoardDelta> waitForChanges(uint64_t& cursor, int timeoutMs) {
+        std::unique_lock<std::mutex> lock(m);
+        changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return nextSeq - 1 != cursor; });
+        if (nextSeq - 1 == cursor) return std::vector<BoardDelta>();
+        return since(cursor);
+    }
+
+    // Callbacks run on the publishing thread after the board is updated
+    int subscribe(std::function<void(const BoardDelta&)> callback) {
+        std::lock_guard<std::mutex> lock(m);
+        callbacks[nextCallbackID] = callback;
+        return nextCallbackID++;
+    }
+
+    void unsubscribe(int id) {
+        std::lock_guard<std::mutex> lock(m);
+        callbacks.erase(id);
+    }
+};
+
+#endif
@@ -1,261 +1,383 @@
-#ifndef ORDER_H
-#define ORDER_H
-
-#include <iostream>
-#include <string>
-#include <memory>
-#include <vector>
-#include <iomanip>
-#include "mysql_connection.h"
-#include <cppconn/driver.h>
-#include <cppconn/exception.h>
-#include <cppconn/statement.h>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-
-struct OrderItem {
-    int menuID;
-    int quantity;
-    double price;
-    std::string menuName;
-};
-
-class Order {
-private:
-    sql::Connection* conn;
-    std::vector<OrderItem> cart;
-
-public:
-    Order(sql::Connection* connection) : conn(connection) {}
-
-    // **UPDATED** Add to cart WITH stock validation
-    void addToCart(int menuID, int quantity, double price, std::string menuName) {
-        // Check stock availability
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("SELECT Stock FROM menu WHERE MenuID=?")
-            );
-            pstmt->setInt(1, menuID);
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-
-            if (res->next()) {
-                int availableStock = res->getInt("Stock");
-
-                if (availableStock < quantity) {
-                    std::cout << "\n[WARNING] Insufficient stock! Available: " << availableStock
-                        << " | You requested: " << quantity << std::endl;
-
-                    if (availableStock > 0) {
-                        std::cout << "Max you can add: " << availableStock << " units" << std::endl;
-                    }
-                    else {
-                        std::cout << "This item is OUT OF STOCK!" << std::endl;
-                    }
-                    return; // Don't add to cart
-                }
-
-                // Stock is sufficient, add to cart
-                OrderItem item;
-                item.menuID = menuID;
-                item.quantity = quantity;
-                item.price = price;
-                item.menuName = menuName;
-                cart.push_back(item);
-                std::cout << "\n[SUCCESS] Added " << quantity << "x " << menuName << " to cart" << std::endl;
-            }
-        }
-        catch (sql::SQLException& e) {
-            std::cerr << "Stock check failed: " << e.what() << std::endl;
-        }
-    }
-
-    void viewCart() {
-        if (cart.empty()) {
-            std::cout << "Your cart is empty!" << std::endl;
-            return;
-        }
-
-        std::cout << "\n=== Your Cart ===" << std::endl;
-        double total = 0.0;
-
-        std::cout << std::left << std::setw(10) << "Menu ID"
-            << std::setw(20) << "Name"
-            << std::setw(10) << "Qty"
-            << "Total" << std::endl;
-        std::cout << std::string(50, '-') << std::endl;
-
-        for (const auto& item : cart) {
-            double subtotal = item.price * item.quantity;
-            std::cout << std::left << std::setw(10) << item.menuID
-                << std::setw(20) << item.menuName
-                << " x" << std::setw(8) << item.quantity
-                << "RM" << std::fixed << std::setprecision(2) << subtotal << std::endl;
-            total += subtotal;
-        }
-        std::cout << std::string(50, '-') << std::endl;
-        std::cout << "Total Amount: RM" << total << std::endl;
-    }
-
-    void clearCart() {
-        cart.clear();
-        std::cout << "Cart cleared!" << std::endl;
-    }
-
-    void deleteCartItem(int menuID) {
-        bool found = false;
-        for (auto it = cart.begin(); it != cart.end(); ++it) {
-            if (it->menuID == menuID) {
-                std::cout << "\n[REMOVED] " << it->menuName << " has been removed from your cart." << std::endl;
-                cart.erase(it);
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            std::cout << "\n[ERROR] Item with ID " << menuID << " not found in your cart." << std::endl;
-        }
-    }
-
-    bool isCartEmpty() {
-        return cart.empty();
-    }
-
-    // **UPDATED** Create order WITH stock deduction
-    int createOrder(int customerID) {
-        if (cart.empty()) {
-            std::cout << "Cannot create order. Cart is empty!" << std::endl;
-            return -1;
-        }
-
-        try {
-            // STEP 1: Revalidate stock before placing order
-            for (const auto& item : cart) {
-                std::unique_ptr<sql::PreparedStatement> checkStmt(
-                    conn->prepareStatement("SELECT Stock FROM menu WHERE MenuID=?")
-                );
-                checkStmt->setInt(1, item.menuID);
-                std::unique_ptr<sql::ResultSet> res(checkStmt->executeQuery());
-
-                if (res->next()) {
-                    int currentStock = res->getInt("Stock");
-                    if (currentStock < item.quantity) {
-                        std::cout << "\n[ERROR] " << item.menuName << " no longer has sufficient stock!" << std::endl;
-                        std::cout << "Available: " << currentStock << " | Required: " << item.quantity << std::endl;
-                        std::cout << "Please update your cart before placing order." << std::endl;
-                        return -1;
-                    }
-                }
-            }
-
-            // STEP 2: Create order record
-            std::unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement("INSERT INTO orders (CustomerID, Orders_status) VALUES (?, 'Pending')")
-            );
-            pstmt->setInt(1, customerID);
-            pstmt->executeUpdate();
-
-            // Get the new order ID
-            std::unique_ptr<sql::Statement> stmt(conn->createStatement());
-            std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT LAST_INSERT_ID() as OrderID"));
-
-            int orderID = 0;
-            if (res->next()) {
-                orderID = res->getInt("OrderID");
-            }
-
-            // STEP 3: Insert order items AND deduct stock
-            for (const auto& item : cart) {
-                // Insert order item
-                std::unique_ptr<sql::PreparedStatement> itemStmt(
-                    conn->prepareStatement("INSERT INTO order_item (OrdersID, MenuID, Quantity) VALUES (?, ?, ?)")
-                );
-                itemStmt->setInt(1, orderID);
-                itemStmt->setInt(2, item.menuID);
-                itemStmt->setInt(3, item.quantity);
-                itemStmt->executeUpdate();
-
-                // Deduct stock
-                std::unique_ptr<sql::PreparedStatement> stockStmt(
-                    conn->prepareStatement("UPDATE menu SET Stock = Stock - ? WHERE MenuID=?")
-                );
-                stockStmt->setInt(1, item.quantity);
-                stockStmt->setInt(2, item.menuID);
-                stockStmt->executeUpdate();
-
-                std::cout << "[INFO] Deducted " << item.quantity << " units from " << item.menuName << std::endl;
-            }
-
-            std::cout << "\n[SUCCESS] Order created successfully! Order ID: " << orderID << std::endl;
-            return orderID;
-        }
-        catch (sql::SQLException& e) {
-            std::cerr << "Order creation failed: " << e.what() << std::endl;
-            return -1;
-        }
-    }
-
-    void viewOrderHistory(int customerID) {
-        try {
-            std::unique_ptr<sql::PreparedStatement> pstmt(
-                conn->prepareStatement(
-                    "SELECT o.OrdersID, o.OrdersDate, o.Orders_status, "
-                    "COALESCE(d.Rider_Name, 'Not Assigned') as RiderName "
-                    "FROM orders o LEFT JOIN delivery d ON o.DeliveryID = d.DeliveryID "
-                    "WHERE o.CustomerID=? ORDER BY o.OrdersDate DESC"
-                )
-            );
-            pstmt->setInt(1, customerID);
-
-            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
-
-            std::cout << "\n=== Order History ===" << std::endl;
-            while (res->next()) {
-                int orderID = res->getInt("OrdersID");
-                std::cout << "Order ID: " << orderID << std::endl;
-                std::cout << "Date: " << res->getString("OrdersDate") << std::endl;
-                std::cout << "Status: " << res->getString("Orders_status") << std::endl;
-                std::cout << "Rider: " << res->getString("RiderName") << std::endl;
-
-                std::unique_ptr<sql::PreparedStatement> itemStmt(
-                    conn->prepareStatement(
-                        "SELECT m.Menu_Name, oi.Quantity, m.Price "
-                        "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID "
-                        "WHERE oi.OrdersID=?"
-                    )
-                );
-                itemStmt->setInt(1, orderID);
-
-                std::unique_ptr<sql::ResultSet> itemRes(itemStmt->executeQuery());
-
-                double total = 0.0;
-                std::cout << "Items:" << std::endl;
-                while (itemRes->next()) {
-                    double subtotal = itemRes->getDouble("Price") * itemRes->getInt("Quantity");
-                    std::cout << "  - " << itemRes->getString("Menu_Name")
-                        << " x" << itemRes->getInt("Quantity")
-                        << " = RM" << std::fixed << std::setprecision(2) << subtotal << std::endl;
-                    total += subtotal;
-                }
-                std::cout << "Total: RM" << std::fixed << std::setprecision(2) << total << std::endl;
-                std::cout << std::string(50, '-') << std::endl;
-            }
-        }
-        catch (sql::SQLException& e) {
-            std::cerr << "Query failed: " << e.what() << std::endl;
-        }
-    }
-
-    double getCartTotal() {
-        double total = 0.0;
-        for (const auto& item : cart) {
-            total += item.price * item.quantity;
-        }
-        return total;
-    }
-
-    int getCartSize() {
-        return cart.size();
-    }
-};
-
+#ifndef ORDER_H
+#define ORDER_H
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <vector>
+#include <iomanip>
+#include <algorithm>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include <cppconn/statement.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include "sales_rollup.h"
+#include "margin_engine.h"
+#include "payment.h"
+#include "order_events.h"
+#include "eta.h"
+#include "location.h"
+
+struct OrderItem {
+    int menuID;
+    int quantity;
+    double price;
+    std::string menuName;
+};
+
+class Order {
+private:
+    sql::Connection* conn;
+    std::vector<OrderItem> cart;
+    SalesRollup rollup;
+    MarginEngine margins;
+    OrderEvents* events = nullptr;
+    EtaModel* etaModel = nullptr;
+    LocationService* locations = nullptr;
+    GeocodeTable geocodes;
+    bool geocodesLoaded = false;
+
+public:
+    Order(sql::Connection* connection) : conn(connection), rollup(connection), margins(connection) {}
+
+    void setEventBus(OrderEvents* bus) { events = bus; }
+
+    // Open orders in the history view show a live ETA
+    void setEtaModel(EtaModel* model) { etaModel = model; }
+
+    // Riders' live positions, for trackMyRider()
+    void setLocationService(LocationService* service) { locations = service; }
+
+    // **UPDATED** Add to cart WITH stock validation
+    void addToCart(int menuID, int quantity, double price, std::string menuName) {
+        // Check stock availability
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(
+                conn->prepareStatement("SELECT Stock FROM menu WHERE MenuID=?")
+            );
+            pstmt->setInt(1, menuID);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+            if (res->next()) {
+                int availableStock = res->getInt("Stock");
+
+                if (availableStock < quantity) {
+                    std::cout << "\n[WARNING] Insufficient stock! Available: " << availableStock
+                        << " | You requested: " << quantity << std::endl;
+
+                    if (availableStock > 0) {
+                        std::cout << "Max you can add: " << availableStock << " units" << std::endl;
+                    }
+                    else {
+                        std::cout << "This item is OUT OF STOCK!" << std::endl;
+                    }
+                    return; // Don't add to cart
+                }
+
+                // Stock is sufficient, add to cart
+                OrderItem item;
+                item.menuID = menuID;
+                item.quantity = quantity;
+                item.price = price;
+                item.menuName = menuName;
+                cart.push_back(item);
+                std::cout << "\n[SUCCESS] Added " << quantity << "x " << menuName << " to cart" << std::endl;
+            }
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Stock check failed: " << e.what() << std::endl;
+        }
+    }
+
+    void viewCart() {
+        if (cart.empty()) {
+            std::cout << "Your cart is empty!" << std::endl;
+            return;
+        }
+
+        std::cout << "\n=== Your Cart ===" << std::endl;
+        double total = 0.0;
+
+        std::cout << std::left << std::setw(10) << "Menu ID"
+            << std::setw(20) << "Name"
+            << std::setw(10) << "Qty"
+            << "Total" << std::endl;
+        std::cout << std::string(50, '-') << std::endl;
+
+        for (const auto& item : cart) {
+            double subtotal = item.price * item.quantity;
+            std::cout << std::left << std::setw(10) << item.menuID
+                << std::setw(20) << item.menuName
+                << " x" << std::setw(8) << item.quantity
+                << "RM" << std::fixed << std::setprecision(2) << subtotal << std::endl;
+            total += subtotal;
+        }
+        std::cout << std::string(50, '-') << std::endl;
+        std::cout << "Total Amount: RM" << total << std::endl;
+    }
+
+    void clearCart() {
+        cart.clear();
+        std::cout << "Cart cleared!" << std::endl;
+    }
+
+    void deleteCartItem(int menuID) {
+        bool found = false;
+        for (auto it = cart.begin(); it != cart.end(); ++it) {
+            if (it->menuID == menuID) {
+                std::cout << "\n[REMOVED] " << it->menuName << " has been removed from your cart." << std::endl;
+                cart.erase(it);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            std::cout << "\n[ERROR] Item with ID " << menuID << " not found in your cart." << std::endl;
+        }
+    }
+
+    bool isCartEmpty() {
+        return cart.empty();
+    }
+
+    // **UPDATED** Create order WITH stock deduction. With a payment the order,
+    // its items, stock, payment and rollups commit or roll back together.
+    int createOrder(int customerID, Payment* payment = nullptr, const std::string& paymentMethod = "") {
+        if (cart.empty()) {
+            std::cout << "Cannot create order. Cart is empty!" << std::endl;
+            return -1;
+        }
+
+        try {
+            // STEP 1: Revalidate stock before placing order
+            for (const auto& item : cart) {
+                std::unique_ptr<sql::PreparedStatement> checkStmt(
+                    conn->prepareStatement("SELECT Stock FROM menu WHERE MenuID=?")
+                );
+                checkStmt->setInt(1, item.menuID);
+                std::unique_ptr<sql::ResultSet> res(checkStmt->executeQuery());
+
+                if (res->next()) {
+                    int currentStock = res->getInt("Stock");
+                    if (currentStock < item.quantity) {
+                        std::cout << "\n[ERROR] " << item.menuName << " no longer has sufficient stock!" << std::endl;
+                        std::cout << "Available: " << currentStock << " | Required: " << item.quantity << std::endl;
+                        std::cout << "Please update your cart before placing order." << std::endl;
+                        return -1;
+                    }
+                }
+            }
+
+            // STEP 2: Create order record (order, items, stock, payment and rollups commit together)
+            rollup.ensureSchema();
+            margins.ensureSchema();
+            conn->setAutoCommit(false);
+            std::unique_ptr<sql::PreparedStatement> pstmt(
+                conn->prepareStatement("INSERT INTO orders (CustomerID, Orders_status) VALUES (?, 'Pending')")
+            );
+            pstmt->setInt(1, customerID);
+            pstmt->executeUpdate();
+
+            // Get the new order ID
+            std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+            std::unique_ptr<sql::ResultSet> res(stmt->executeQuery("SELECT LAST_INSERT_ID() as OrderID"));
+
+            int orderID = 0;
+            if (res->next()) {
+                orderID = res->getInt("OrderID");
+            }
+
+            // STEP 3: Insert order items AND deduct stock
+            for (const auto& item : cart) {
+                // Insert order item
+                std::unique_ptr<sql::PreparedStatement> itemStmt(
+                    conn->prepareStatement("INSERT INTO order_item (OrdersID, MenuID, Quantity, UnitPrice) VALUES (?, ?, ?, ?)")
+                );
+                itemStmt->setInt(1, orderID);
+                itemStmt->setInt(2, item.menuID);
+                itemStmt->setInt(3, item.quantity);
+                itemStmt->setDouble(4, item.price);
+                itemStmt->executeUpdate();
+
+                // Deduct stock
+                std::unique_ptr<sql::PreparedStatement> stockStmt(
+                    conn->prepareStatement("UPDATE menu SET Stock = Stock - ? WHERE MenuID=?")
+                );
+                stockStmt->setInt(1, item.quantity);
+                stockStmt->setInt(2, item.menuID);
+                stockStmt->executeUpdate();
+
+                std::cout << "[INFO] Deducted " << item.quantity << " units from " << item.menuName << std::endl;
+            }
+
+            // STEP 4: Sales rollups and cost of goods for the owner reports
+            std::vector<RollupLine> lines;
+            for (const auto& item : cart) {
+                RollupLine line = { item.menuID, item.quantity, item.price };
+                lines.push_back(line);
+            }
+            rollup.recordOrder(lines);
+            margins.recordOrder(lines);
+
+            // STEP 5: Payment
+            if (payment) payment->insertPayment(orderID, paymentMethod, getCartTotal());
+
+            conn->commit();
+            conn->setAutoCommit(true);
+
+            if (events) {
+                OrderPlacedEvent placed = { orderID, customerID, time(nullptr), {} };
+                for (const auto& item : cart) {
+                    OrderEventLine line = { item.menuID, item.quantity, item.price, item.menuName };
+                    placed.lines.push_back(line);
+                }
+                events->publish(placed);
+            }
+            if (payment) payment->paymentCommitted(orderID, paymentMethod, getCartTotal());
+
+            std::cout << "\n[SUCCESS] Order created successfully! Order ID: " << orderID << std::endl;
+            return orderID;
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Order creation failed: " << e.what() << std::endl;
+            try {
+                if (!conn->getAutoCommit()) {
+                    conn->rollback();
+                    conn->setAutoCommit(true);
+                }
+            }
+            catch (sql::SQLException&) {}
+            return -1;
+        }
+    }
+
+    void viewOrderHistory(int customerID) {
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(
+                conn->prepareStatement(
+                    "SELECT o.OrdersID, o.OrdersDate, o.Orders_status, "
+                    "COALESCE(d.Rider_Name, 'Not Assigned') as RiderName "
+                    "FROM orders o LEFT JOIN delivery d ON o.DeliveryID = d.DeliveryID "
+                    "WHERE o.CustomerID=? ORDER BY o.OrdersDate DESC"
+                )
+            );
+            pstmt->setInt(1, customerID);
+
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+            std::cout << "\n=== Order History ===" << std::endl;
+            while (res->next()) {
+                int orderID = res->getInt("OrdersID");
+                std::cout << "Order ID: " << orderID << std::endl;
+                std::cout << "Date: " << res->getString("OrdersDate") << std::endl;
+                std::string status = res->getString("Orders_status");
+                std::cout << "Status: " << status << std::endl;
+                std::cout << "Rider: " << res->getString("RiderName") << std::endl;
+                if (etaModel && status != "Completed") {
+                    EtaEstimate eta = etaModel->estimate(orderID);
+                    std::cout << "Estimated arrival: " << eta.lowMinutes << "-" << eta.highMinutes << " minutes from now" << std::endl;
+                }
+
+                std::unique_ptr<sql::PreparedStatement> itemStmt(
+                    conn->prepareStatement(
+                        "SELECT m.Menu_Name, oi.Quantity, m.Price "
+                        "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID "
+                        "WHERE oi.OrdersID=?"
+                    )
+                );
+                itemStmt->setInt(1, orderID);
+
+                std::unique_ptr<sql::ResultSet> itemRes(itemStmt->executeQuery());
+
+                double total = 0.0;
+                std::cout << "Items:" << std::endl;
+                while (itemRes->next()) {
+                    double subtotal = itemRes->getDouble("Price") * itemRes->getInt("Quantity");
+                    std::cout << "  - " << itemRes->getString("Menu_Name")
+                        << " x" << itemRes->getInt("Quantity")
+                        << " = RM" << std::fixed << std::setprecision(2) << subtotal << std::endl;
+                    total += subtotal;
+                }
+                std::cout << "Total: RM" << std::fixed << std::setprecision(2) << total << std::endl;
+                std::cout << std::string(50, '-') << std::endl;
+            }
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Query failed: " << e.what() << std::endl;
+        }
+    }
+
+    // Where the riders carrying this customer's open orders are right now.
+    // Positions come from memory; only the order list is read.
+    void trackMyRider(int customerID) {
+        if (!locations) {
+            std::cout << "Live tracking is not available." << std::endl;
+            return;
+        }
+        try {
+            std::unique_ptr<sql::PreparedStatement> pstmt(
+                conn->prepareStatement(
+                    "SELECT o.OrdersID, o.Orders_status, o.DeliveryID, d.Rider_Name, c.Customer_Address "
+                    "FROM orders o JOIN delivery d ON o.DeliveryID = d.DeliveryID "
+                    "JOIN customer c ON c.CustomerID = o.CustomerID "
+                    "WHERE o.CustomerID=? AND o.Orders_status <> 'Completed' ORDER BY o.OrdersID"
+                )
+            );
+            pstmt->setInt(1, customerID);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+            std::cout << "\n=== Track My Rider ===" << std::endl;
+            int count = 0;
+            while (res->next()) {
+                count++;
+                int orderID = res->getInt("OrdersID");
+                std::cout << "Order ID: " << orderID << " (" << res->getString("Orders_status") << ")" << std::endl;
+                std::cout << "Rider: " << res->getString("Rider_Name") << std::endl;
+
+                LocationPing ping = {};
+                if (!locations->latest(res->getInt("DeliveryID"), ping)) {
+                    std::cout << "Position: not shared yet" << std::endl;
+                }
+                else {
+                    long long ageSeconds = std::max<long long>(0, (LocationService::nowMs() - ping.atMs) / 1000);
+                    std::cout << "Position: " << std::fixed << std::setprecision(5) << ping.lat << ", " << ping.lng
+                        << " (" << ageSeconds << " s ago)" << std::endl;
+                    if (!geocodesLoaded) {
+                        geocodes.load(conn);
+                        geocodesLoaded = true;
+                    }
+                    GeoPoint dropoff;
+                    if (geocodes.locate(res->getString("Customer_Address"), dropoff)) {
+                        GeoPoint at = { ping.lat, ping.lng };
+                        std::cout << "Distance to you: " << std::setprecision(1) << distanceMeters(at, dropoff) / 1000.0 << " km" << std::endl;
+                    }
+                }
+                if (etaModel) {
+                    EtaEstimate eta = etaModel->estimate(orderID, res->getString("Customer_Address"));
+                    std::cout << "Estimated arrival: " << eta.lowMinutes << "-" << eta.highMinutes << " minutes from now" << std::endl;
+                }
+                std::cout << std::string(50, '-') << std::endl;
+            }
+            if (count == 0) std::cout << "None of your orders is with a rider right now." << std::endl;
+        }
+        catch (sql::SQLException& e) {
+            std::cerr << "Query failed: " << e.what() << std::endl;
+        }
+    }
+
+    double getCartTotal() {
+        double total = 0.0;
+        for (const auto& item : cart) {
+            total += item.price * item.quantity;
+        }
+        return total;
+    }
+
+    int getCartSize() {
+        return cart.size();
+    }
+};
+
 #endif
\ No newline at end of file
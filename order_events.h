@@ -0,0 +1,91 @@
+#ifndef ORDER_EVENTS_H
+#define ORDER_EVENTS_H
+
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+// In-process notifications for committed checkout and delivery activity.
+// Order / Payment / Delivery / DispatchEngine publish after their write
+// commits; in-memory trackers subscribe in main() instead of re-reading the
+// tables. Listeners run synchronously on the publishing thread, which may be
+// the dispatcher's worker, so they must be thread-safe.
+struct OrderEventLine {
+    int menuID;
+    int quantity;
+    double price;
+    std::string menuName;
+};
+
+struct OrderPlacedEvent {
+    int orderID;
+    int customerID;
+    time_t placedAt;
+    std::vector<OrderEventLine> lines;
+};
+
+struct PaymentEvent {
+    int orderID;
+    double amount;
+    std::string paymentMethod;
+    time_t paidAt;
+};
+
+// A rider (or the dispatcher on their behalf) took an open order
+struct OrderClaimedEvent {
+    int orderID;
+    int riderID;
+    time_t claimedAt;
+};
+
+// A rider moved an order on ('Preparing', 'Out for Delivery', 'Arrived',
+// 'Completed')
+struct OrderStatusEvent {
+    int orderID;
+    std::string status;
+    time_t changedAt;
+};
+
+class OrderEvents {
+private:
+    std::vector<std::function<void(const OrderPlacedEvent&)>> orderListeners;
+    std::vector<std::function<void(const PaymentEvent&)>> paymentListeners;
+    std::vector<std::function<void(const OrderClaimedEvent&)>> claimListeners;
+    std::vector<std::function<void(const OrderStatusEvent&)>> statusListeners;
+
+public:
+    void onOrderPlaced(std::function<void(const OrderPlacedEvent&)> listener) {
+        orderListeners.push_back(listener);
+    }
+
+    void onPayment(std::function<void(const PaymentEvent&)> listener) {
+        paymentListeners.push_back(listener);
+    }
+
+    void onOrderClaimed(std::function<void(const OrderClaimedEvent&)> listener) {
+        claimListeners.push_back(listener);
+    }
+
+    void onStatusChanged(std::function<void(const OrderStatusEvent&)> listener) {
+        statusListeners.push_back(listener);
+    }
+
+    void publish(const OrderPlacedEvent& event) const {
+        for (const auto& listener : orderListeners) listener(event);
+    }
+
+    void publish(const PaymentEvent& event) const {
+        for (const auto& listener : paymentListeners) listener(event);
+    }
+
+    void publish(const OrderClaimedEvent& event) const {
+        for (const auto& listener : claimListeners) listener(event);
+    }
+
+    void publish(const OrderStatusEvent& event) const {
+        for (const auto& listener : statusListeners) listener(event);
+    }
+};
+
+#endif
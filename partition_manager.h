@@ -0,0 +1,415 @@
+#ifndef PARTITION_MANAGER_H
+#define PARTITION_MANAGER_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+
+struct PartitionInfo {
+    std::string name;           // pYYYYMM, or pfuture for the MAXVALUE catch-all
+    int month;                  // YYYYMM of the rows it was created for, 0 for pfuture
+    long long rows;             // InnoDB estimate from information_schema
+};
+
+// Monthly RANGE partitioning of the history tables (orders, order_item,
+// payment, receipt_history) on their date column. Each month lives in its
+// own pYYYYMM partition, so date-range filters prune to the months they
+// touch and retention drops whole partitions instead of deleting rows.
+//
+// MySQL only allows this when the partition column is part of every unique
+// key and no foreign key points to or from the table, so migrate() appends
+// the date column to the primary key and drops those foreign keys. Nothing
+// is lost at checkout, where Order::createOrder writes the order, its items
+// and its payment in one transaction. order_item and payment have no date of
+// their own, so they get a copy of their order's OrdersDate, kept by an
+// insert trigger; all three tables then split at the same instant and
+// retireBefore() removes an order together with its items, its payment and
+// the rows that refer to it (delivery events, per-day rollups, GPS points).
+// Migration is an explicit owner action; maintain() keeps a few empty
+// months ahead of the clock so inserts never land in pfuture.
+class PartitionManager {
+private:
+    sql::Connection* con;
+
+    struct ManagedTable {
+        const char* table;
+        const char* column;
+        const char* addColumn;      // DDL when the table has no date column yet
+        const char* backfill;       // fills that column for existing rows
+        const char* trigger;        // name of the insert trigger that copies the order's date
+        const char* staleColumn;    // earlier partition column to retire, if any
+    };
+
+    static const std::vector<ManagedTable>& managed() {
+        static const std::vector<ManagedTable> tables = {
+            { "orders", "OrdersDate", nullptr, nullptr, nullptr, nullptr },
+            { "order_item", "OrdersDate",
+                "ALTER TABLE order_item ADD COLUMN OrdersDate DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP",
+                "UPDATE order_item oi JOIN orders o ON o.OrdersID = oi.OrdersID SET oi.OrdersDate = o.OrdersDate",
+                "order_item_orders_date", nullptr },
+            { "payment", "OrdersDate",
+                "ALTER TABLE payment ADD COLUMN OrdersDate DATETIME NOT NULL DEFAULT CURRENT_TIMESTAMP",
+                "UPDATE payment p JOIN orders o ON o.OrdersID = p.OrdersID SET p.OrdersDate = o.OrdersDate",
+                "payment_orders_date", "CreatedDate" },
+            { "receipt_history", "GeneratedDate", nullptr, nullptr, nullptr, nullptr }
+        };
+        return tables;
+    }
+
+    static const ManagedTable* find(const std::string& table) {
+        for (const ManagedTable& t : managed()) {
+            if (table == t.table) return &t;
+        }
+        return nullptr;
+    }
+
+    // YYYYMM <-> months since year 0, for stepping across year ends
+    static int toIndex(int month) { return (month / 100) * 12 + (month % 100 - 1); }
+    static int fromIndex(int index) { return (index / 12) * 100 + index % 12 + 1; }
+
+    static std::string partitionName(int month) { return "p" + std::to_string(month); }
+
+    // 'YYYY-MM-01' for a YYYYMM month
+    static std::string monthStart(int month) {
+        char date[32];          // room for any two ints, so the output is never cut
+        snprintf(date, sizeof(date), "%04d-%02d-01", month / 100, month % 100);
+        return date;
+    }
+
+    // Upper bound of a month's partition: the first instant of the next month.
+    // TIMESTAMP columns can only be partitioned on UNIX_TIMESTAMP().
+    static std::string upperBound(int month, bool timestamp) {
+        std::string date = monthStart(fromIndex(toIndex(month) + 1));
+        return timestamp ? "UNIX_TIMESTAMP('" + date + " 00:00:00')" : "TO_DAYS('" + date + "')";
+    }
+
+    static std::string partitionList(int firstMonth, int lastMonth, bool timestamp) {
+        std::string sql;
+        for (int i = toIndex(firstMonth); i <= toIndex(lastMonth); i++) {
+            int month = fromIndex(i);
+            sql += "PARTITION " + partitionName(month) + " VALUES LESS THAN (" + upperBound(month, timestamp) + "), ";
+        }
+        return sql + "PARTITION pfuture VALUES LESS THAN MAXVALUE";
+    }
+
+    std::string columnInfo(const std::string& table, const std::string& column, const char* field) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            std::string("SELECT ") + field + " AS v FROM information_schema.COLUMNS "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND COLUMN_NAME = ?"));
+        pstmt->setString(1, table);
+        pstmt->setString(2, column);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        return res->next() ? std::string(res->getString("v")) : std::string();
+    }
+
+    void execute(const std::string& sql) {
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        stmt->execute(sql);
+    }
+
+    // Rows inserted without the date take their order's OrdersDate, so a row
+    // written a moment after its order can't land in the next month
+    void ensureDateTrigger(const ManagedTable& t) {
+        if (!t.trigger) return;
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT COUNT(*) AS n FROM information_schema.TRIGGERS "
+            "WHERE TRIGGER_SCHEMA = DATABASE() AND TRIGGER_NAME = ?"));
+        pstmt->setString(1, t.trigger);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        if (res->next() && res->getInt("n") > 0) return;
+        execute(std::string("CREATE TRIGGER `") + t.trigger + "` BEFORE INSERT ON `" + t.table + "` FOR EACH ROW "
+            "SET NEW.`" + t.column + "` = IFNULL((SELECT OrdersDate FROM orders WHERE OrdersID = NEW.OrdersID), NEW.`"
+            + t.column + "`)");
+    }
+
+    std::string partitionExpression(const std::string& table) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT PARTITION_EXPRESSION AS e FROM information_schema.PARTITIONS "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND PARTITION_NAME IS NOT NULL LIMIT 1"));
+        pstmt->setString(1, table);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+        return res->next() ? std::string(res->getString("e")) : std::string();
+    }
+
+    // Drops every foreign key on the table and every one referencing it (a
+    // partitioned InnoDB table can have neither). Returns "table.key" names.
+    std::vector<std::string> dropForeignKeys(const std::string& table) {
+        std::vector<std::pair<std::string, std::string>> keys;
+        {
+            std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+                "SELECT TABLE_NAME, CONSTRAINT_NAME FROM information_schema.REFERENTIAL_CONSTRAINTS "
+                "WHERE CONSTRAINT_SCHEMA = DATABASE() AND (TABLE_NAME = ? OR REFERENCED_TABLE_NAME = ?)"));
+            pstmt->setString(1, table);
+            pstmt->setString(2, table);
+            std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+            while (res->next()) keys.push_back(std::make_pair(res->getString("TABLE_NAME"), res->getString("CONSTRAINT_NAME")));
+        }
+        std::vector<std::string> dropped;
+        for (const auto& key : keys) {
+            execute("ALTER TABLE `" + key.first + "` DROP FOREIGN KEY `" + key.second + "`");
+            dropped.push_back(key.first + "." + key.second);
+        }
+        return dropped;
+    }
+
+    // Primary key columns in key order; `uniqueWithoutDate` is set when some
+    // other unique index lacks the date column (those cannot be partitioned)
+    std::vector<std::string> primaryKey(const std::string& table, const std::string& column, std::string& uniqueWithoutDate) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT INDEX_NAME, COLUMN_NAME FROM information_schema.STATISTICS "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND NON_UNIQUE = 0 "
+            "ORDER BY INDEX_NAME, SEQ_IN_INDEX"));
+        pstmt->setString(1, table);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+        std::vector<std::string> pk;
+        std::string index;
+        bool hasDate = true;
+        uniqueWithoutDate.clear();
+        while (res->next()) {
+            std::string name = res->getString("INDEX_NAME");
+            if (name != index) {
+                if (!index.empty() && index != "PRIMARY" && !hasDate) uniqueWithoutDate = index;
+                index = name;
+                hasDate = false;
+            }
+            std::string col = res->getString("COLUMN_NAME");
+            if (col == column) hasDate = true;
+            if (name == "PRIMARY") pk.push_back(col);
+        }
+        if (!index.empty() && index != "PRIMARY" && !hasDate) uniqueWithoutDate = index;
+        return pk;
+    }
+
+public:
+    explicit PartitionManager(sql::Connection* connection) : con(connection) {}
+
+    static std::vector<std::string> tables() {
+        std::vector<std::string> names;
+        for (const ManagedTable& t : managed()) names.push_back(t.table);
+        return names;
+    }
+
+    static std::string dateColumn(const std::string& table) {
+        const ManagedTable* t = find(table);
+        return t ? t->column : "";
+    }
+
+    // YYYYMM of the local month `offset` months from now
+    static int monthFromNow(int offset) {
+        time_t now = time(nullptr);
+        tm t = {};
+#ifdef _WIN32
+        localtime_s(&t, &now);
+#else
+        localtime_r(&now, &t);
+#endif
+        return fromIndex(toIndex((t.tm_year + 1900) * 100 + t.tm_mon + 1) + offset);
+    }
+
+    std::vector<PartitionInfo> partitions(const std::string& table) {
+        std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+            "SELECT PARTITION_NAME, TABLE_ROWS FROM information_schema.PARTITIONS "
+            "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ? AND PARTITION_NAME IS NOT NULL "
+            "ORDER BY PARTITION_ORDINAL_POSITION"));
+        pstmt->setString(1, table);
+        std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+        std::vector<PartitionInfo> result;
+        while (res->next()) {
+            PartitionInfo p;
+            p.name = res->getString("PARTITION_NAME");
+            p.month = (p.name.size() == 7 && p.name[0] == 'p') ? std::atoi(p.name.c_str() + 1) : 0;
+            p.rows = res->getInt64("TABLE_ROWS");
+            result.push_back(p);
+        }
+        return result;
+    }
+
+    bool isPartitioned(const std::string& table) { return !partitions(table).empty(); }
+
+    // Converts one table to monthly partitions covering its oldest row up to
+    // monthsAhead months from now. Returns false (with `error`) if the table
+    // cannot be partitioned as it stands. Foreign keys removed on the way are
+    // appended to `droppedKeys`.
+    bool migrate(const std::string& table, int monthsAhead, std::string& error,
+        std::vector<std::string>* droppedKeys = nullptr) {
+        const ManagedTable* t = find(table);
+        if (!t) {
+            error = table + " is not a managed history table";
+            return false;
+        }
+        std::string column = t->column;
+        if (isPartitioned(table)) {
+            // Tables partitioned on an earlier column are partitioned again
+            if (partitionExpression(table).find(column) != std::string::npos) {
+                ensureDateTrigger(*t);
+                return true;
+            }
+            execute("ALTER TABLE `" + table + "` REMOVE PARTITIONING");
+        }
+
+        if (!columnExists(con, table, column)) {
+            execute(t->addColumn);
+            execute(t->backfill);
+        }
+        ensureDateTrigger(*t);
+
+        std::string uniqueWithoutDate;
+        std::vector<std::string> pk = primaryKey(table, column, uniqueWithoutDate);
+        if (!uniqueWithoutDate.empty()) {
+            error = "unique index " + uniqueWithoutDate + " does not include " + column;
+            return false;
+        }
+        {
+            std::unique_ptr<sql::Statement> stmt(con->createStatement());
+            std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+                "SELECT COUNT(*) AS n FROM `" + table + "` WHERE `" + column + "` IS NULL"));
+            if (res->next() && res->getInt64("n") > 0) {
+                error = std::to_string(res->getInt64("n")) + " rows have no " + column;
+                return false;
+            }
+        }
+
+        std::vector<std::string> keys = dropForeignKeys(table);
+        if (droppedKeys) droppedKeys->insert(droppedKeys->end(), keys.begin(), keys.end());
+
+        // The partition column must be NOT NULL and part of the primary key;
+        // the existing key columns stay first so lookups by ID still use it
+        std::string type = columnInfo(table, column, "COLUMN_TYPE");
+        std::string dataType = columnInfo(table, column, "DATA_TYPE");
+        bool timestamp = dataType == "timestamp";
+        std::string alter = "ALTER TABLE `" + table + "` MODIFY `" + column + "` " + type + " NOT NULL"
+            + (dataType == "date" ? "" : " DEFAULT CURRENT_TIMESTAMP");
+        bool pkHasDate = false, pkHasStale = false;
+        for (const std::string& c : pk) {
+            pkHasDate = pkHasDate || c == column;
+            pkHasStale = pkHasStale || (t->staleColumn && c == t->staleColumn);
+        }
+        if (!pk.empty() && (!pkHasDate || pkHasStale)) {
+            alter += ", DROP PRIMARY KEY, ADD PRIMARY KEY (";
+            for (const std::string& c : pk) {
+                if (c != column && !(t->staleColumn && c == t->staleColumn)) alter += "`" + c + "`, ";
+            }
+            alter += "`" + column + "`)";
+        }
+        if (t->staleColumn && columnExists(con, table, t->staleColumn)) {
+            alter += std::string(", DROP COLUMN `") + t->staleColumn + "`";
+        }
+        execute(alter);
+
+        int oldest = monthFromNow(0);
+        {
+            std::unique_ptr<sql::Statement> stmt(con->createStatement());
+            std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+                "SELECT DATE_FORMAT(MIN(`" + column + "`), '%Y%m') AS m FROM `" + table + "`"));
+            if (res->next() && !res->isNull("m")) oldest = std::atoi(std::string(res->getString("m")).c_str());
+        }
+        if (oldest > monthFromNow(0)) oldest = monthFromNow(0);
+
+        std::string expr = timestamp ? "UNIX_TIMESTAMP(`" + column + "`)" : "TO_DAYS(`" + column + "`)";
+        execute("ALTER TABLE `" + table + "` PARTITION BY RANGE (" + expr + ") ("
+            + partitionList(oldest, monthFromNow(monthsAhead), timestamp) + ")");
+        return true;
+    }
+
+    // Splits pfuture so every partitioned table has a partition for each
+    // month through monthsAhead months from now. Returns partitions added.
+    int maintain(int monthsAhead = 3) {
+        int added = 0;
+        int target = monthFromNow(monthsAhead);
+        for (const ManagedTable& t : managed()) {
+            std::vector<PartitionInfo> parts = partitions(t.table);
+            if (parts.empty()) continue;
+
+            int last = 0;
+            for (const PartitionInfo& p : parts) {
+                if (p.month > last) last = p.month;
+            }
+            int first = last ? fromIndex(toIndex(last) + 1) : monthFromNow(0);
+            if (toIndex(first) > toIndex(target)) continue;
+
+            bool timestamp = columnInfo(t.table, t.column, "DATA_TYPE") == "timestamp";
+            execute(std::string("ALTER TABLE `") + t.table + "` REORGANIZE PARTITION pfuture INTO ("
+                + partitionList(first, target, timestamp) + ")");
+            added += toIndex(target) - toIndex(first) + 1;
+        }
+        return added;
+    }
+
+    // Retention: drops the month partitions of `table` older than
+    // `beforeMonth` (YYYYMM). Returns the (estimated) rows removed.
+    long long dropBefore(const std::string& table, int beforeMonth) {
+        std::string names;
+        long long rows = 0;
+        for (const PartitionInfo& p : partitions(table)) {
+            if (p.month == 0 || p.month >= beforeMonth) continue;
+            if (!names.empty()) names += ", ";
+            names += p.name;
+            rows += p.rows;
+        }
+        if (!names.empty()) execute("ALTER TABLE `" + table + "` DROP PARTITION " + names);
+        return rows;
+    }
+
+    // Order retention. With the foreign keys gone nothing cascades, so the
+    // rows that refer to old orders are deleted first: their delivery_event
+    // history, the per-day sales, margin and rider rollups for those days and
+    // rider GPS points recorded before the cutoff. Then the order_item,
+    // payment and orders partitions before `beforeMonth` are dropped.
+    // All-time totals (sales_rollup_item/category/hour, margin_item/category)
+    // are kept and still include the retired orders; receipts are archived
+    // separately. Returns the (estimated) order/item/payment rows dropped
+    // and, in `dependentRows`, the dependent rows deleted.
+    long long retireBefore(int beforeMonth, long long& dependentRows) {
+        std::string cutoff = monthStart(beforeMonth);
+        dependentRows = 0;
+
+        auto purge = [&](const char* table, const std::string& sql) {
+            if (!tableExists(con, table)) return;
+            std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(sql));
+            pstmt->setString(1, cutoff);
+            dependentRows += pstmt->executeUpdate();
+        };
+        purge("delivery_event",
+            "DELETE e FROM delivery_event e JOIN orders o ON o.OrdersID = e.OrdersID WHERE o.OrdersDate < ?");
+        purge("sales_rollup_day", "DELETE FROM sales_rollup_day WHERE SalesDate < ?");
+        purge("margin_day", "DELETE FROM margin_day WHERE SalesDate < ?");
+        purge("rider_rollup_day", "DELETE FROM rider_rollup_day WHERE StatDate < ?");
+        purge("rider_rollup_drop", "DELETE FROM rider_rollup_drop WHERE StatDate < ?");
+        purge("rider_location", "DELETE FROM rider_location WHERE RecordedAt < ?");
+
+        long long rows = 0;
+        const char* history[] = { "order_item", "payment", "orders" };
+        for (const char* table : history) rows += dropBefore(table, beforeMonth);
+        return rows;
+    }
+
+    // Drops the partition of one month if it holds exactly `expectedRows`
+    // rows, i.e. nothing but what the caller has already copied elsewhere
+    bool dropMonthIfExactly(const std::string& table, int month, long long expectedRows) {
+        std::string name = partitionName(month);
+        bool found = false;
+        for (const PartitionInfo& p : partitions(table)) found = found || p.name == name;
+        if (!found) return false;
+
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT COUNT(*) AS n FROM `" + table + "` PARTITION (" + name + ")"));
+        if (!res->next() || res->getInt64("n") != expectedRows) return false;
+        execute("ALTER TABLE `" + table + "` DROP PARTITION " + name);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef QUERY_ROUTER_H
+#define QUERY_ROUTER_H
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+
+// Chooses the connection for each read. Staleness-tolerant reads (owner
+// reports and listings) go to the replica while its replication lag is
+// within maxLagSeconds; everything else, and every read when the replica is
+// down, lagging or not replicating, stays on the primary. Lag is sampled
+// from SHOW REPLICA STATUS at most every few seconds, and a failed replica
+// connection is retried after a back-off rather than on every call.
+class QueryRouter {
+private:
+    sql::Connection* primary;
+    std::unique_ptr<sql::Connection> replica;
+    int maxLagSeconds;
+    int lagCheckSeconds;
+    int lastLag = -1;               // -1: unknown / not replicating
+    time_t lastLagCheck = 0;
+    time_t nextConnectAttempt = 0;
+    long long replicaReads = 0, primaryReads = 0;
+    std::string lastError;
+
+    enum { RECONNECT_BACKOFF_SECONDS = 30 };
+
+    // Seconds_Behind_Source (8.0.22+) or Seconds_Behind_Master; -1 when the
+    // server is not a replica or the SQL thread is stopped
+    int measureLag() {
+        std::unique_ptr<sql::Statement> stmt(replica->createStatement());
+        std::unique_ptr<sql::ResultSet> res;
+        bool newSyntax = true;
+        try {
+            res.reset(stmt->executeQuery("SHOW REPLICA STATUS"));
+        }
+        catch (sql::SQLException&) {
+            res.reset(stmt->executeQuery("SHOW SLAVE STATUS"));
+            newSyntax = false;
+        }
+        if (!res->next()) return -1;
+
+        const char* column = newSyntax ? "Seconds_Behind_Source" : "Seconds_Behind_Master";
+        if (res->isNull(column)) return -1;
+        return res->getInt(column);
+    }
+
+    void dropReplica(const std::string& error) {
+        replica.reset();
+        lastLag = -1;
+        lastError = error;
+        nextConnectAttempt = time(nullptr) + RECONNECT_BACKOFF_SECONDS;
+    }
+
+public:
+    QueryRouter(sql::Connection* primaryConnection, int maxLag = 5, int checkEverySeconds = 5)
+        : primary(primaryConnection), maxLagSeconds(maxLag), lagCheckSeconds(checkEverySeconds) {}
+
+    // Writes and read-your-writes paths
+    sql::Connection* writer() { return primary; }
+
+    // Reads that can tolerate up to maxLagSeconds of staleness
+    sql::Connection* reader() {
+        time_t now = time(nullptr);
+
+        if (!replica && now >= nextConnectAttempt) {
+            try {
+                replica.reset(openReplicaConnection());
+                lastLagCheck = 0;
+            }
+            catch (sql::SQLException& e) {
+                dropReplica(e.what());
+            }
+        }
+
+        if (replica && now - lastLagCheck >= lagCheckSeconds) {
+            try {
+                lastLag = measureLag();
+                lastLagCheck = now;
+                if (lastLag < 0) lastError = "replica is not replicating";
+            }
+            catch (sql::SQLException& e) {
+                dropReplica(e.what());
+            }
+        }
+
+        if (replica && lastLag >= 0 && lastLag <= maxLagSeconds) {
+            replicaReads++;
+            return replica.get();
+        }
+        primaryReads++;
+        return primary;
+    }
+
+    bool replicaConnected() const { return replica != nullptr; }
+    int replicaLag() const { return lastLag; }
+    int maxLag() const { return maxLagSeconds; }
+    long long readsOnReplica() const { return replicaReads; }
+    long long readsOnPrimary() const { return primaryReads; }
+    const std::string& lastReplicaError() const { return lastError; }
+};
+
+#endif
@@ -1,492 +1,911 @@
-#ifndef RECEIPT_H
-#define RECEIPT_H
-
-#include <iostream>
-#include <string>
-#include <iomanip>
-#include <ctime>
-#include <sstream>
-#include <cppconn/prepared_statement.h>
-#include <cppconn/resultset.h>
-
-using namespace std;
-
-#define RESET   "\033[0m"
-#define BOLD    "\033[1m"
-#define CYAN    "\033[36m"
-#define GREEN   "\033[32m"
-#define YELLOW  "\033[33m"
-#define MAGENTA "\033[35m"
-#define WHITE   "\033[97m"
-#define RED     "\033[31m"
-
-class Receipt {
-private:
-    sql::Connection* con;
-
-    string getCurrentDateTime() {
-        time_t now = time(0);
-        tm timeinfo = {};
-
-#ifdef _WIN32
-        localtime_s(&timeinfo, &now);
-#else
-        localtime_r(&now, &timeinfo);
-#endif
-
-        char buffer[80];
-        strftime(buffer, sizeof(buffer), "%d/%m/%Y %H:%M:%S", &timeinfo);
-        return string(buffer);
-    }
-
-    void printDoubleLine(int length = 70) {
-        cout << string(length, '=') << endl;
-    }
-
-    void printSingleLine(int length = 70) {
-        cout << string(length, '-') << endl;
-    }
-
-    void printCentered(string text, int width = 70) {
-        int textLen = static_cast<int>(text.length());
-        int padding = (width - textLen) / 2;
-        if (padding > 0) {
-            cout << string(padding, ' ') << text << endl;
-        }
-        else {
-            cout << text << endl;
-        }
-    }
-
-    void clearScreen() {
-#ifdef _WIN32
-        system("cls");
-#else
-        system("clear");
-#endif
-    }
-
-    void waitForUser() {
-        cout << "\n" << YELLOW << "Press Enter to continue..." << RESET;
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        cin.get();
-    }
-
-public:
-    Receipt(sql::Connection* conn) : con(conn) {}
-
-    void generateReceipt(int orderID, int customerID, string paymentMethod, double totalAmount) {
-        try {
-            // Get customer details
-            sql::PreparedStatement* custStmt = con->prepareStatement(
-                "SELECT Customer_Name, PhoneNUM, Customer_Address FROM customer WHERE CustomerID=?"
-            );
-            custStmt->setInt(1, customerID);
-            sql::ResultSet* custRes = custStmt->executeQuery();
-
-            string custName = "", custPhone = "", custAddress = "";
-            if (custRes->next()) {
-                custName = custRes->getString("Customer_Name");
-                custPhone = custRes->getString("PhoneNUM");
-                custAddress = custRes->getString("Customer_Address");
-            }
-            delete custRes;
-            delete custStmt;
-
-            // Get order items
-            sql::PreparedStatement* itemStmt = con->prepareStatement(
-                "SELECT m.Menu_Name, m.Price, oi.Quantity "
-                "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID "
-                "WHERE oi.OrdersID=?"
-            );
-            itemStmt->setInt(1, orderID);
-            sql::ResultSet* itemRes = itemStmt->executeQuery();
-
-            // Clear screen for clean receipt display
-            clearScreen();
-
-            // Build receipt content string for database
-            stringstream receiptContent;
-            receiptContent << "FOODIE EXPRESS DELIVERY SERVICE\n";
-            receiptContent << "Order ID: #" << orderID << "\n";
-            receiptContent << "Date: " << getCurrentDateTime() << "\n";
-            receiptContent << "Customer: " << custName << "\n\n";
-
-            // Print receipt to console (ENHANCED VERSION)
-            printDoubleLine();
-            cout << BOLD << CYAN;
-            printCentered(".->->->->->->->->->->->->->->->->->->->->->->->->->");
-            printCentered("||       FOODIE EXPRESS DELIVERY SERVICE          ||");
-            printCentered("||             Your Food, Our Priority!           ||");
-            printCentered(".->->->->->->->->->->->->->->->->->->->->->->->->->");
-            cout << RESET;
-            printDoubleLine();
-
-            cout << YELLOW;
-            printCentered(" 123, Jalan Makan, Taman Sedap, 50000 KL");
-            printCentered(" Tel: 03-1234 5678 | Email: order@foodie.my");
-            printCentered(" www.foodieexpress.com.my");
-            cout << RESET;
-            printSingleLine();
-
-            cout << BOLD << WHITE << "\n  RECEIPT / RESIT" << RESET << endl;
-            printSingleLine();
-
-            // Order ID with green color
-            cout << left << setw(30) << "  Order ID / No Pesanan:"
-                << BOLD << GREEN << "#" << orderID << RESET << endl;
-            cout << left << setw(30) << "  Date / Tarikh:"
-                << getCurrentDateTime() << endl;
-            printSingleLine();
-
-            cout << BOLD << MAGENTA << "\n   CUSTOMER DETAILS / MAKLUMAT PELANGGAN" << RESET << endl;
-            printSingleLine();
-            cout << left << setw(25) << "  Name / Nama:" << custName << endl;
-            cout << left << setw(25) << "  Phone / Telefon:" << custPhone << endl;
-            cout << left << setw(25) << "  Address / Alamat:" << custAddress << endl;
-            printSingleLine();
-
-            cout << BOLD << CYAN << "\n    ORDER ITEMS / SENARAI PESANAN" << RESET << endl;
-            printDoubleLine();
-
-            // Table header
-            cout << left << setw(5) << "  No"
-                << setw(25) << "Item"
-                << setw(10) << "Qty"
-                << setw(15) << "Price"
-                << "Subtotal" << endl;
-            printSingleLine();
-
-            double subtotal = 0.0;
-            int itemNo = 1;
-
-            while (itemRes->next()) {
-                string menuName = itemRes->getString("Menu_Name");
-                double price = itemRes->getDouble("Price");
-                int qty = itemRes->getInt("Quantity");
-                double itemTotal = price * qty;
-                subtotal += itemTotal;
-
-                cout << "  " << left << setw(3) << itemNo++
-                    << setw(25) << menuName
-                    << "x" << setw(9) << qty
-                    << "RM" << setw(13) << fixed << setprecision(2) << price
-                    << "RM" << itemTotal << endl;
-
-                receiptContent << itemNo - 1 << ". " << menuName
-                    << " x" << qty << " @ RM" << price
-                    << " = RM" << itemTotal << "\n";
-            }
-
-            printSingleLine();
-
-            // Calculate fees
-            double serviceTax = subtotal * 0.06;
-            double deliveryFee = 5.00;
-            double grandTotal = subtotal + serviceTax + deliveryFee;
-
-            // Price breakdown
-            cout << right << setw(55) << "Subtotal: RM "
-                << setw(10) << fixed << setprecision(2) << subtotal << endl;
-            cout << right << setw(55) << "Service Tax (6%): RM "
-                << setw(10) << serviceTax << endl;
-            cout << right << setw(55) << "Delivery Fee: RM "
-                << setw(10) << deliveryFee << endl;
-            printDoubleLine();
-
-            cout << BOLD << GREEN << right << setw(55) << "GRAND TOTAL: RM "
-                << setw(10) << grandTotal << RESET << endl;
-            printDoubleLine();
-
-            // Payment info
-            cout << YELLOW << "\n   Payment Method / Kaedah Bayaran: "
-                << BOLD << paymentMethod << RESET << endl;
-            cout << GREEN << "   Payment Status: PAID / DIBAYAR" << RESET << endl;
-            printSingleLine();
-
-            // Thank you message
-            cout << CYAN << BOLD;
-            printCentered(" THANK YOU FOR YOUR ORDER! ");
-            printCentered("TERIMA KASIH ATAS PESANAN ANDA!");
-            cout << RESET;
-            printCentered("Please keep this receipt for your reference");
-            printCentered("Sila simpan resit ini untuk rujukan anda");
-            printDoubleLine();
-
-            cout << GREEN;
-            printCentered(" Track your order status in 'View Order History'");
-            printCentered(" Estimated delivery: 30-45 minutes");
-            cout << RESET;
-            printDoubleLine();
-
-            cout << "\n" << YELLOW << "   Follow us on social media for latest promotions!" << RESET << endl;
-            printCentered("Facebook: @FoodieExpressMY | Instagram: @foodie_express");
-            printDoubleLine();
-
-            // Add to receipt content
-            receiptContent << "\nSubtotal: RM" << subtotal << "\n";
-            receiptContent << "Service Tax: RM" << serviceTax << "\n";
-            receiptContent << "Delivery Fee: RM" << deliveryFee << "\n";
-            receiptContent << "GRAND TOTAL: RM" << grandTotal << "\n";
-            receiptContent << "Payment: " << paymentMethod << "\n";
-
-            delete itemRes;
-            delete itemStmt;
-
-            // Save to database
-            saveReceiptToDatabase(orderID, customerID, paymentMethod, grandTotal,
-                subtotal, serviceTax, deliveryFee, receiptContent.str());
-
-            cout << GREEN << "\n? Receipt saved to database successfully!" << RESET << endl;
-            cout << GREEN << "Cart cleared!" << RESET << endl;
-
-            // Wait for user before returning
-            waitForUser();
-
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error generating receipt: " << e.what() << RESET << endl;
-        }
-    }
-
-    void saveReceiptToDatabase(int orderID, int customerID, string paymentMethod,
-        double totalAmount, double subTotal, double serviceTax,
-        double deliveryFee, string receiptContent) {
-        try {
-            sql::PreparedStatement* pstmt = con->prepareStatement(
-                "INSERT INTO receipt_history (OrdersID, CustomerID, PaymentMethod, "
-                "TotalAmount, SubTotal, ServiceTax, DeliveryFee, ReceiptContent) "
-                "VALUES (?, ?, ?, ?, ?, ?, ?, ?)"
-            );
-
-            pstmt->setInt(1, orderID);
-            pstmt->setInt(2, customerID);
-            pstmt->setString(3, paymentMethod);
-            pstmt->setDouble(4, totalAmount);
-            pstmt->setDouble(5, subTotal);
-            pstmt->setDouble(6, serviceTax);
-            pstmt->setDouble(7, deliveryFee);
-            pstmt->setString(8, receiptContent);
-
-            pstmt->executeUpdate();
-            delete pstmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error saving receipt: " << e.what() << RESET << endl;
-        }
-    }
-
-    // Owner view receipts
-    void viewAllReceipts() {
-        try {
-            sql::Statement* stmt = con->createStatement();
-            sql::ResultSet* res = stmt->executeQuery(
-                "SELECT rh.ReceiptID, rh.OrdersID, rh.GeneratedDate, "
-                "c.Customer_Name, rh.PaymentMethod, rh.TotalAmount "
-                "FROM receipt_history rh "
-                "JOIN customer c ON rh.CustomerID = c.CustomerID "
-                "ORDER BY rh.GeneratedDate DESC"
-            );
-
-            cout << "\n" << BOLD << CYAN;
-            cout << "'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''\n";
-            cout << "'              RECEIPT HISTORY / SEJARAH RESIT                '\n";
-            cout << "'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''\n";
-            cout << RESET;
-
-            cout << "\n";
-            cout << left << setw(12) << "Receipt ID"
-                << setw(12) << "Order ID"
-                << setw(22) << "Date/Time"
-                << setw(20) << "Customer"
-                << setw(18) << "Payment"
-                << "Amount" << endl;
-            cout << string(90, '-') << endl;
-
-            int count = 0;
-            while (res->next()) {
-                count++;
-                cout << left << setw(12) << res->getInt("ReceiptID")
-                    << setw(12) << res->getInt("OrdersID")
-                    << setw(22) << res->getString("GeneratedDate")
-                    << setw(20) << res->getString("Customer_Name")
-                    << setw(18) << res->getString("PaymentMethod")
-                    << "RM" << fixed << setprecision(2) << res->getDouble("TotalAmount") << endl;
-            }
-
-            cout << string(90, '-') << endl;
-            cout << BOLD << GREEN << "Total Receipts: " << count << RESET << endl;
-
-            delete res;
-            delete stmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-
-    // View specific receipt (with beautiful display like customer)
-    void viewReceiptDetails(int receiptID) {
-        try {
-            sql::PreparedStatement* pstmt = con->prepareStatement(
-                "SELECT rh.*, c.Customer_Name, c.PhoneNUM, c.Customer_Address "
-                "FROM receipt_history rh "
-                "JOIN customer c ON rh.CustomerID = c.CustomerID "
-                "WHERE rh.ReceiptID=?"
-            );
-            pstmt->setInt(1, receiptID);
-            sql::ResultSet* res = pstmt->executeQuery();
-
-            if (res->next()) {
-                int orderID = res->getInt("OrdersID");
-                string custName = res->getString("Customer_Name");
-                string custPhone = res->getString("PhoneNUM");
-                string custAddress = res->getString("Customer_Address");
-                string paymentMethod = res->getString("PaymentMethod");
-                double subtotal = res->getDouble("SubTotal");
-                double serviceTax = res->getDouble("ServiceTax");
-                double deliveryFee = res->getDouble("DeliveryFee");
-                double grandTotal = res->getDouble("TotalAmount");
-                string generatedDate = res->getString("GeneratedDate");
-
-                // Display beautiful receipt (same as customer sees)
-                clearScreen();
-
-                printDoubleLine();
-                cout << BOLD << CYAN;
-                printCentered(":::::::::::::::::::::::::::::::::::::::::::::::::::");
-                printCentered("::        FOODIE EXPRESS DELIVERY SERVICE        ::");
-                printCentered("::             Your Food, Our Priority!          ::");
-                printCentered(":::::::::::::::::::::::::::::::::::::::::::::::::::");
-                cout << RESET;
-                printDoubleLine();
-
-                cout << YELLOW;
-                printCentered(" 123, Jalan Makan, Taman Sedap, 50000 KL");
-                printCentered(" Tel: 03-1234 5678 |  Email: order@foodie.my");
-                cout << RESET;
-                printSingleLine();
-
-                cout << BOLD << WHITE << "\n  RECEIPT / RESIT" << RESET << endl;
-                printSingleLine();
-                cout << left << setw(30) << "  Order ID:"
-                    << BOLD << GREEN << "#" << orderID << RESET << endl;
-                cout << left << setw(30) << "  Date:" << generatedDate << endl;
-                printSingleLine();
-
-                cout << BOLD << MAGENTA << "\n   CUSTOMER DETAILS" << RESET << endl;
-                printSingleLine();
-                cout << left << setw(25) << "  Name:" << custName << endl;
-                cout << left << setw(25) << "  Phone:" << custPhone << endl;
-                cout << left << setw(25) << "  Address:" << custAddress << endl;
-                printSingleLine();
-
-                // Get order items
-                sql::PreparedStatement* itemStmt = con->prepareStatement(
-                    "SELECT m.Menu_Name, m.Price, oi.Quantity "
-                    "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID "
-                    "WHERE oi.OrdersID=?"
-                );
-                itemStmt->setInt(1, orderID);
-                sql::ResultSet* itemRes = itemStmt->executeQuery();
-
-                cout << BOLD << CYAN << "\n    ORDER ITEMS" << RESET << endl;
-                printDoubleLine();
-                cout << left << setw(5) << "  No"
-                    << setw(25) << "Item"
-                    << setw(10) << "Qty"
-                    << setw(15) << "Price"
-                    << "Subtotal" << endl;
-                printSingleLine();
-
-                int itemNo = 1;
-                while (itemRes->next()) {
-                    string menuName = itemRes->getString("Menu_Name");
-                    double price = itemRes->getDouble("Price");
-                    int qty = itemRes->getInt("Quantity");
-                    double itemTotal = price * qty;
-
-                    cout << "  " << left << setw(3) << itemNo++
-                        << setw(25) << menuName
-                        << "x" << setw(9) << qty
-                        << "RM" << setw(13) << fixed << setprecision(2) << price
-                        << "RM" << itemTotal << endl;
-                }
-                delete itemRes;
-                delete itemStmt;
-
-                printSingleLine();
-                cout << right << setw(55) << "Subtotal: RM " << setw(10) << subtotal << endl;
-                cout << right << setw(55) << "Service Tax (6%): RM " << setw(10) << serviceTax << endl;
-                cout << right << setw(55) << "Delivery Fee: RM " << setw(10) << deliveryFee << endl;
-                printDoubleLine();
-                cout << BOLD << GREEN << right << setw(55) << "GRAND TOTAL: RM " << setw(10) << grandTotal << RESET << endl;
-                printDoubleLine();
-
-                cout << YELLOW << "\n   Payment: " << BOLD << paymentMethod << RESET << endl;
-                cout << GREEN << "   Status: PAID" << RESET << endl;
-                printSingleLine();
-
-            }
-            else {
-                cout << RED << "\nReceipt not found!" << RESET << endl;
-            }
-
-            delete res;
-            delete pstmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Error: " << e.what() << RESET << endl;
-        }
-    }
-
-    // ? TAMBAHAN: Fungsi untuk search receipts by customer
-    void searchReceiptsByCustomer(string customerName) {
-        try {
-            sql::PreparedStatement* pstmt = con->prepareStatement(
-                "SELECT rh.ReceiptID, rh.OrdersID, rh.GeneratedDate, "
-                "c.Customer_Name, rh.PaymentMethod, rh.TotalAmount "
-                "FROM receipt_history rh "
-                "JOIN customer c ON rh.CustomerID = c.CustomerID "
-                "WHERE c.Customer_Name LIKE ? "
-                "ORDER BY rh.GeneratedDate DESC"
-            );
-            pstmt->setString(1, "%" + customerName + "%");
-            sql::ResultSet* res = pstmt->executeQuery();
-
-            cout << "\n" << BOLD << CYAN << "=== SEARCH RESULTS FOR: " << customerName << " ===" << RESET << endl;
-            cout << left << setw(12) << "Receipt ID"
-                << setw(12) << "Order ID"
-                << setw(22) << "Date"
-                << setw(20) << "Customer"
-                << "Amount" << endl;
-            cout << string(80, '-') << endl;
-
-            int count = 0;
-            while (res->next()) {
-                count++;
-                cout << left << setw(12) << res->getInt("ReceiptID")
-                    << setw(12) << res->getInt("OrdersID")
-                    << setw(22) << res->getString("GeneratedDate")
-                    << setw(20) << res->getString("Customer_Name")
-                    << "RM" << fixed << setprecision(2) << res->getDouble("TotalAmount") << endl;
-            }
-
-            if (count == 0) {
-                cout << YELLOW << "No receipts found for customer: " << customerName << RESET << endl;
-            }
-            else {
-                cout << string(80, '-') << endl;
-                cout << GREEN << "Total found: " << count << RESET << endl;
-            }
-
-            delete res;
-            delete pstmt;
-        }
-        catch (sql::SQLException& e) {
-            cerr << RED << "Search error: " << e.what() << RESET << endl;
-        }
-    }
-};
-
+#ifndef RECEIPT_H
+#define RECEIPT_H
+
+#include <iostream>
+#include <string>
+#include <iomanip>
+#include <ctime>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <iterator>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include "database.h"
+#include "receipt_template.h"
+#include "receipt_codec.h"
+#include "receipt_archive.h"
+#include "customer_index.h"
+#include "receipt_export.h"
+#include "query_router.h"
+#include "partition_manager.h"
+#include "eta.h"
+#include "delivery_zone.h"
+
+using namespace std;
+
+#define RESET   "\033[0m"
+#define BOLD    "\033[1m"
+#define CYAN    "\033[36m"
+#define GREEN   "\033[32m"
+#define YELLOW  "\033[33m"
+#define MAGENTA "\033[35m"
+#define WHITE   "\033[97m"
+#define RED     "\033[31m"
+
+// Field slots used by the receipt templates
+enum ReceiptField {
+    RF_ORDER_ID, RF_DATE, RF_CUST_NAME, RF_CUST_PHONE, RF_CUST_ADDRESS,
+    RF_ITEM_NO, RF_ITEM_NAME, RF_ITEM_QTY, RF_ITEM_PRICE, RF_ITEM_TOTAL,
+    RF_SUBTOTAL, RF_SERVICE_TAX, RF_DELIVERY_FEE, RF_GRAND_TOTAL, RF_PAYMENT_METHOD,
+    RF_ETA,
+    RF_COUNT
+};
+
+struct ReceiptLine {
+    string menuName;
+    double price;
+    int quantity;
+    int menuID;
+};
+
+// Everything needed to render one receipt
+struct ReceiptDoc {
+    int orderID = 0;
+    string date;
+    string custName, custPhone, custAddress;
+    string paymentMethod;
+    string eta;                     // e.g. "25-34 minutes"; customer copy footer only
+    vector<ReceiptLine> lines;
+    double subtotal = 0.0;
+    double serviceTax = 0.0;
+    double deliveryFee = 0.0;
+    double grandTotal = 0.0;
+};
+
+class Receipt {
+private:
+    sql::Connection* con;
+
+    // Compiled once per Receipt object, rendered many times
+    ReceiptTemplate headerTpl, itemTpl, totalsTpl, footerTpl;
+    ReceiptValues values;
+    RenderBuffer consoleBuf, textBuf;
+    bool schemaChecked = false;
+    ReceiptArchive archive;
+    CustomerNameIndex customerIndex;
+    QueryRouter* router = nullptr;
+    EtaModel* etaModel = nullptr;
+    DeliveryFeeEngine* deliveryFees = nullptr;
+
+    string formatDateTime(time_t when, const char* format = "%d/%m/%Y %H:%M:%S") {
+        tm timeinfo = {};
+
+#ifdef _WIN32
+        localtime_s(&timeinfo, &when);
+#else
+        localtime_r(&when, &timeinfo);
+#endif
+
+        char buffer[80];
+        strftime(buffer, sizeof(buffer), format, &timeinfo);
+        return string(buffer);
+    }
+
+    string getCurrentDateTime() {
+        return formatDateTime(time(0));
+    }
+
+    // Receipts are stored as a ReceiptCodec record; the text blob and the
+    // per-receipt fee columns become optional (kept only for old rows)
+    void ensureSchema() {
+        if (schemaChecked) return;
+        if (!indexExists(con, "receipt_history", "idx_receipt_customer_date")) {
+            unique_ptr<sql::Statement> stmt(con->createStatement());
+            stmt->execute(
+                "CREATE INDEX idx_receipt_customer_date "
+                "ON receipt_history (CustomerID, GeneratedDate, ReceiptID)"
+            );
+        }
+        if (!indexExists(con, "receipt_history", "idx_receipt_date")) {
+            unique_ptr<sql::Statement> stmt(con->createStatement());
+            stmt->execute("CREATE INDEX idx_receipt_date ON receipt_history (GeneratedDate, ReceiptID)");
+        }
+        if (!columnExists(con, "receipt_history", "ReceiptData")) {
+            // Legacy columns keep their declared types and only lose NOT NULL
+            string alter = "ALTER TABLE receipt_history ADD COLUMN ReceiptData BLOB NULL";
+            const char* legacy[] = { "ReceiptContent", "SubTotal", "ServiceTax", "DeliveryFee" };
+            for (const char* column : legacy) {
+                string type = columnType(con, "receipt_history", column);
+                if (!type.empty()) alter += string(", MODIFY ") + column + " " + type + " NULL";
+            }
+            unique_ptr<sql::Statement> stmt(con->createStatement());
+            stmt->execute(alter);
+        }
+        schemaChecked = true;
+    }
+
+    ReceiptDoc docFromStored(const StoredReceipt& r) {
+        ReceiptDoc doc;
+        doc.orderID = r.orderID;
+        doc.date = formatDateTime(static_cast<time_t>(r.issuedAt));
+        doc.custName = r.custName;
+        doc.custPhone = r.custPhone;
+        doc.custAddress = r.custAddress;
+        doc.paymentMethod = r.paymentMethod;
+        for (const StoredReceiptLine& l : r.lines) {
+            ReceiptLine line = { l.name, l.unitCents / 100.0, l.quantity, l.menuID };
+            doc.lines.push_back(line);
+        }
+        doc.subtotal = r.subtotalCents() / 100.0;
+        doc.serviceTax = r.serviceTaxCents / 100.0;
+        doc.deliveryFee = r.deliveryFeeCents / 100.0;
+        doc.grandTotal = r.grandTotalCents() / 100.0;
+        return doc;
+    }
+
+    void clearScreen() {
+#ifdef _WIN32
+        system("cls");
+#else
+        system("clear");
+#endif
+    }
+
+    void waitForUser() {
+        cout << "\n" << YELLOW << "Press Enter to continue..." << RESET;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cin.get();
+    }
+
+    void compileTemplates() {
+        const ReceiptTemplate::Align R = ReceiptTemplate::RIGHT;
+
+        headerTpl.rule('=')
+            .style(BOLD).style(CYAN)
+            .centered(".->->->->->->->->->->->->->->->->->->->->->->->->->")
+            .centered("||       FOODIE EXPRESS DELIVERY SERVICE          ||")
+            .centered("||             Your Food, Our Priority!           ||")
+            .centered(".->->->->->->->->->->->->->->->->->->->->->->->->->")
+            .style(RESET)
+            .rule('=')
+            .style(YELLOW)
+            .centered(" 123, Jalan Makan, Taman Sedap, 50000 KL")
+            .centered(" Tel: 03-1234 5678 | Email: order@foodie.my")
+            .centered(" www.foodieexpress.com.my")
+            .style(RESET)
+            .rule('-')
+            .style(BOLD).style(WHITE).text("\n  RECEIPT / RESIT").style(RESET).text("\n")
+            .rule('-')
+            .text("  Order ID / No Pesanan:", 30)
+            .style(BOLD).style(GREEN).text("#").field(RF_ORDER_ID).style(RESET).text("\n")
+            .text("  Date / Tarikh:", 30).field(RF_DATE).text("\n")
+            .rule('-')
+            .style(BOLD).style(MAGENTA).text("\n   CUSTOMER DETAILS / MAKLUMAT PELANGGAN").style(RESET).text("\n")
+            .rule('-')
+            .text("  Name / Nama:", 25).field(RF_CUST_NAME).text("\n")
+            .text("  Phone / Telefon:", 25).field(RF_CUST_PHONE).text("\n")
+            .text("  Address / Alamat:", 25).field(RF_CUST_ADDRESS).text("\n")
+            .rule('-')
+            .style(BOLD).style(CYAN).text("\n    ORDER ITEMS / SENARAI PESANAN").style(RESET).text("\n")
+            .rule('=')
+            .text("  No", 5).text("Item", 25).text("Qty", 10).text("Price", 15).text("Subtotal\n")
+            .rule('-');
+
+        itemTpl.text("  ")
+            .field(RF_ITEM_NO, 3)
+            .field(RF_ITEM_NAME, 25)
+            .text("x").field(RF_ITEM_QTY, 9)
+            .text("RM").field(RF_ITEM_PRICE, 13, ReceiptTemplate::LEFT, 2)
+            .text("RM").field(RF_ITEM_TOTAL, 0, ReceiptTemplate::LEFT, 2).text("\n");
+
+        totalsTpl.rule('-')
+            .text("Subtotal: RM ", 55, R).field(RF_SUBTOTAL, 10, R, 2).text("\n")
+            .text("Service Tax (6%): RM ", 55, R).field(RF_SERVICE_TAX, 10, R, 2).text("\n")
+            .text("Delivery Fee: RM ", 55, R).field(RF_DELIVERY_FEE, 10, R, 2).text("\n")
+            .rule('=')
+            .style(BOLD).style(GREEN)
+            .text("GRAND TOTAL: RM ", 55, R).field(RF_GRAND_TOTAL, 10, R, 2)
+            .style(RESET).text("\n")
+            .rule('=')
+            .style(YELLOW).text("\n   Payment Method / Kaedah Bayaran: ")
+            .style(BOLD).field(RF_PAYMENT_METHOD).style(RESET).text("\n")
+            .style(GREEN).text("   Payment Status: PAID / DIBAYAR").style(RESET).text("\n")
+            .rule('-');
+
+        footerTpl.style(CYAN).style(BOLD)
+            .centered(" THANK YOU FOR YOUR ORDER! ")
+            .centered("TERIMA KASIH ATAS PESANAN ANDA!")
+            .style(RESET)
+            .centered("Please keep this receipt for your reference")
+            .centered("Sila simpan resit ini untuk rujukan anda")
+            .rule('=')
+            .style(GREEN)
+            .centered(" Track your order status in 'View Order History'")
+            .text(string(18, ' ')).text(" Estimated delivery: ").field(RF_ETA).text("\n")
+            .style(RESET)
+            .rule('=')
+            .text("\n").style(YELLOW).text("   Follow us on social media for latest promotions!").style(RESET).text("\n")
+            .centered("Facebook: @FoodieExpressMY | Instagram: @foodie_express")
+            .rule('=');
+    }
+
+    // Renders a whole receipt into out (console copy when plain == false)
+    void renderReceipt(const ReceiptDoc& doc, RenderBuffer& out, bool plain, bool customerCopy) {
+        out.clear();
+
+        values.setInt(RF_ORDER_ID, doc.orderID);
+        values.setString(RF_DATE, doc.date);
+        values.setString(RF_CUST_NAME, doc.custName);
+        values.setString(RF_CUST_PHONE, doc.custPhone);
+        values.setString(RF_CUST_ADDRESS, doc.custAddress);
+        headerTpl.render(values, out, plain);
+
+        int itemNo = 1;
+        for (const ReceiptLine& line : doc.lines) {
+            values.setInt(RF_ITEM_NO, itemNo++);
+            values.setString(RF_ITEM_NAME, line.menuName);
+            values.setInt(RF_ITEM_QTY, line.quantity);
+            values.setDouble(RF_ITEM_PRICE, line.price);
+            values.setDouble(RF_ITEM_TOTAL, line.price * line.quantity);
+            itemTpl.render(values, out, plain);
+        }
+
+        values.setDouble(RF_SUBTOTAL, doc.subtotal);
+        values.setDouble(RF_SERVICE_TAX, doc.serviceTax);
+        values.setDouble(RF_DELIVERY_FEE, doc.deliveryFee);
+        values.setDouble(RF_GRAND_TOTAL, doc.grandTotal);
+        values.setString(RF_PAYMENT_METHOD, doc.paymentMethod);
+        totalsTpl.render(values, out, plain);
+
+        if (customerCopy) {
+            values.setString(RF_ETA, doc.eta.empty() ? string("30-45 minutes") : doc.eta);
+            footerTpl.render(values, out, plain);
+        }
+    }
+
+    // One write for the whole receipt
+    void emit(const RenderBuffer& buf) {
+        cout.write(buf.c_str(), buf.size());
+        cout.flush();
+    }
+
+    void deleteReceipts(const vector<int>& ids) {
+        unique_ptr<sql::Statement> stmt(con->createStatement());
+        for (size_t i = 0; i < ids.size(); i += 500) {
+            string sql = "DELETE FROM receipt_history WHERE ReceiptID IN (";
+            for (size_t j = i; j < ids.size() && j < i + 500; j++) {
+                if (j > i) sql += ",";
+                sql += to_string(ids[j]);
+            }
+            stmt->executeUpdate(sql + ")");
+        }
+    }
+
+    void loadOrderLines(int orderID, ReceiptDoc& doc) {
+        sql::PreparedStatement* itemStmt = con->prepareStatement(
+            "SELECT oi.MenuID, m.Menu_Name, m.Price, oi.Quantity "
+            "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID "
+            "WHERE oi.OrdersID=?"
+        );
+        itemStmt->setInt(1, orderID);
+        sql::ResultSet* itemRes = itemStmt->executeQuery();
+
+        while (itemRes->next()) {
+            ReceiptLine line;
+            line.menuName = itemRes->getString("Menu_Name");
+            line.price = itemRes->getDouble("Price");
+            line.quantity = itemRes->getInt("Quantity");
+            line.menuID = itemRes->getInt("MenuID");
+            doc.lines.push_back(line);
+        }
+        delete itemRes;
+        delete itemStmt;
+    }
+
+public:
+    Receipt(sql::Connection* conn) : con(conn), values(RF_COUNT) {
+        compileTemplates();
+        archive.open();
+    }
+
+    // Owner history listing may read from the replica
+    void setQueryRouter(QueryRouter* queryRouter) { router = queryRouter; }
+
+    // Estimated delivery on new receipts comes from delivery history
+    void setEtaModel(EtaModel* model) { etaModel = model; }
+
+    // Delivery fee by the customer's zone, distance and surge; flat 5.00 without it
+    void setDeliveryFees(DeliveryFeeEngine* engine) { deliveryFees = engine; }
+
+    FeeQuote quoteDeliveryFee(const string& address) const {
+        if (deliveryFees) return deliveryFees->quote(address);
+        FeeQuote flat = { 5.00, -1.0, 1.0, 0, "" };
+        return flat;
+    }
+
+    // `fee` is the quote the customer confirmed at checkout, not a fresh one
+    void generateReceipt(int orderID, int customerID, string paymentMethod, double totalAmount, const FeeQuote& fee) {
+        try {
+            ensureSchema();
+
+            time_t issuedAt = time(0);
+            ReceiptDoc doc;
+            doc.orderID = orderID;
+            doc.date = formatDateTime(issuedAt);
+            doc.paymentMethod = paymentMethod;
+
+            // Get customer details
+            sql::PreparedStatement* custStmt = con->prepareStatement(
+                "SELECT Customer_Name, PhoneNUM, Customer_Address FROM customer WHERE CustomerID=?"
+            );
+            custStmt->setInt(1, customerID);
+            sql::ResultSet* custRes = custStmt->executeQuery();
+
+            if (custRes->next()) {
+                doc.custName = custRes->getString("Customer_Name");
+                doc.custPhone = custRes->getString("PhoneNUM");
+                doc.custAddress = custRes->getString("Customer_Address");
+            }
+            delete custRes;
+            delete custStmt;
+
+            // Get order items
+            loadOrderLines(orderID, doc);
+            for (const ReceiptLine& line : doc.lines) {
+                doc.subtotal += line.price * line.quantity;
+            }
+
+            // Calculate fees
+            doc.serviceTax = doc.subtotal * 0.06;
+            doc.deliveryFee = fee.fee;
+            doc.grandTotal = doc.subtotal + doc.serviceTax + doc.deliveryFee;
+
+            // Prices are captured here so later menu changes don't rewrite history
+            StoredReceipt stored;
+            stored.orderID = orderID;
+            stored.customerID = customerID;
+            stored.issuedAt = issuedAt;
+            stored.paymentMethod = paymentMethod;
+            stored.custName = doc.custName;
+            stored.custPhone = doc.custPhone;
+            stored.custAddress = doc.custAddress;
+            stored.serviceTaxCents = ReceiptCodec::toCents(doc.serviceTax);
+            stored.deliveryFeeCents = ReceiptCodec::toCents(doc.deliveryFee);
+            for (const ReceiptLine& line : doc.lines) {
+                StoredReceiptLine l;
+                l.menuID = line.menuID;
+                l.quantity = line.quantity;
+                l.unitCents = ReceiptCodec::toCents(line.price);
+                l.name = line.menuName;
+                stored.lines.push_back(l);
+            }
+
+            ReceiptDoc printed = docFromStored(stored);
+            if (etaModel) {
+                EtaEstimate eta = etaModel->estimate(orderID, doc.custAddress);
+                printed.eta = to_string(eta.lowMinutes) + "-" + to_string(eta.highMinutes) + " minutes";
+            }
+            renderReceipt(printed, consoleBuf, false, true);
+
+            // Clear screen for clean receipt display
+            clearScreen();
+            emit(consoleBuf);
+
+            // Save to database
+            saveReceiptToDatabase(stored);
+
+            cout << GREEN << "\n? Receipt saved to database successfully!" << RESET << endl;
+            cout << GREEN << "Cart cleared!" << RESET << endl;
+
+            // Wait for user before returning
+            waitForUser();
+
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error generating receipt: " << e.what() << RESET << endl;
+        }
+    }
+
+    // TotalAmount / PaymentMethod stay as columns for the listing and search views;
+    // everything else lives in the encoded record
+    void saveReceiptToDatabase(const StoredReceipt& receipt) {
+        try {
+            ensureSchema();
+            sql::PreparedStatement* pstmt = con->prepareStatement(
+                "INSERT INTO receipt_history (OrdersID, CustomerID, PaymentMethod, "
+                "TotalAmount, ReceiptData) "
+                "VALUES (?, ?, ?, ?, ?)"
+            );
+
+            string encoded = ReceiptCodec::encode(receipt);
+            istringstream blob(encoded);
+
+            pstmt->setInt(1, receipt.orderID);
+            pstmt->setInt(2, receipt.customerID);
+            pstmt->setString(3, receipt.paymentMethod);
+            pstmt->setDouble(4, receipt.grandTotalCents() / 100.0);
+            pstmt->setBlob(5, &blob);
+
+            pstmt->executeUpdate();
+            delete pstmt;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error saving receipt: " << e.what() << RESET << endl;
+        }
+    }
+
+    // Owner view receipts
+    void viewAllReceipts() {
+        try {
+            sql::Connection* db = router ? router->reader() : con;
+            sql::Statement* stmt = db->createStatement();
+            sql::ResultSet* res = stmt->executeQuery(
+                "SELECT rh.ReceiptID, rh.OrdersID, rh.GeneratedDate, "
+                "c.Customer_Name, rh.PaymentMethod, rh.TotalAmount "
+                "FROM receipt_history rh "
+                "JOIN customer c ON rh.CustomerID = c.CustomerID "
+                "ORDER BY rh.GeneratedDate DESC"
+            );
+
+            cout << "\n" << BOLD << CYAN;
+            cout << "'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''\n";
+            cout << "'              RECEIPT HISTORY / SEJARAH RESIT                '\n";
+            cout << "'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''\n";
+            cout << RESET;
+
+            cout << "\n";
+            cout << left << setw(12) << "Receipt ID"
+                << setw(12) << "Order ID"
+                << setw(22) << "Date/Time"
+                << setw(20) << "Customer"
+                << setw(18) << "Payment"
+                << "Amount" << endl;
+            cout << string(90, '-') << endl;
+
+            int count = 0;
+            while (res->next()) {
+                count++;
+                cout << left << setw(12) << res->getInt("ReceiptID")
+                    << setw(12) << res->getInt("OrdersID")
+                    << setw(22) << res->getString("GeneratedDate")
+                    << setw(20) << res->getString("Customer_Name")
+                    << setw(18) << res->getString("PaymentMethod")
+                    << "RM" << fixed << setprecision(2) << res->getDouble("TotalAmount") << endl;
+            }
+
+            cout << string(90, '-') << endl;
+            cout << BOLD << GREEN << "Total Receipts: " << count << RESET << endl;
+            if (archive.receiptCount() > 0) {
+                cout << YELLOW << "Archived Receipts: " << archive.receiptCount() << " in "
+                    << archive.segmentCount() << " segment(s) - open them by Receipt ID" << RESET << endl;
+            }
+
+            delete res;
+            delete stmt;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // View specific receipt (with beautiful display like customer)
+    void viewReceiptDetails(int receiptID) {
+        try {
+            ensureSchema();
+
+            // Encoded receipts render from this single row
+            sql::PreparedStatement* dataStmt = con->prepareStatement(
+                "SELECT ReceiptData FROM receipt_history WHERE ReceiptID=?"
+            );
+            dataStmt->setInt(1, receiptID);
+            sql::ResultSet* dataRes = dataStmt->executeQuery();
+
+            string encoded;
+            bool found = dataRes->next();
+            if (found && !dataRes->isNull("ReceiptData")) {
+                unique_ptr<istream> blob(dataRes->getBlob("ReceiptData"));
+                encoded.assign(istreambuf_iterator<char>(*blob), istreambuf_iterator<char>());
+            }
+            delete dataRes;
+            delete dataStmt;
+
+            StoredReceipt stored;
+            ArchivedReceiptRef archived;
+            bool decoded = found
+                ? (!encoded.empty() && ReceiptCodec::decode(encoded, stored))
+                : (archive.find(receiptID, archived) && ReceiptCodec::decode(archived.data, archived.length, stored));
+            if (decoded) {
+                renderReceipt(docFromStored(stored), consoleBuf, false, false);
+                clearScreen();
+                emit(consoleBuf);
+                return;
+            }
+
+            // Receipts saved before ReceiptData existed
+            sql::PreparedStatement* pstmt = con->prepareStatement(
+                "SELECT rh.*, c.Customer_Name, c.PhoneNUM, c.Customer_Address "
+                "FROM receipt_history rh "
+                "JOIN customer c ON rh.CustomerID = c.CustomerID "
+                "WHERE rh.ReceiptID=?"
+            );
+            pstmt->setInt(1, receiptID);
+            sql::ResultSet* res = pstmt->executeQuery();
+
+            if (res->next()) {
+                ReceiptDoc doc;
+                doc.orderID = res->getInt("OrdersID");
+                doc.custName = res->getString("Customer_Name");
+                doc.custPhone = res->getString("PhoneNUM");
+                doc.custAddress = res->getString("Customer_Address");
+                doc.paymentMethod = res->getString("PaymentMethod");
+                doc.subtotal = res->getDouble("SubTotal");
+                doc.serviceTax = res->getDouble("ServiceTax");
+                doc.deliveryFee = res->getDouble("DeliveryFee");
+                doc.grandTotal = res->getDouble("TotalAmount");
+                doc.date = res->getString("GeneratedDate");
+
+                // Get order items
+                loadOrderLines(doc.orderID, doc);
+
+                // Display beautiful receipt (same as customer sees)
+                renderReceipt(doc, consoleBuf, false, false);
+                clearScreen();
+                emit(consoleBuf);
+            }
+            else {
+                cout << RED << "\nReceipt not found!" << RESET << endl;
+            }
+
+            delete res;
+            delete pstmt;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // Microbenchmark: receipts rendered per second (console + stored copy, no I/O)
+    void benchmarkRendering(int iterations = 100000) {
+        ReceiptDoc doc;
+        doc.orderID = 123456;
+        doc.date = getCurrentDateTime();
+        doc.custName = "Ahmad Bin Abdullah";
+        doc.custPhone = "012-3456789";
+        doc.custAddress = "12, Jalan Bunga Raya, Taman Melati, 53100 KL";
+        doc.paymentMethod = "Online Banking";
+        const char* names[] = { "Nasi Lemak Special", "Teh Tarik", "Roti Canai", "Mee Goreng Mamak", "Ayam Goreng", "Milo Ais" };
+        for (int i = 0; i < 6; i++) {
+            ReceiptLine line = { names[i], 3.50 + i * 1.25, 1 + i % 3, i + 1 };
+            doc.lines.push_back(line);
+            doc.subtotal += line.price * line.quantity;
+        }
+        doc.serviceTax = doc.subtotal * 0.06;
+        doc.deliveryFee = 5.00;
+        doc.grandTotal = doc.subtotal + doc.serviceTax + doc.deliveryFee;
+
+        // Warm up so buffers reach their steady-state capacity
+        renderReceipt(doc, consoleBuf, false, true);
+        renderReceipt(doc, textBuf, true, true);
+
+        size_t bytes = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            renderReceipt(doc, consoleBuf, false, true);
+            renderReceipt(doc, textBuf, true, true);
+            bytes += consoleBuf.size() + textBuf.size();
+        }
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "\n" << BOLD << CYAN << "=== RECEIPT RENDERING BENCHMARK ===" << RESET << endl;
+        cout << "Iterations        : " << iterations << endl;
+        cout << "Template segments : " << headerTpl.segmentCount() + itemTpl.segmentCount()
+            + totalsTpl.segmentCount() + footerTpl.segmentCount() << endl;
+        cout << "Bytes per receipt : " << (iterations > 0 ? bytes / iterations : 0) << endl;
+        cout << "Elapsed           : " << fixed << setprecision(3) << secs << " s" << endl;
+        cout << BOLD << GREEN << "Receipts / second : " << setprecision(0)
+            << (secs > 0 ? iterations / secs : 0) << RESET << endl;
+    }
+
+    // Average stored bytes per receipt, encoded records vs. legacy text rows
+    void showStorageStats() {
+        try {
+            ensureSchema();
+            unique_ptr<sql::Statement> stmt(con->createStatement());
+            unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+                "SELECT COUNT(*) AS total, "
+                "SUM(ReceiptData IS NOT NULL) AS encodedRows, "
+                "IFNULL(AVG(LENGTH(ReceiptData)), 0) AS encodedAvg, "
+                "SUM(ReceiptData IS NULL) AS legacyRows, "
+                "IFNULL(AVG(CASE WHEN ReceiptData IS NULL THEN LENGTH(ReceiptContent) END), 0) AS legacyAvg "
+                "FROM receipt_history"
+            ));
+
+            cout << "\n" << BOLD << CYAN << "=== RECEIPT STORAGE ===" << RESET << endl;
+            if (res->next()) {
+                cout << left << setw(28) << "Total receipts:" << res->getInt("total") << endl;
+                cout << left << setw(28) << "Encoded receipts:" << res->getInt("encodedRows")
+                    << "  (avg " << fixed << setprecision(0) << res->getDouble("encodedAvg") << " bytes)" << endl;
+                cout << left << setw(28) << "Legacy text receipts:" << res->getInt("legacyRows")
+                    << "  (avg " << fixed << setprecision(0) << res->getDouble("legacyAvg") << " bytes)" << endl;
+            }
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // Moves receipts older than monthsToKeep full months into archive segments,
+    // one segment per calendar month. Rows are deleted only after their segment
+    // is safely on disk; rows already in a segment (a run interrupted before
+    // its delete) are just deleted. Returns -1 if the run failed.
+    int archiveOldReceipts(int monthsToKeep = 3) {
+        int archivedTotal = 0;
+        try {
+            ensureSchema();
+
+            time_t now = time(0);
+            tm cut = {};
+#ifdef _WIN32
+            localtime_s(&cut, &now);
+#else
+            localtime_r(&now, &cut);
+#endif
+            cut.tm_mon -= monthsToKeep;
+            cut.tm_mday = 1;
+            cut.tm_hour = cut.tm_min = cut.tm_sec = 0;
+            cut.tm_isdst = -1;
+            string cutoff = formatDateTime(mktime(&cut), "%Y-%m-%d %H:%M:%S");
+
+            unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+                "SELECT rh.ReceiptID, rh.OrdersID, rh.CustomerID, rh.PaymentMethod, rh.TotalAmount, "
+                "UNIX_TIMESTAMP(rh.GeneratedDate) AS ts, DATE_FORMAT(rh.GeneratedDate, '%Y%m') AS ym, "
+                "rh.ReceiptData, rh.ServiceTax, rh.DeliveryFee, "
+                "c.Customer_Name, c.PhoneNUM, c.Customer_Address "
+                "FROM receipt_history rh LEFT JOIN customer c ON rh.CustomerID = c.CustomerID "
+                "WHERE rh.GeneratedDate < ? "
+                "ORDER BY ym, rh.ReceiptID"
+            ));
+            pstmt->setString(1, cutoff);
+            unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+            unique_ptr<ArchiveSegmentWriter> writer;
+            string month, segmentName;
+            vector<int> pending, alreadyArchived;
+
+            // On a partitioned receipt_history a fully archived month goes
+            // with one DROP PARTITION instead of row-by-row deletes
+            PartitionManager partitions(con);
+            bool partitioned = partitions.isPartitioned("receipt_history");
+
+            auto flush = [&]() {
+                if (!writer) return;
+                if (!archive.commitSegment(*writer, segmentName)) {
+                    throw sql::SQLException("could not write archive segment " + segmentName);
+                }
+                if (!partitioned || !partitions.dropMonthIfExactly("receipt_history", atoi(month.c_str()),
+                        static_cast<long long>(pending.size()))) {
+                    deleteReceipts(pending);
+                }
+                archivedTotal += static_cast<int>(pending.size());
+                cout << GREEN << "[Archive] " << segmentName << ": " << pending.size() << " receipts" << RESET << endl;
+                pending.clear();
+                writer.reset();
+            };
+
+            while (res->next()) {
+                string ym = res->getString("ym");
+                if (ym != month) {
+                    flush();
+                    month = ym;
+                }
+
+                ArchivedReceiptRef existing;
+                if (archive.find(res->getInt("ReceiptID"), existing)) {
+                    alreadyArchived.push_back(res->getInt("ReceiptID"));
+                    continue;
+                }
+                if (!writer) {
+                    writer.reset(new ArchiveSegmentWriter());
+                    if (!archive.beginSegment(month, *writer, segmentName)) {
+                        throw sql::SQLException("could not create archive segment for " + month);
+                    }
+                }
+
+                ArchivedRecordHeader rec = {};
+                rec.receiptID = res->getUInt("ReceiptID");
+                rec.orderID = res->getUInt("OrdersID");
+                rec.customerID = res->getUInt("CustomerID");
+                rec.generatedAt = res->getInt64("ts");
+                rec.totalCents = ReceiptCodec::toCents(res->getDouble("TotalAmount"));
+
+                string encoded;
+                if (!res->isNull("ReceiptData")) {
+                    unique_ptr<istream> blob(res->getBlob("ReceiptData"));
+                    encoded.assign(istreambuf_iterator<char>(*blob), istreambuf_iterator<char>());
+                }
+                else {
+                    // Legacy row: snapshot it into the same record format
+                    StoredReceipt stored;
+                    stored.orderID = rec.orderID;
+                    stored.customerID = rec.customerID;
+                    stored.issuedAt = rec.generatedAt;
+                    stored.paymentMethod = res->getString("PaymentMethod");
+                    stored.custName = res->getString("Customer_Name");
+                    stored.custPhone = res->getString("PhoneNUM");
+                    stored.custAddress = res->getString("Customer_Address");
+                    stored.serviceTaxCents = ReceiptCodec::toCents(res->getDouble("ServiceTax"));
+                    stored.deliveryFeeCents = ReceiptCodec::toCents(res->getDouble("DeliveryFee"));
+
+                    ReceiptDoc doc;
+                    loadOrderLines(rec.orderID, doc);
+                    for (const ReceiptLine& line : doc.lines) {
+                        StoredReceiptLine l;
+                        l.menuID = line.menuID;
+                        l.quantity = line.quantity;
+                        l.unitCents = ReceiptCodec::toCents(line.price);
+                        l.name = line.menuName;
+                        stored.lines.push_back(l);
+                    }
+                    encoded = ReceiptCodec::encode(stored);
+                }
+
+                writer->add(rec, encoded);
+                pending.push_back(static_cast<int>(rec.receiptID));
+            }
+            flush();
+            if (!alreadyArchived.empty()) {
+                deleteReceipts(alreadyArchived);
+                archivedTotal += static_cast<int>(alreadyArchived.size());
+                cout << GREEN << "[Archive] " << alreadyArchived.size() << " receipts were already archived" << RESET << endl;
+            }
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Archive error: " << e.what() << RESET << endl;
+            return -1;
+        }
+        return archivedTotal;
+    }
+
+    // Runs the archive job at most once per calendar month; a failed run is
+    // retried on the next start
+    void runMonthlyArchival(int monthsToKeep = 3) {
+        string month = formatDateTime(time(0), "%Y%m");
+        if (archive.lastRunMonth() == month) return;
+        if (archiveOldReceipts(monthsToKeep) >= 0) archive.setLastRunMonth(month);
+    }
+
+    // Accountant export: every receipt in [fromDate, toDate) as .ndjson.gz or .csv.gz
+    void exportReceipts(string fromDate, string toDate, bool csv) {
+        try {
+            ensureSchema();
+            string path = "receipts_" + fromDate + "_to_" + toDate + (csv ? ".csv.gz" : ".ndjson.gz");
+
+            auto start = chrono::steady_clock::now();
+            ReceiptExporter exporter(con, archive);
+            long long rows = exporter.exportRange(fromDate, toDate,
+                csv ? ReceiptExporter::CSV : ReceiptExporter::NDJSON, path);
+            double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            if (rows < 0) {
+                cout << RED << "Export failed. Check the dates (YYYY-MM-DD, end after start) and file access." << RESET << endl;
+                return;
+            }
+            cout << GREEN << "Exported " << rows << " receipts to " << path
+                << " in " << fixed << setprecision(2) << secs << " s" << RESET << endl;
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Export error: " << e.what() << RESET << endl;
+        }
+    }
+
+    // ? TAMBAHAN: Fungsi untuk search receipts by customer
+    // Names resolve to CustomerIDs through the in-memory index; receipts are then
+    // read with an index range on (CustomerID, GeneratedDate), one page at a time.
+    void searchReceiptsByCustomer(string customerName) {
+        const int pageSize = 20;
+        try {
+            ensureSchema();
+            customerIndex.refresh(con);
+            vector<int> customerIDs = customerIndex.lookup(customerName);
+
+            cout << "\n" << BOLD << CYAN << "=== SEARCH RESULTS FOR: " << customerName << " ===" << RESET << endl;
+            if (customerIDs.empty()) {
+                cout << YELLOW << "No receipts found for customer: " << customerName << RESET << endl;
+                return;
+            }
+
+            string idList;
+            for (size_t i = 0; i < customerIDs.size(); i++) {
+                if (i > 0) idList += ",";
+                idList += to_string(customerIDs[i]);
+            }
+
+            cout << left << setw(12) << "Receipt ID"
+                << setw(12) << "Order ID"
+                << setw(22) << "Date"
+                << setw(20) << "Customer"
+                << "Amount" << endl;
+            cout << string(80, '-') << endl;
+
+            // Keyset pagination: continue strictly after the last (date, id) shown
+            unique_ptr<sql::PreparedStatement> firstPage(con->prepareStatement(
+                "SELECT ReceiptID, OrdersID, CustomerID, GeneratedDate, TotalAmount "
+                "FROM receipt_history WHERE CustomerID IN (" + idList + ") "
+                "ORDER BY GeneratedDate DESC, ReceiptID DESC LIMIT " + to_string(pageSize)
+            ));
+            unique_ptr<sql::PreparedStatement> nextPage(con->prepareStatement(
+                "SELECT ReceiptID, OrdersID, CustomerID, GeneratedDate, TotalAmount "
+                "FROM receipt_history WHERE CustomerID IN (" + idList + ") "
+                "AND (GeneratedDate < ? OR (GeneratedDate = ? AND ReceiptID < ?)) "
+                "ORDER BY GeneratedDate DESC, ReceiptID DESC LIMIT " + to_string(pageSize)
+            ));
+
+            int count = 0;
+            string lastDate;
+            int lastID = 0;
+            bool more = true;
+            bool firstRound = true;
+
+            while (more) {
+                sql::PreparedStatement* page = firstPage.get();
+                if (!firstRound) {
+                    nextPage->setString(1, lastDate);
+                    nextPage->setString(2, lastDate);
+                    nextPage->setInt(3, lastID);
+                    page = nextPage.get();
+                }
+                firstRound = false;
+
+                unique_ptr<sql::ResultSet> res(page->executeQuery());
+                int rows = 0;
+                while (res->next()) {
+                    rows++;
+                    count++;
+                    lastID = res->getInt("ReceiptID");
+                    lastDate = res->getString("GeneratedDate");
+                    cout << left << setw(12) << lastID
+                        << setw(12) << res->getInt("OrdersID")
+                        << setw(22) << lastDate
+                        << setw(20) << customerIndex.nameOf(res->getInt("CustomerID"))
+                        << "RM" << fixed << setprecision(2) << res->getDouble("TotalAmount") << endl;
+                }
+
+                more = (rows == pageSize);
+                if (more) {
+                    cout << YELLOW << "-- Show more? (y/n): " << RESET;
+                    char answer;
+                    cin >> answer;
+                    more = (answer == 'y' || answer == 'Y');
+                }
+            }
+
+            // Archived receipts for the same customers, via the segment postings
+            for (int customerID : customerIDs) {
+                for (const ArchivedReceiptRef& ref : archive.findByCustomer(customerID)) {
+                    count++;
+                    cout << left << setw(12) << ref.header.receiptID
+                        << setw(12) << ref.header.orderID
+                        << setw(22) << formatDateTime(static_cast<time_t>(ref.header.generatedAt), "%Y-%m-%d %H:%M:%S")
+                        << setw(20) << customerIndex.nameOf(customerID)
+                        << "RM" << fixed << setprecision(2) << ref.header.totalCents / 100.0
+                        << YELLOW << "  (archived)" << RESET << endl;
+                }
+            }
+
+            if (count == 0) {
+                cout << YELLOW << "No receipts found for customer: " << customerName << RESET << endl;
+            }
+            else {
+                cout << string(80, '-') << endl;
+                cout << GREEN << "Total found: " << count << RESET << endl;
+            }
+        }
+        catch (sql::SQLException& e) {
+            cerr << RED << "Search error: " << e.what() << RESET << endl;
+        }
+    }
+};
+
 #endif
\ No newline at end of file
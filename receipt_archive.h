@@ -0,0 +1,422 @@
+#ifndef RECEIPT_ARCHIVE_H
+#define RECEIPT_ARCHIVE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Append-only receipt archive.
+// Old receipts are moved out of receipt_history into immutable segment files
+// under receipt_archive/. Each segment is memory-mapped and carries a sorted
+// (ReceiptID -> offset) index plus per-customer postings, so lookups are a
+// binary search and records are read in place without copying.
+//
+// Segment layout (little-endian, as written on x86/x64):
+//   SegmentHeader
+//   records   : ArchivedRecordHeader + ReceiptCodec bytes, back to back
+//   index     : SegmentIndexEntry[recordCount], sorted by receiptID
+//   customers : SegmentCustomerEntry[customerCount], sorted by customerID
+//   postings  : uint32_t receiptID[], grouped per customer, ascending
+// Segments are written to a .tmp file and renamed once complete, then listed
+// in receipt_archive/MANIFEST. Records are variable length, so nothing after
+// the header is aligned; fields are copied out with memcpy, never cast.
+
+struct SegmentHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t customerCount;
+    uint64_t indexOffset;
+    uint64_t customerOffset;
+    uint64_t postingsOffset;
+    int64_t minTime;
+    int64_t maxTime;
+};
+
+struct SegmentIndexEntry {
+    uint32_t receiptID;
+    uint32_t length;
+    uint64_t offset;
+};
+
+struct SegmentCustomerEntry {
+    uint32_t customerID;
+    uint32_t count;
+    uint64_t first;     // position in the postings array
+};
+
+struct ArchivedRecordHeader {
+    uint32_t receiptID;
+    uint32_t orderID;
+    uint32_t customerID;
+    uint32_t reserved;
+    int64_t generatedAt;
+    int64_t totalCents;
+};
+
+// Header copied out of a mapped segment; the codec bytes are read in place
+struct ArchivedReceiptRef {
+    ArchivedRecordHeader header = {};
+    const char* data = nullptr;     // ReceiptCodec bytes
+    size_t length = 0;
+};
+
+class MappedFile {
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+#else
+    FILE* fp = nullptr;     // stdio rather than unistd.h, whose pause() clashes with main.cpp
+#endif
+    const char* base = nullptr;
+    size_t length = 0;
+
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return false;
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) return false;
+        base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        length = static_cast<size_t>(size.QuadPart);
+#else
+        fp = fopen(path.c_str(), "rb");
+        if (!fp) return false;
+        struct stat st;
+        if (fstat(fileno(fp), &st) != 0 || st.st_size == 0) return false;
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fileno(fp), 0);
+        if (p == MAP_FAILED) return false;
+        base = static_cast<const char*>(p);
+        length = static_cast<size_t>(st.st_size);
+#endif
+        return base != nullptr;
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (base) munmap(const_cast<char*>(base), length);
+        if (fp) fclose(fp);
+#endif
+    }
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+class ArchiveSegment {
+private:
+    MappedFile file;
+    SegmentHeader header = {};
+    const char* index = nullptr;
+    const char* customers = nullptr;
+    const char* postings = nullptr;
+
+    template <typename T>
+    static T load(const char* base, size_t i) {
+        T value;
+        memcpy(&value, base + i * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    SegmentIndexEntry indexAt(size_t i) const { return load<SegmentIndexEntry>(index, i); }
+    SegmentCustomerEntry customerAt(size_t i) const { return load<SegmentCustomerEntry>(customers, i); }
+    uint32_t postingAt(size_t i) const { return load<uint32_t>(postings, i); }
+
+    bool inBounds(uint64_t offset, uint64_t bytes) const {
+        return offset <= file.size() && bytes <= file.size() - offset;
+    }
+
+    bool refAt(const SegmentIndexEntry& entry, ArchivedReceiptRef& out) const {
+        if (!inBounds(entry.offset, entry.length) || entry.length < sizeof(ArchivedRecordHeader)) return false;
+
+        const char* p = file.data() + entry.offset;
+        memcpy(&out.header, p, sizeof(ArchivedRecordHeader));
+        out.data = p + sizeof(ArchivedRecordHeader);
+        out.length = entry.length - sizeof(ArchivedRecordHeader);
+        return true;
+    }
+
+public:
+    std::string name;
+
+    bool open(const std::string& path) {
+        if (!file.open(path) || file.size() < sizeof(SegmentHeader)) return false;
+        memcpy(&header, file.data(), sizeof(SegmentHeader));
+        if (memcmp(header.magic, "FXRA", 4) != 0 || header.version != 1) return false;
+        if (header.postingsOffset > file.size()) return false;
+
+        uint64_t postingBytes = file.size() - header.postingsOffset;
+        if (!inBounds(header.indexOffset, uint64_t(header.recordCount) * sizeof(SegmentIndexEntry))
+            || !inBounds(header.customerOffset, uint64_t(header.customerCount) * sizeof(SegmentCustomerEntry))
+            || !inBounds(header.postingsOffset, postingBytes)) return false;
+
+        index = file.data() + header.indexOffset;
+        customers = file.data() + header.customerOffset;
+        postings = file.data() + header.postingsOffset;
+        return true;
+    }
+
+    uint32_t recordCount() const { return header.recordCount; }
+    uint32_t minReceiptID() const { return header.recordCount ? indexAt(0).receiptID : 0; }
+    uint32_t maxReceiptID() const { return header.recordCount ? indexAt(header.recordCount - 1).receiptID : 0; }
+
+    bool find(uint32_t receiptID, ArchivedReceiptRef& out) const {
+        size_t lo = 0, hi = header.recordCount;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (indexAt(mid).receiptID < receiptID) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == header.recordCount) return false;
+        SegmentIndexEntry entry = indexAt(lo);
+        if (entry.receiptID != receiptID) return false;
+        return refAt(entry, out);
+    }
+
+    int64_t minTime() const { return header.minTime; }
+    int64_t maxTime() const { return header.maxTime; }
+
+    // Visits records with from <= generatedAt < to, in ReceiptID order
+    template <typename Visitor>
+    void forEachBetween(int64_t from, int64_t to, Visitor visit) const {
+        for (uint32_t i = 0; i < header.recordCount; i++) {
+            ArchivedReceiptRef ref;
+            if (!refAt(indexAt(i), ref)) continue;
+            if (ref.header.generatedAt >= from && ref.header.generatedAt < to) visit(ref);
+        }
+    }
+
+    void findByCustomer(uint32_t customerID, std::vector<ArchivedReceiptRef>& out) const {
+        size_t lo = 0, hi = header.customerCount;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (customerAt(mid).customerID < customerID) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == header.customerCount) return;
+        SegmentCustomerEntry entry = customerAt(lo);
+        if (entry.customerID != customerID || entry.first + entry.count > header.recordCount) return;
+
+        for (uint32_t i = 0; i < entry.count; i++) {
+            ArchivedReceiptRef ref;
+            if (find(postingAt(static_cast<size_t>(entry.first + i)), ref)) out.push_back(ref);
+        }
+    }
+};
+
+// Builds one segment. Records stream to disk; only the index stays in memory.
+class ArchiveSegmentWriter {
+private:
+    std::ofstream out;
+    std::string tmpPath, finalPath;
+    SegmentHeader header;
+    std::vector<SegmentIndexEntry> index;
+    std::vector<std::pair<uint32_t, uint32_t>> customerReceipts;   // (customerID, receiptID)
+    uint64_t position = 0;
+
+    void write(const void* p, size_t n) {
+        out.write(static_cast<const char*>(p), n);
+        position += n;
+    }
+
+public:
+    bool begin(const std::string& path) {
+        finalPath = path;
+        tmpPath = path + ".tmp";
+        out.open(tmpPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "FXRA", 4);
+        header.version = 1;
+        header.minTime = INT64_MAX;
+        header.maxTime = INT64_MIN;
+        write(&header, sizeof(header));   // rewritten in finish()
+        return true;
+    }
+
+    void add(const ArchivedRecordHeader& rec, const std::string& encoded) {
+        SegmentIndexEntry entry = { rec.receiptID,
+            static_cast<uint32_t>(sizeof(rec) + encoded.size()), position };
+        write(&rec, sizeof(rec));
+        write(encoded.data(), encoded.size());
+
+        index.push_back(entry);
+        customerReceipts.push_back(std::make_pair(rec.customerID, rec.receiptID));
+        header.minTime = std::min<int64_t>(header.minTime, rec.generatedAt);
+        header.maxTime = std::max<int64_t>(header.maxTime, rec.generatedAt);
+    }
+
+    size_t count() const { return index.size(); }
+
+    bool finish() {
+        std::sort(index.begin(), index.end(),
+            [](const SegmentIndexEntry& a, const SegmentIndexEntry& b) { return a.receiptID < b.receiptID; });
+        std::sort(customerReceipts.begin(), customerReceipts.end());
+
+        std::vector<SegmentCustomerEntry> customers;
+        std::vector<uint32_t> postings;
+        for (size_t i = 0; i < customerReceipts.size(); i++) {
+            if (customers.empty() || customers.back().customerID != customerReceipts[i].first) {
+                SegmentCustomerEntry c = { customerReceipts[i].first, 0, postings.size() };
+                customers.push_back(c);
+            }
+            customers.back().count++;
+            postings.push_back(customerReceipts[i].second);
+        }
+
+        header.recordCount = static_cast<uint32_t>(index.size());
+        header.customerCount = static_cast<uint32_t>(customers.size());
+        header.indexOffset = position;
+        if (!index.empty()) write(index.data(), index.size() * sizeof(SegmentIndexEntry));
+        header.customerOffset = position;
+        if (!customers.empty()) write(customers.data(), customers.size() * sizeof(SegmentCustomerEntry));
+        header.postingsOffset = position;
+        if (!postings.empty()) write(postings.data(), postings.size() * sizeof(uint32_t));
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (out.fail()) return false;
+        return std::rename(tmpPath.c_str(), finalPath.c_str()) == 0;
+    }
+};
+
+class ReceiptArchive {
+private:
+    std::string dir;
+    std::vector<std::unique_ptr<ArchiveSegment>> segments;
+
+    std::string manifestPath() const { return dir + "/MANIFEST"; }
+
+    static bool fileExists(const std::string& path) {
+        std::ifstream f(path.c_str(), std::ios::binary);
+        return f.good();
+    }
+
+    static void makeDirectory(const std::string& path) {
+#ifdef _WIN32
+        CreateDirectoryA(path.c_str(), NULL);
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    bool openSegment(const std::string& name) {
+        std::unique_ptr<ArchiveSegment> seg(new ArchiveSegment());
+        seg->name = name;
+        if (!seg->open(dir + "/" + name)) return false;
+        segments.push_back(std::move(seg));
+        return true;
+    }
+
+public:
+    ReceiptArchive(const std::string& directory = "receipt_archive") : dir(directory) {}
+
+    // Maps every segment listed in the manifest
+    void open() {
+        segments.clear();
+        std::ifstream manifest(manifestPath().c_str());
+        std::string name;
+        while (std::getline(manifest, name)) {
+            if (!name.empty() && name.back() == '\r') name.pop_back();
+            if (!name.empty()) openSegment(name);
+        }
+    }
+
+    // Starts a new segment for the given month (YYYYMM); never reuses a file name
+    bool beginSegment(const std::string& month, ArchiveSegmentWriter& writer, std::string& name) {
+        makeDirectory(dir);
+        name = "receipts_" + month + ".seg";
+        for (int n = 2; fileExists(dir + "/" + name); n++) {
+            name = "receipts_" + month + "_" + std::to_string(n) + ".seg";
+        }
+        return writer.begin(dir + "/" + name);
+    }
+
+    // Publishes a finished segment
+    bool commitSegment(ArchiveSegmentWriter& writer, const std::string& name) {
+        if (!writer.finish()) return false;
+        std::ofstream manifest(manifestPath().c_str(), std::ios::app);
+        manifest << name << "\n";
+        manifest.close();
+        return !manifest.fail() && openSegment(name);
+    }
+
+    bool find(int receiptID, ArchivedReceiptRef& out) const {
+        uint32_t id = static_cast<uint32_t>(receiptID);
+        for (const auto& seg : segments) {
+            if (id >= seg->minReceiptID() && id <= seg->maxReceiptID() && seg->find(id, out)) return true;
+        }
+        return false;
+    }
+
+    std::vector<ArchivedReceiptRef> findByCustomer(int customerID) const {
+        std::vector<ArchivedReceiptRef> out;
+        for (const auto& seg : segments) seg->findByCustomer(static_cast<uint32_t>(customerID), out);
+        return out;
+    }
+
+    template <typename Visitor>
+    void forEachBetween(int64_t from, int64_t to, Visitor visit) const {
+        for (const auto& seg : segments) {
+            if (seg->maxTime() < from || seg->minTime() >= to) continue;
+            seg->forEachBetween(from, to, visit);
+        }
+    }
+
+    size_t segmentCount() const { return segments.size(); }
+
+    size_t receiptCount() const {
+        size_t total = 0;
+        for (const auto& seg : segments) total += seg->recordCount();
+        return total;
+    }
+
+    // Month marker so the archival job runs once per month
+    std::string lastRunMonth() const {
+        std::ifstream f((dir + "/LAST_RUN").c_str());
+        std::string month;
+        std::getline(f, month);
+        return month;
+    }
+
+    void setLastRunMonth(const std::string& month) {
+        makeDirectory(dir);
+        std::ofstream f((dir + "/LAST_RUN").c_str(), std::ios::trunc);
+        f << month << "\n";
+    }
+};
+
+#endif
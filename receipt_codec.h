@@ -0,0 +1,177 @@
+#ifndef RECEIPT_CODEC_H
+#define RECEIPT_CODEC_H
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact binary receipt record stored in receipt_history.ReceiptData.
+// Layout (all integers are unsigned LEB128 varints, money in sen):
+//   'R' version flags
+//   orderID customerID issuedAt(unix seconds)
+//   paymentCode [paymentMethod string when code == OTHER]
+//   name phone address            (customer snapshot, length-prefixed)
+//   serviceTax deliveryFee lineCount
+//   lineCount x { menuID quantity unitPrice name }
+// A typical 3-item order encodes to ~120 bytes.
+
+struct StoredReceiptLine {
+    int menuID = 0;
+    int quantity = 0;
+    long long unitCents = 0;    // price at purchase time
+    std::string name;
+};
+
+struct StoredReceipt {
+    int orderID = 0;
+    int customerID = 0;
+    long long issuedAt = 0;
+    std::string paymentMethod;
+    std::string custName, custPhone, custAddress;
+    long long serviceTaxCents = 0;
+    long long deliveryFeeCents = 0;
+    std::vector<StoredReceiptLine> lines;
+
+    long long subtotalCents() const {
+        long long total = 0;
+        for (const auto& line : lines) total += line.unitCents * line.quantity;
+        return total;
+    }
+
+    long long grandTotalCents() const {
+        return subtotalCents() + serviceTaxCents + deliveryFeeCents;
+    }
+};
+
+class ReceiptCodec {
+private:
+    enum { MAGIC = 'R', VERSION = 1 };
+
+    // Payment methods offered at checkout get a one-byte code
+    static const char* const* paymentMethods() {
+        static const char* const methods[] = { "Cash", "Online Banking", "Credit Card", "E-Wallet" };
+        return methods;
+    }
+    enum { PAYMENT_METHOD_COUNT = 4, PAYMENT_OTHER = 0x7f };
+
+    static void putVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    static void putString(std::string& out, const std::string& s) {
+        putVarint(out, s.size());
+        out.append(s);
+    }
+
+    static bool getVarint(const unsigned char*& p, const unsigned char* end, uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64 && p < end; shift += 7) {
+            unsigned char b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    static bool getInt(const unsigned char*& p, const unsigned char* end, T& out) {
+        uint64_t v;
+        if (!getVarint(p, end, v)) return false;
+        out = static_cast<T>(v);
+        return true;
+    }
+
+    static bool getString(const unsigned char*& p, const unsigned char* end, std::string& s) {
+        uint64_t len;
+        if (!getVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+        s.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(len));
+        p += len;
+        return true;
+    }
+
+public:
+    static long long toCents(double amount) {
+        return static_cast<long long>(llround(amount * 100.0));
+    }
+
+    static std::string encode(const StoredReceipt& r) {
+        std::string out;
+        out.reserve(64 + r.custAddress.size() + r.lines.size() * 24);
+        out.push_back(static_cast<char>(MAGIC));
+        out.push_back(static_cast<char>(VERSION));
+        out.push_back(0);   // flags, reserved
+
+        putVarint(out, r.orderID);
+        putVarint(out, r.customerID);
+        putVarint(out, r.issuedAt);
+
+        int code = PAYMENT_OTHER;
+        for (int i = 0; i < PAYMENT_METHOD_COUNT; i++) {
+            if (r.paymentMethod == paymentMethods()[i]) code = i;
+        }
+        putVarint(out, code);
+        if (code == PAYMENT_OTHER) putString(out, r.paymentMethod);
+
+        putString(out, r.custName);
+        putString(out, r.custPhone);
+        putString(out, r.custAddress);
+
+        putVarint(out, r.serviceTaxCents);
+        putVarint(out, r.deliveryFeeCents);
+        putVarint(out, r.lines.size());
+        for (const auto& line : r.lines) {
+            putVarint(out, line.menuID);
+            putVarint(out, line.quantity);
+            putVarint(out, line.unitCents);
+            putString(out, line.name);
+        }
+        return out;
+    }
+
+    static bool decode(const std::string& data, StoredReceipt& r) {
+        return decode(data.data(), data.size(), r);
+    }
+
+    static bool decode(const char* data, size_t size, StoredReceipt& r) {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+        const unsigned char* end = p + size;
+        if (size < 3 || p[0] != MAGIC || p[1] != VERSION) return false;
+        p += 3;
+
+        int code = 0;
+        if (!getInt(p, end, r.orderID) || !getInt(p, end, r.customerID)
+            || !getInt(p, end, r.issuedAt) || !getInt(p, end, code)) return false;
+
+        if (code == PAYMENT_OTHER) {
+            if (!getString(p, end, r.paymentMethod)) return false;
+        }
+        else if (code >= 0 && code < PAYMENT_METHOD_COUNT) {
+            r.paymentMethod = paymentMethods()[code];
+        }
+        else {
+            return false;
+        }
+
+        size_t count = 0;
+        if (!getString(p, end, r.custName) || !getString(p, end, r.custPhone)
+            || !getString(p, end, r.custAddress) || !getInt(p, end, r.serviceTaxCents)
+            || !getInt(p, end, r.deliveryFeeCents) || !getInt(p, end, count)) return false;
+
+        r.lines.clear();
+        r.lines.reserve(count < 256 ? count : 256);
+        for (size_t i = 0; i < count; i++) {
+            StoredReceiptLine line;
+            if (!getInt(p, end, line.menuID) || !getInt(p, end, line.quantity)
+                || !getInt(p, end, line.unitCents) || !getString(p, end, line.name)) return false;
+            r.lines.push_back(line);
+        }
+        return p == end;
+    }
+};
+
+#endif
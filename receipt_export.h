@@ -0,0 +1,343 @@
+#ifndef RECEIPT_EXPORT_H
+#define RECEIPT_EXPORT_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include "gzip_writer.h"
+#include "receipt_codec.h"
+#include "receipt_archive.h"
+
+// Double buffer between the database reader and the gzip thread.
+// The reader formats rows into one buffer while the other is being
+// compressed; memory use is two buffers regardless of the export size.
+class ExportBuffers {
+private:
+    GzipWriter& gz;
+    size_t capacity;
+    std::string buffers[2];
+    bool full[2] = { false, false };
+    int active = 0;
+    bool done = false;
+    std::mutex m;
+    std::condition_variable cv;
+    std::thread worker;
+
+    void run() {
+        int next = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return full[next] || done; });
+            if (!full[next]) return;
+            lock.unlock();
+
+            gz.write(buffers[next].data(), buffers[next].size());
+            buffers[next].clear();
+
+            lock.lock();
+            full[next] = false;
+            cv.notify_all();
+            next = 1 - next;
+        }
+    }
+
+    void handOff() {
+        std::unique_lock<std::mutex> lock(m);
+        full[active] = true;
+        cv.notify_all();
+        active = 1 - active;
+        cv.wait(lock, [&] { return !full[active]; });
+    }
+
+public:
+    ExportBuffers(GzipWriter& writer, size_t bufferSize = 256 * 1024) : gz(writer), capacity(bufferSize) {
+        buffers[0].reserve(capacity + 4096);
+        buffers[1].reserve(capacity + 4096);
+        worker = std::thread(&ExportBuffers::run, this);
+    }
+
+    ~ExportBuffers() { finish(); }
+
+    std::string& current() { return buffers[active]; }
+
+    // Called after each row; swaps buffers once the active one is full
+    void rowWritten() {
+        if (buffers[active].size() >= capacity) handOff();
+    }
+
+    void finish() {
+        if (!worker.joinable()) return;
+        if (!buffers[active].empty()) handOff();
+        {
+            std::lock_guard<std::mutex> lock(m);
+            done = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+};
+
+// Streams receipts in [from, to) to a gzip-compressed NDJSON or CSV file.
+// Archived months are read from the mapped segments, the live table in
+// keyset-paginated chunks, so nothing is materialised in full.
+class ReceiptExporter {
+public:
+    enum Format { NDJSON, CSV };
+
+private:
+    sql::Connection* con;
+    const ReceiptArchive& archive;
+    enum { CHUNK_ROWS = 1000 };
+
+    struct Row {
+        long long receiptID = 0, orderID = 0, customerID = 0;
+        std::string date, customerName, paymentMethod;
+        long long subtotal = 0, serviceTax = 0, deliveryFee = 0, total = 0;
+        bool hasItems = false;
+        StoredReceipt receipt;
+    };
+
+    static void appendMoney(std::string& out, long long cents) {
+        char buf[32];
+        int n = snprintf(buf, sizeof(buf), "%s%lld.%02lld", cents < 0 ? "-" : "",
+            (cents < 0 ? -cents : cents) / 100, (cents < 0 ? -cents : cents) % 100);
+        out.append(buf, n);
+    }
+
+    static void appendJsonString(std::string& out, const std::string& s) {
+        out.push_back('"');
+        for (char ch : s) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(ch);
+            }
+            else if (c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out.append(buf);
+            }
+            else {
+                out.push_back(ch);
+            }
+        }
+        out.push_back('"');
+    }
+
+    static void appendCsvField(std::string& out, const std::string& s) {
+        if (s.find_first_of(",\"\r\n") == std::string::npos) {
+            out.append(s);
+            return;
+        }
+        out.push_back('"');
+        for (char ch : s) {
+            if (ch == '"') out.push_back('"');
+            out.push_back(ch);
+        }
+        out.push_back('"');
+    }
+
+    static std::string formatTime(time_t when) {
+        tm t = {};
+#ifdef _WIN32
+        localtime_s(&t, &when);
+#else
+        localtime_r(&when, &t);
+#endif
+        char buf[32];
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &t);
+        return buf;
+    }
+
+    static void appendRow(std::string& out, const Row& r, Format format) {
+        if (format == CSV) {
+            out.append(std::to_string(r.receiptID)).push_back(',');
+            out.append(std::to_string(r.orderID)).push_back(',');
+            out.append(std::to_string(r.customerID)).push_back(',');
+            out.append(r.date).push_back(',');
+            appendCsvField(out, r.customerName);
+            out.push_back(',');
+            appendCsvField(out, r.paymentMethod);
+            out.push_back(',');
+            if (r.hasItems) out.append(std::to_string(r.receipt.lines.size()));
+            out.push_back(',');
+            appendMoney(out, r.subtotal);
+            out.push_back(',');
+            appendMoney(out, r.serviceTax);
+            out.push_back(',');
+            appendMoney(out, r.deliveryFee);
+            out.push_back(',');
+            appendMoney(out, r.total);
+            out.append("\r\n");
+            return;
+        }
+
+        out.append("{\"receipt_id\":").append(std::to_string(r.receiptID));
+        out.append(",\"order_id\":").append(std::to_string(r.orderID));
+        out.append(",\"customer_id\":").append(std::to_string(r.customerID));
+        out.append(",\"date\":");
+        appendJsonString(out, r.date);
+        out.append(",\"customer\":");
+        appendJsonString(out, r.customerName);
+        out.append(",\"payment\":");
+        appendJsonString(out, r.paymentMethod);
+        out.append(",\"subtotal\":");
+        appendMoney(out, r.subtotal);
+        out.append(",\"service_tax\":");
+        appendMoney(out, r.serviceTax);
+        out.append(",\"delivery_fee\":");
+        appendMoney(out, r.deliveryFee);
+        out.append(",\"total\":");
+        appendMoney(out, r.total);
+        out.append(",\"items\":");
+        if (!r.hasItems) {
+            out.append("null");     // receipt saved before line items were recorded
+        }
+        else {
+            out.push_back('[');
+            for (size_t i = 0; i < r.receipt.lines.size(); i++) {
+                const StoredReceiptLine& line = r.receipt.lines[i];
+                if (i > 0) out.push_back(',');
+                out.append("{\"menu_id\":").append(std::to_string(line.menuID));
+                out.append(",\"name\":");
+                appendJsonString(out, line.name);
+                out.append(",\"qty\":").append(std::to_string(line.quantity));
+                out.append(",\"unit_price\":");
+                appendMoney(out, line.unitCents);
+                out.push_back('}');
+            }
+            out.push_back(']');
+        }
+        out.append("}\n");
+    }
+
+    static void fillFromRecord(Row& row) {
+        row.hasItems = true;
+        row.customerName = row.receipt.custName;
+        row.paymentMethod = row.receipt.paymentMethod;
+        row.subtotal = row.receipt.subtotalCents();
+        row.serviceTax = row.receipt.serviceTaxCents;
+        row.deliveryFee = row.receipt.deliveryFeeCents;
+        row.total = row.receipt.grandTotalCents();
+    }
+
+public:
+    ReceiptExporter(sql::Connection* conn, const ReceiptArchive& receiptArchive)
+        : con(conn), archive(receiptArchive) {}
+
+    static time_t parseDate(const std::string& date) {
+        tm t = {};
+        char* end = nullptr;
+        t.tm_year = static_cast<int>(strtol(date.c_str(), &end, 10));
+        if (*end != '-') return -1;
+        t.tm_mon = static_cast<int>(strtol(end + 1, &end, 10));
+        if (*end != '-') return -1;
+        t.tm_mday = static_cast<int>(strtol(end + 1, &end, 10));
+        if (*end != '\0') return -1;
+        t.tm_year -= 1900;
+        t.tm_mon -= 1;
+        t.tm_isdst = -1;
+        return mktime(&t);
+    }
+
+    // Dates are YYYY-MM-DD, end exclusive. Returns rows written or -1.
+    long long exportRange(const std::string& fromDate, const std::string& toDate,
+        Format format, const std::string& path) {
+        time_t from = parseDate(fromDate), to = parseDate(toDate);
+        if (from < 0 || to < 0 || to <= from) return -1;
+
+        GzipWriter gz;
+        if (!gz.open(path)) return -1;
+
+        long long rows = 0;
+        {
+            ExportBuffers buffers(gz);
+            if (format == CSV) {
+                buffers.current().append("receipt_id,order_id,customer_id,date,customer,payment,"
+                    "item_count,subtotal,service_tax,delivery_fee,total\r\n");
+            }
+
+            // Archived months first; they are older than anything in the live table
+            Row row;
+            archive.forEachBetween(from, to, [&](const ArchivedReceiptRef& ref) {
+                row.receiptID = ref.header.receiptID;
+                row.orderID = ref.header.orderID;
+                row.customerID = ref.header.customerID;
+                row.date = formatTime(static_cast<time_t>(ref.header.generatedAt));
+                if (!ReceiptCodec::decode(ref.data, ref.length, row.receipt)) return;
+                fillFromRecord(row);
+                appendRow(buffers.current(), row, format);
+                buffers.rowWritten();
+                rows++;
+            });
+
+            std::unique_ptr<sql::PreparedStatement> pstmt(con->prepareStatement(
+                "SELECT rh.ReceiptID, rh.OrdersID, rh.CustomerID, rh.GeneratedDate, rh.PaymentMethod, "
+                "rh.TotalAmount, rh.SubTotal, rh.ServiceTax, rh.DeliveryFee, rh.ReceiptData, c.Customer_Name "
+                "FROM receipt_history rh LEFT JOIN customer c ON c.CustomerID = rh.CustomerID "
+                "WHERE rh.GeneratedDate >= ? AND rh.GeneratedDate < ? "
+                "AND (rh.GeneratedDate > ? OR (rh.GeneratedDate = ? AND rh.ReceiptID > ?)) "
+                "ORDER BY rh.GeneratedDate, rh.ReceiptID LIMIT " + std::to_string(CHUNK_ROWS)));
+
+            std::string lastDate = fromDate + " 00:00:00";
+            long long lastID = -1;
+            bool more = true;
+            while (more) {
+                pstmt->setString(1, fromDate);
+                pstmt->setString(2, toDate);
+                pstmt->setString(3, lastDate);
+                pstmt->setString(4, lastDate);
+                pstmt->setInt64(5, lastID);
+                std::unique_ptr<sql::ResultSet> res(pstmt->executeQuery());
+
+                int chunk = 0;
+                while (res->next()) {
+                    chunk++;
+                    row.receiptID = res->getInt64("ReceiptID");
+                    row.orderID = res->getInt64("OrdersID");
+                    row.customerID = res->getInt64("CustomerID");
+                    row.date = res->getString("GeneratedDate");
+                    lastDate = row.date;
+                    lastID = row.receiptID;
+
+                    std::string encoded;
+                    if (!res->isNull("ReceiptData")) {
+                        std::unique_ptr<std::istream> blob(res->getBlob("ReceiptData"));
+                        encoded.assign(std::istreambuf_iterator<char>(*blob), std::istreambuf_iterator<char>());
+                    }
+                    if (!encoded.empty() && ReceiptCodec::decode(encoded, row.receipt)) {
+                        fillFromRecord(row);
+                    }
+                    else {
+                        row.hasItems = false;
+                        row.customerName = res->getString("Customer_Name");
+                        row.paymentMethod = res->getString("PaymentMethod");
+                        row.subtotal = ReceiptCodec::toCents(res->getDouble("SubTotal"));
+                        row.serviceTax = ReceiptCodec::toCents(res->getDouble("ServiceTax"));
+                        row.deliveryFee = ReceiptCodec::toCents(res->getDouble("DeliveryFee"));
+                        row.total = ReceiptCodec::toCents(res->getDouble("TotalAmount"));
+                    }
+
+                    appendRow(buffers.current(), row, format);
+                    buffers.rowWritten();
+                    rows++;
+                }
+                more = (chunk == CHUNK_ROWS);
+            }
+            buffers.finish();
+        }
+
+        if (!gz.close()) return -1;
+        return rows;
+    }
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef RECEIPT_TEMPLATE_H
+#define RECEIPT_TEMPLATE_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Precompiled receipt layout.
+// A template is built once into a flat list of literal / style / field segments
+// and rendered into a reusable buffer. Numbers are formatted with snprintf into a
+// stack buffer (our v143 toolset builds as C++14, so no std::format_to), which
+// keeps a warm render free of heap allocations.
+
+// Value slot filled by the caller before each render. Strings are borrowed, not copied.
+struct ReceiptValue {
+    enum Type { NONE, STR, INT, REAL };
+    Type type = NONE;
+    const char* str = nullptr;
+    size_t len = 0;
+    long long i = 0;
+    double d = 0.0;
+};
+
+class ReceiptValues {
+private:
+    std::vector<ReceiptValue> slots;
+
+public:
+    ReceiptValues(int fieldCount) : slots(fieldCount) {}
+
+    void setString(int id, const std::string& s) {
+        slots[id].type = ReceiptValue::STR;
+        slots[id].str = s.data();
+        slots[id].len = s.size();
+    }
+
+    void setString(int id, const char* s, size_t len) {
+        slots[id].type = ReceiptValue::STR;
+        slots[id].str = s;
+        slots[id].len = len;
+    }
+
+    void setInt(int id, long long v) {
+        slots[id].type = ReceiptValue::INT;
+        slots[id].i = v;
+    }
+
+    void setDouble(int id, double v) {
+        slots[id].type = ReceiptValue::REAL;
+        slots[id].d = v;
+    }
+
+    const ReceiptValue& get(int id) const { return slots[id]; }
+};
+
+// Output buffer that keeps its capacity between renders.
+class RenderBuffer {
+private:
+    std::string data;
+
+public:
+    RenderBuffer(size_t capacity = 8192) { data.reserve(capacity); }
+
+    void clear() { data.clear(); }
+    void append(const char* s, size_t n) { data.append(s, n); }
+    void pad(size_t n, char c = ' ') { data.append(n, c); }
+    const char* c_str() const { return data.c_str(); }
+    size_t size() const { return data.size(); }
+    const std::string& str() const { return data; }
+};
+
+class ReceiptTemplate {
+public:
+    enum Align { LEFT, RIGHT };
+
+private:
+    enum Kind { LITERAL, STYLE, FIELD };
+
+    struct Segment {
+        Kind kind;
+        size_t offset;      // into pool (LITERAL / STYLE)
+        size_t length;
+        int field;          // FIELD only
+        int width;
+        Align align;
+        int precision;      // -1 = default formatting
+    };
+
+    std::string pool;
+    std::vector<Segment> segments;
+
+    void appendLiteral(const char* s, size_t n, Kind kind) {
+        if (n == 0) return;
+        // Adjacent literals share one segment since the pool is contiguous
+        if (kind == LITERAL && !segments.empty() && segments.back().kind == LITERAL
+            && segments.back().offset + segments.back().length == pool.size()) {
+            pool.append(s, n);
+            segments.back().length += n;
+            return;
+        }
+        Segment seg = { kind, pool.size(), n, -1, 0, LEFT, -1 };
+        pool.append(s, n);
+        segments.push_back(seg);
+    }
+
+    static void emitPadded(RenderBuffer& out, const char* s, size_t n, int width, Align align) {
+        size_t padding = (width > 0 && n < static_cast<size_t>(width)) ? width - n : 0;
+        if (align == RIGHT) out.pad(padding);
+        out.append(s, n);
+        if (align == LEFT) out.pad(padding);
+    }
+
+public:
+    ReceiptTemplate& text(const char* s) {
+        appendLiteral(s, strlen(s), LITERAL);
+        return *this;
+    }
+
+    ReceiptTemplate& text(const std::string& s) {
+        appendLiteral(s.data(), s.size(), LITERAL);
+        return *this;
+    }
+
+    // Text padded to a fixed column width at compile time (same as setw)
+    ReceiptTemplate& text(const std::string& s, int width, Align align = LEFT) {
+        std::string padded = s;
+        if (static_cast<int>(s.size()) < width) {
+            std::string fill(width - s.size(), ' ');
+            padded = (align == LEFT) ? s + fill : fill + s;
+        }
+        return text(padded);
+    }
+
+    // ANSI escape; skipped when rendering the plain-text copy
+    ReceiptTemplate& style(const char* ansi) {
+        appendLiteral(ansi, strlen(ansi), STYLE);
+        return *this;
+    }
+
+    // Centered line; padding is worked out here instead of on every render
+    ReceiptTemplate& centered(const std::string& s, int width = 70) {
+        int padding = (width - static_cast<int>(s.length())) / 2;
+        if (padding > 0) text(std::string(padding, ' '));
+        text(s);
+        return text("\n");
+    }
+
+    ReceiptTemplate& rule(char c, int width = 70) {
+        text(std::string(width, c));
+        return text("\n");
+    }
+
+    ReceiptTemplate& field(int id, int width = 0, Align align = LEFT, int precision = -1) {
+        Segment seg = { FIELD, 0, 0, id, width, align, precision };
+        segments.push_back(seg);
+        return *this;
+    }
+
+    size_t segmentCount() const { return segments.size(); }
+
+    // Appends to out; caller clears the buffer when starting a new document
+    void render(const ReceiptValues& values, RenderBuffer& out, bool plain = false) const {
+        char num[64];
+        const char* base = pool.data();
+
+        for (const Segment& seg : segments) {
+            if (seg.kind == LITERAL) {
+                out.append(base + seg.offset, seg.length);
+                continue;
+            }
+            if (seg.kind == STYLE) {
+                if (!plain) out.append(base + seg.offset, seg.length);
+                continue;
+            }
+
+            const ReceiptValue& v = values.get(seg.field);
+            int n = 0;
+            switch (v.type) {
+            case ReceiptValue::STR:
+                emitPadded(out, v.str, v.len, seg.width, seg.align);
+                break;
+            case ReceiptValue::INT:
+                n = snprintf(num, sizeof(num), "%lld", v.i);
+                emitPadded(out, num, n, seg.width, seg.align);
+                break;
+            case ReceiptValue::REAL:
+                n = snprintf(num, sizeof(num), "%.*f", seg.precision < 0 ? 2 : seg.precision, v.d);
+                emitPadded(out, num, n, seg.width, seg.align);
+                break;
+            default:
+                emitPadded(out, "", 0, seg.width, seg.align);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef REPORT_SCHEDULER_H
+#define REPORT_SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/driver.h>
+#include <cppconn/exception.h>
+#include "database.h"
+
+// Fixed pool of report workers, each with its own read connection, so owner
+// reports run side by side and never hold the shared connection that
+// checkout uses. The worker count is the concurrency cap on the database.
+// Connections are opened lazily on the worker's own thread and reopened if
+// they go bad; a failing query surfaces through the task's future.
+class ReportScheduler {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void(sql::Connection*)>> tasks;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void workerLoop() {
+        sql::Driver* driver = get_driver_instance();
+        driver->threadInit();
+        std::unique_ptr<sql::Connection> con;
+
+        while (true) {
+            std::function<void(sql::Connection*)> task;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) break;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            try {
+                if (!con || !con->isValid()) con.reset(openConnection());
+            }
+            catch (sql::SQLException&) {
+                con.reset();
+            }
+            task(con.get());     // a null connection makes the task fail through its future
+        }
+
+        con.reset();
+        driver->threadEnd();
+    }
+
+public:
+    explicit ReportScheduler(unsigned maxConcurrent = 4) {
+        if (maxConcurrent == 0) maxConcurrent = 1;
+        for (unsigned i = 0; i < maxConcurrent; i++) {
+            workers.emplace_back(&ReportScheduler::workerLoop, this);
+        }
+    }
+
+    ~ReportScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    ReportScheduler(const ReportScheduler&) = delete;
+    ReportScheduler& operator=(const ReportScheduler&) = delete;
+
+    unsigned concurrency() const { return static_cast<unsigned>(workers.size()); }
+
+    // Queues fn(connection) on a worker; the future yields its result or exception
+    template <typename Fn>
+    auto submit(Fn fn) -> std::future<decltype(fn(std::declval<sql::Connection*>()))> {
+        typedef decltype(fn(std::declval<sql::Connection*>())) Result;
+        auto task = std::make_shared<std::packaged_task<Result(sql::Connection*)>>(
+            [fn](sql::Connection* con) -> Result {
+                if (!con) throw sql::SQLException("Report connection unavailable");
+                return fn(con);
+            });
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m);
+            tasks.push_back([task](sql::Connection* con) { (*task)(con); });
+        }
+        cv.notify_one();
+        return result;
+    }
+};
+
+#endif
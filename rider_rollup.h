@@ -0,0 +1,248 @@
+#ifndef RIDER_ROLLUP_H
+#define RIDER_ROLLUP_H
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+#include "delivery_log.h"
+
+// Per-rider delivery performance, updated as each delivery completes, so
+// scorecards and the owner's rider list read a few rows per rider instead
+// of the delivery_event history.
+//   rider_rollup_day  : per rider and day (deliveries, earnings, drop time)
+//   rider_rollup_drop : per rider and day, deliveries by whole minutes from
+//                       pickup to drop-off (capped at MAX_MINUTES), for the
+//                       median over the same window
+// Pickup is the first 'Out for Delivery' event, else 'Accepted'; deliveries
+// with neither are counted but not timed. Riders earn payPerDelivery each.
+struct RiderScore {
+    int riderID = 0;
+    long long deliveries = 0;           // last `days` days
+    int activeDays = 0;
+    long long deliveriesToday = 0;
+    double earnings = 0.0;              // last `days` days
+    double earningsToday = 0.0;
+    double avgDropMinutes = -1.0;       // -1 when no timed deliveries
+    double medianDropMinutes = -1.0;    // last `days` days
+
+    double perActiveDay() const { return activeDays > 0 ? static_cast<double>(deliveries) / activeDays : 0.0; }
+};
+
+class RiderRollup {
+private:
+    sql::Connection* conn;
+    double payPerDelivery;
+    bool schemaChecked = false;
+
+    // Completed orders with their rider, completion and pickup times
+    static const char* completedDeliveries() {
+        return
+            "SELECT o.DeliveryID, COALESCE(MIN(CASE WHEN e.Status = 'Completed' THEN e.EventTime END), o.OrdersDate) AS doneAt, "
+            "COALESCE(MIN(CASE WHEN e.Status = 'Out for Delivery' THEN e.EventTime END), "
+            "MIN(CASE WHEN e.Status = 'Accepted' THEN e.EventTime END)) AS pickedAt "
+            "FROM orders o LEFT JOIN delivery_event e ON e.OrdersID = o.OrdersID "
+            "WHERE o.Orders_status = 'Completed' AND o.DeliveryID IS NOT NULL "
+            "GROUP BY o.OrdersID, o.DeliveryID, o.OrdersDate";
+    }
+
+public:
+    enum { MAX_MINUTES = 240 };
+
+    RiderRollup(sql::Connection* connection, double riderPayPerDelivery = 5.00)
+        : conn(connection), payPerDelivery(riderPayPerDelivery) {}
+
+    // Creates the rollup tables on first use and backfills them from
+    // history. True when the backfill ran, i.e. every completed order so far
+    // is already counted.
+    bool ensureSchema() {
+        if (schemaChecked) return false;
+        DeliveryLog::ensureSchema(conn);
+        bool fresh = !tableExists(conn, "rider_rollup_day");
+
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        // The histogram used to be all-time; rebuild it per day
+        if (tableExists(conn, "rider_rollup_drop") && !columnExists(conn, "rider_rollup_drop", "StatDate")) {
+            stmt->execute("DROP TABLE rider_rollup_drop");
+            fresh = true;
+        }
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS rider_rollup_day ("
+            "DeliveryID INT NOT NULL, StatDate DATE NOT NULL, "
+            "Deliveries INT NOT NULL DEFAULT 0, TimedDeliveries INT NOT NULL DEFAULT 0, "
+            "DropSeconds BIGINT NOT NULL DEFAULT 0, Earnings DECIMAL(12,2) NOT NULL DEFAULT 0, "
+            "PRIMARY KEY (DeliveryID, StatDate))");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS rider_rollup_drop ("
+            "DeliveryID INT NOT NULL, StatDate DATE NOT NULL, DropMinutes SMALLINT NOT NULL, "
+            "Deliveries INT NOT NULL DEFAULT 0, "
+            "PRIMARY KEY (DeliveryID, StatDate, DropMinutes))");
+
+        schemaChecked = true;
+        if (fresh) rebuild();
+        return fresh;
+    }
+
+    // Recomputes both rollups from orders and delivery_event (one-off backfill / repair)
+    void rebuild() {
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        stmt->execute("DELETE FROM rider_rollup_day");
+        stmt->execute("DELETE FROM rider_rollup_drop");
+
+        std::unique_ptr<sql::PreparedStatement> dayStmt(conn->prepareStatement(
+            std::string("INSERT INTO rider_rollup_day (DeliveryID, StatDate, Deliveries, TimedDeliveries, DropSeconds, Earnings) "
+                "SELECT DeliveryID, DATE(doneAt), COUNT(*), COUNT(pickedAt), "
+                "IFNULL(SUM(GREATEST(TIMESTAMPDIFF(SECOND, pickedAt, doneAt), 0)), 0), COUNT(*) * ? "
+                "FROM (") + completedDeliveries() + ") d GROUP BY DeliveryID, DATE(doneAt)"));
+        dayStmt->setDouble(1, payPerDelivery);
+        dayStmt->executeUpdate();
+
+        stmt->execute(
+            std::string("INSERT INTO rider_rollup_drop (DeliveryID, StatDate, DropMinutes, Deliveries) "
+                "SELECT DeliveryID, DATE(doneAt), LEAST(GREATEST(FLOOR(TIMESTAMPDIFF(SECOND, pickedAt, doneAt) / 60), 0), ")
+            + std::to_string(MAX_MINUTES) + "), COUNT(*) "
+            "FROM (" + completedDeliveries() + ") d WHERE pickedAt IS NOT NULL "
+            "GROUP BY DeliveryID, DATE(doneAt), LEAST(GREATEST(FLOOR(TIMESTAMPDIFF(SECOND, pickedAt, doneAt) / 60), 0), "
+            + std::to_string(MAX_MINUTES) + ")");
+    }
+
+    // Called once orders are marked 'Completed' and their events logged.
+    // One lookup of these orders' own milestones, then one multi-row upsert
+    // per rollup however many orders completed together. Skipped when this
+    // call created the tables: the backfill has already counted them.
+    void recordCompletions(const std::vector<int>& orderIDs) {
+        if (orderIDs.empty()) return;
+        if (ensureSchema()) return;
+
+        std::unique_ptr<sql::PreparedStatement> pick(conn->prepareStatement(
+            "SELECT o.OrdersID, o.DeliveryID, TIMESTAMPDIFF(SECOND, "
+            "COALESCE(MIN(CASE WHEN e.Status = 'Out for Delivery' THEN e.EventTime END), "
+            "MIN(CASE WHEN e.Status = 'Accepted' THEN e.EventTime END)), NOW()) AS dropSeconds "
+            "FROM orders o LEFT JOIN delivery_event e ON e.OrdersID = o.OrdersID "
+            "WHERE o.OrdersID IN (" + placeholders(orderIDs.size()) + ") AND o.DeliveryID IS NOT NULL "
+            "GROUP BY o.OrdersID, o.DeliveryID"));
+        for (size_t i = 0; i < orderIDs.size(); i++) pick->setInt(static_cast<unsigned int>(i + 1), orderIDs[i]);
+        std::unique_ptr<sql::ResultSet> res(pick->executeQuery());
+
+        struct Day { int deliveries = 0, timed = 0; long long dropSeconds = 0; };
+        std::map<int, Day> days;                            // by rider
+        std::map<std::pair<int, int>, int> drops;           // (rider, minutes) -> deliveries
+        while (res->next()) {
+            int riderID = res->getInt("DeliveryID");
+            Day& day = days[riderID];
+            day.deliveries++;
+            if (res->isNull("dropSeconds")) continue;
+            long long dropSeconds = std::max<long long>(0, res->getInt64("dropSeconds"));
+            day.timed++;
+            day.dropSeconds += dropSeconds;
+            drops[std::make_pair(riderID, static_cast<int>(std::min<long long>(dropSeconds / 60, MAX_MINUTES)))]++;
+        }
+        if (days.empty()) return;
+
+        std::string dayRows;
+        for (size_t i = 0; i < days.size(); i++) dayRows += (i == 0 ? "(?, CURDATE(), " : ", (?, CURDATE(), ") + placeholders(4) + ")";
+        std::unique_ptr<sql::PreparedStatement> dayStmt(conn->prepareStatement(
+            "INSERT INTO rider_rollup_day (DeliveryID, StatDate, Deliveries, TimedDeliveries, DropSeconds, Earnings) "
+            "VALUES " + dayRows + " "
+            "ON DUPLICATE KEY UPDATE Deliveries = Deliveries + VALUES(Deliveries), "
+            "TimedDeliveries = TimedDeliveries + VALUES(TimedDeliveries), "
+            "DropSeconds = DropSeconds + VALUES(DropSeconds), Earnings = Earnings + VALUES(Earnings)"));
+        unsigned int p = 1;
+        for (const auto& day : days) {
+            dayStmt->setInt(p++, day.first);
+            dayStmt->setInt(p++, day.second.deliveries);
+            dayStmt->setInt(p++, day.second.timed);
+            dayStmt->setInt64(p++, day.second.dropSeconds);
+            dayStmt->setDouble(p++, day.second.deliveries * payPerDelivery);
+        }
+        dayStmt->executeUpdate();
+
+        if (drops.empty()) return;
+        std::string dropRows;
+        for (size_t i = 0; i < drops.size(); i++) dropRows += (i == 0 ? "(?, CURDATE(), " : ", (?, CURDATE(), ") + placeholders(2) + ")";
+        std::unique_ptr<sql::PreparedStatement> dropStmt(conn->prepareStatement(
+            "INSERT INTO rider_rollup_drop (DeliveryID, StatDate, DropMinutes, Deliveries) VALUES " + dropRows + " "
+            "ON DUPLICATE KEY UPDATE Deliveries = Deliveries + VALUES(Deliveries)"));
+        p = 1;
+        for (const auto& drop : drops) {
+            dropStmt->setInt(p++, drop.first.first);
+            dropStmt->setInt(p++, drop.first.second);
+            dropStmt->setInt(p++, drop.second);
+        }
+        dropStmt->executeUpdate();
+    }
+
+    void recordCompletion(int orderID) {
+        recordCompletions(std::vector<int>(1, orderID));
+    }
+
+    // Scores for one rider (riderID > 0) or every rider with deliveries,
+    // read from `reader` (may be a replica)
+    std::map<int, RiderScore> scores(sql::Connection* reader, int riderID = 0, int days = 30) {
+        ensureSchema();
+        std::map<int, RiderScore> out;
+        std::string riderFilter = riderID > 0 ? " AND DeliveryID = " + std::to_string(riderID) : "";
+        std::string window = "StatDate > CURDATE() - INTERVAL " + std::to_string(days) + " DAY";
+
+        std::unique_ptr<sql::Statement> stmt(reader->createStatement());
+        std::unique_ptr<sql::ResultSet> res(stmt->executeQuery(
+            "SELECT DeliveryID, COUNT(*) AS activeDays, SUM(Deliveries) AS deliveries, SUM(Earnings) AS earnings, "
+            "SUM(TimedDeliveries) AS timed, SUM(DropSeconds) AS dropSeconds, "
+            "SUM(CASE WHEN StatDate = CURDATE() THEN Deliveries ELSE 0 END) AS deliveriesToday, "
+            "SUM(CASE WHEN StatDate = CURDATE() THEN Earnings ELSE 0 END) AS earningsToday "
+            "FROM rider_rollup_day WHERE " + window + riderFilter + " GROUP BY DeliveryID"));
+        while (res->next()) {
+            RiderScore& s = out[res->getInt("DeliveryID")];
+            s.riderID = res->getInt("DeliveryID");
+            s.activeDays = res->getInt("activeDays");
+            s.deliveries = res->getInt64("deliveries");
+            s.earnings = static_cast<double>(res->getDouble("earnings"));
+            s.deliveriesToday = res->getInt64("deliveriesToday");
+            s.earningsToday = static_cast<double>(res->getDouble("earningsToday"));
+            long long timed = res->getInt64("timed");
+            if (timed > 0) s.avgDropMinutes = res->getInt64("dropSeconds") / 60.0 / timed;
+        }
+
+        // Medians from each rider's minute histogram over the same days
+        std::unique_ptr<sql::ResultSet> hist(stmt->executeQuery(
+            "SELECT DeliveryID, DropMinutes, SUM(Deliveries) AS Deliveries FROM rider_rollup_drop WHERE " + window
+            + riderFilter + " GROUP BY DeliveryID, DropMinutes ORDER BY DeliveryID, DropMinutes"));
+        std::map<int, std::vector<std::pair<int, long long>>> buckets;
+        while (hist->next()) {
+            buckets[hist->getInt("DeliveryID")].push_back(
+                std::make_pair(hist->getInt("DropMinutes"), hist->getInt64("Deliveries")));
+        }
+        for (const auto& rider : buckets) {
+            long long total = 0;
+            for (const auto& b : rider.second) total += b.second;
+            long long half = (total + 1) / 2, seen = 0;
+            for (const auto& b : rider.second) {
+                seen += b.second;
+                if (seen < half) continue;
+                RiderScore& s = out[rider.first];
+                s.riderID = rider.first;
+                s.medianDropMinutes = b.first + 0.5;
+                break;
+            }
+        }
+        return out;
+    }
+
+    RiderScore score(sql::Connection* reader, int riderID, int days = 30) {
+        std::map<int, RiderScore> all = scores(reader, riderID, days);
+        auto it = all.find(riderID);
+        if (it != all.end()) return it->second;
+        RiderScore empty;
+        empty.riderID = riderID;
+        return empty;
+    }
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef ROUTE_PLANNER_H
+#define ROUTE_PLANNER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "geo.h"
+#include "dispatch.h"
+
+struct RouteStop {
+    int orderID;
+    GeoPoint at;            // drop-off
+};
+
+struct RoutePlan {
+    std::vector<RouteStop> stops;   // in visiting order
+    double meters;                  // start -> stops (-> start when returning)
+    double planMs;
+};
+
+// Multi-drop trips from the kitchen. Nearby open orders are grouped around
+// the oldest one with the dispatch grid, and each group's stop order is a
+// nearest-neighbour tour improved by 2-opt until no swap helps or the time
+// budget runs out, whichever comes first.
+class RoutePlanner {
+private:
+    static double legs(const GeoPoint& start, const std::vector<RouteStop>& stops, bool returnToStart) {
+        double total = 0.0;
+        GeoPoint at = start;
+        for (const RouteStop& s : stops) {
+            total += distanceMeters(at, s.at);
+            at = s.at;
+        }
+        if (returnToStart) total += distanceMeters(at, start);
+        return total;
+    }
+
+    static void nearestNeighbour(const GeoPoint& start, std::vector<RouteStop>& stops) {
+        GeoPoint at = start;
+        for (size_t i = 0; i < stops.size(); i++) {
+            size_t best = i;
+            double bestMeters = distanceMeters(at, stops[i].at);
+            for (size_t j = i + 1; j < stops.size(); j++) {
+                double d = distanceMeters(at, stops[j].at);
+                if (d < bestMeters) {
+                    bestMeters = d;
+                    best = j;
+                }
+            }
+            std::swap(stops[i], stops[best]);
+            at = stops[i].at;
+        }
+    }
+
+    // Reverses stops[i..j] whenever that shortens the route. Position 0 of
+    // the path is the start; the end is open unless returnToStart.
+    static void twoOpt(const GeoPoint& start, std::vector<RouteStop>& stops, bool returnToStart,
+        std::chrono::steady_clock::time_point deadline) {
+        size_t n = stops.size();
+        if (n < 3) return;
+        auto pointAt = [&](size_t k) -> const GeoPoint& { return k == 0 ? start : stops[k - 1].at; };
+
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (size_t i = 1; i < n; i++) {
+                if (std::chrono::steady_clock::now() > deadline) return;
+                for (size_t j = i + 1; j <= n; j++) {
+                    const GeoPoint& a = pointAt(i - 1);
+                    const GeoPoint& b = pointAt(i);
+                    const GeoPoint& c = pointAt(j);
+                    double delta = distanceMeters(a, c) - distanceMeters(a, b);
+                    if (j < n || returnToStart) {
+                        const GeoPoint& d = j < n ? pointAt(j + 1) : start;
+                        delta += distanceMeters(b, d) - distanceMeters(c, d);
+                    }
+                    if (delta < -0.01) {
+                        std::reverse(stops.begin() + (i - 1), stops.begin() + j);
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    static RoutePlan plan(const GeoPoint& start, std::vector<RouteStop> stops, bool returnToStart = false,
+        double budgetMs = 5.0) {
+        auto begin = std::chrono::steady_clock::now();
+        auto deadline = begin + std::chrono::microseconds(static_cast<long long>(budgetMs * 1000.0));
+        nearestNeighbour(start, stops);
+        twoOpt(start, stops, returnToStart, deadline);
+
+        RoutePlan result;
+        result.meters = legs(start, stops, returnToStart);
+        result.planMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        result.stops.swap(stops);
+        return result;
+    }
+
+    static double length(const GeoPoint& start, const std::vector<RouteStop>& stops, bool returnToStart) {
+        return legs(start, stops, returnToStart);
+    }
+
+    // Splits open orders (oldest first) into trips: each trip starts from the
+    // oldest order not yet taken and adds up to maxPerTrip - 1 of the nearest
+    // other drop-offs within radiusMeters of it
+    static std::vector<std::vector<RouteStop>> group(const std::vector<RouteStop>& open, size_t maxPerTrip,
+        double radiusMeters) {
+        PointGrid grid(std::max(250.0, radiusMeters / 2));
+        for (size_t i = 0; i < open.size(); i++) grid.insert(static_cast<int>(i), open[i].at);
+
+        std::vector<std::vector<RouteStop>> trips;
+        for (size_t i = 0; i < open.size(); i++) {
+            if (!grid.contains(static_cast<int>(i))) continue;
+            grid.remove(static_cast<int>(i));
+            std::vector<RouteStop> trip(1, open[i]);
+            if (maxPerTrip > 1) {
+                for (const auto& near : grid.nearest(open[i].at, maxPerTrip - 1, radiusMeters)) {
+                    trip.push_back(open[near.second]);
+                    grid.remove(near.second);
+                }
+            }
+            trips.push_back(trip);
+        }
+        return trips;
+    }
+};
+
+struct RouteBenchmark {
+    int orders;
+    int trips;
+    double singleKm;        // one order per trip, back to the kitchen each time
+    double nearestKm;       // batched, nearest-neighbour order only
+    double batchedKm;       // batched, after 2-opt
+    double totalPlanMs;
+    double maxPlanMs;
+};
+
+// Synthetic city around one kitchen: round trips one order at a time versus
+// batched multi-drop trips
+inline RouteBenchmark benchmarkRouteBatching(int orderCount = 2000, size_t maxPerTrip = 4,
+    double radiusMeters = 2000.0, double citySizeKm = 20.0, double budgetMs = 5.0, uint64_t seed = 11) {
+    uint64_t state = seed | 1;
+    auto uniform = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    const double degrees = citySizeKm * 1000.0 / 111320.0;
+    GeoPoint kitchen = { KITCHEN_LAT, KITCHEN_LNG };
+
+    std::vector<RouteStop> open;
+    for (int i = 0; i < orderCount; i++) {
+        RouteStop s = { i + 1, { KITCHEN_LAT - degrees / 2 + uniform() * degrees, KITCHEN_LNG - degrees / 2 + uniform() * degrees } };
+        open.push_back(s);
+    }
+
+    RouteBenchmark bench = {};
+    bench.orders = orderCount;
+    for (const RouteStop& s : open) bench.singleKm += 2.0 * distanceMeters(kitchen, s.at) / 1000.0;
+
+    for (std::vector<RouteStop>& trip : RoutePlanner::group(open, maxPerTrip, radiusMeters)) {
+        RoutePlan nearestOnly = RoutePlanner::plan(kitchen, trip, true, 0.0);
+        RoutePlan planned = RoutePlanner::plan(kitchen, trip, true, budgetMs);
+        bench.nearestKm += nearestOnly.meters / 1000.0;
+        bench.batchedKm += planned.meters / 1000.0;
+        bench.totalPlanMs += planned.planMs;
+        bench.maxPlanMs = std::max(bench.maxPlanMs, planned.planMs);
+        bench.trips++;
+    }
+    return bench;
+}
+
+#endif
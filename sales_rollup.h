@@ -0,0 +1,143 @@
+#ifndef SALES_ROLLUP_H
+#define SALES_ROLLUP_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/exception.h>
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "database.h"
+
+// Pre-aggregated sales kept up to date at checkout, so the owner reports read
+// a handful of rows instead of grouping all of order_item / orders / payment.
+//   sales_rollup_item     : per MenuID   (quantity, orders, revenue)
+//   sales_rollup_category : per Category (quantity, revenue)
+//   sales_rollup_hour     : per hour of day (orders)
+//   sales_rollup_day      : per calendar day (payments, revenue)
+// Revenue uses the price charged at checkout (order_item.UnitPrice; rows
+// written before that column existed fall back to the menu price). Day rows
+// count every payment taken at checkout, dated by its order.
+struct RollupLine {
+    int menuID;
+    int quantity;
+    double price;
+};
+
+class SalesRollup {
+private:
+    sql::Connection* conn;
+    bool schemaChecked = false;
+
+public:
+    SalesRollup(sql::Connection* connection) : conn(connection) {}
+
+    // Creates the rollup tables on first use and backfills them from history
+    void ensureSchema() {
+        if (schemaChecked) return;
+        bool fresh = !tableExists(conn, "sales_rollup_item");
+
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        if (!columnExists(conn, "order_item", "UnitPrice")) {
+            stmt->execute("ALTER TABLE order_item ADD COLUMN UnitPrice DECIMAL(10,2) NULL");
+        }
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS sales_rollup_item ("
+            "MenuID INT PRIMARY KEY, Quantity BIGINT NOT NULL DEFAULT 0, "
+            "Orders BIGINT NOT NULL DEFAULT 0, Revenue DECIMAL(14,2) NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS sales_rollup_category ("
+            "CategoryID INT PRIMARY KEY, Quantity BIGINT NOT NULL DEFAULT 0, "
+            "Revenue DECIMAL(14,2) NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS sales_rollup_hour ("
+            "SalesHour TINYINT PRIMARY KEY, Orders BIGINT NOT NULL DEFAULT 0)");
+        stmt->execute(
+            "CREATE TABLE IF NOT EXISTS sales_rollup_day ("
+            "SalesDate DATE PRIMARY KEY, Payments BIGINT NOT NULL DEFAULT 0, "
+            "Revenue DECIMAL(14,2) NOT NULL DEFAULT 0)");
+
+        schemaChecked = true;
+        if (fresh) rebuild();
+    }
+
+    // Recomputes every rollup from the raw tables (one-off backfill / repair)
+    void rebuild() {
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        stmt->execute("DELETE FROM sales_rollup_item");
+        stmt->execute("DELETE FROM sales_rollup_category");
+        stmt->execute("DELETE FROM sales_rollup_hour");
+        stmt->execute("DELETE FROM sales_rollup_day");
+
+        stmt->execute(
+            "INSERT INTO sales_rollup_item (MenuID, Quantity, Orders, Revenue) "
+            "SELECT oi.MenuID, SUM(oi.Quantity), COUNT(DISTINCT oi.OrdersID), SUM(oi.Quantity * IFNULL(oi.UnitPrice, m.Price)) "
+            "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID GROUP BY oi.MenuID");
+        stmt->execute(
+            "INSERT INTO sales_rollup_category (CategoryID, Quantity, Revenue) "
+            "SELECT m.CategoryID, SUM(oi.Quantity), SUM(oi.Quantity * IFNULL(oi.UnitPrice, m.Price)) "
+            "FROM order_item oi JOIN menu m ON oi.MenuID = m.MenuID GROUP BY m.CategoryID");
+        stmt->execute(
+            "INSERT INTO sales_rollup_hour (SalesHour, Orders) "
+            "SELECT HOUR(OrdersDate), COUNT(*) FROM orders GROUP BY HOUR(OrdersDate)");
+        stmt->execute(
+            "INSERT INTO sales_rollup_day (SalesDate, Payments, Revenue) "
+            "SELECT DATE(o.OrdersDate), COUNT(*), SUM(p.Amount) "
+            "FROM payment p JOIN orders o ON o.OrdersID = p.OrdersID GROUP BY DATE(o.OrdersDate)");
+    }
+
+    // Called inside the checkout transaction, after order_item rows are written
+    void recordOrder(const std::vector<RollupLine>& lines) {
+        ensureSchema();
+
+        // A cart can hold the same item twice; count the order once per item
+        std::map<int, std::pair<int, double>> perItem;
+        for (const RollupLine& line : lines) {
+            perItem[line.menuID].first += line.quantity;
+            perItem[line.menuID].second += line.quantity * line.price;
+        }
+
+        std::unique_ptr<sql::PreparedStatement> itemStmt(conn->prepareStatement(
+            "INSERT INTO sales_rollup_item (MenuID, Quantity, Orders, Revenue) VALUES (?, ?, 1, ?) "
+            "ON DUPLICATE KEY UPDATE Quantity = Quantity + VALUES(Quantity), "
+            "Orders = Orders + 1, Revenue = Revenue + VALUES(Revenue)"));
+        std::unique_ptr<sql::PreparedStatement> catStmt(conn->prepareStatement(
+            "INSERT INTO sales_rollup_category (CategoryID, Quantity, Revenue) "
+            "SELECT CategoryID, ?, ? FROM menu WHERE MenuID = ? "
+            "ON DUPLICATE KEY UPDATE Quantity = Quantity + VALUES(Quantity), Revenue = Revenue + VALUES(Revenue)"));
+
+        for (const auto& entry : perItem) {
+            itemStmt->setInt(1, entry.first);
+            itemStmt->setInt(2, entry.second.first);
+            itemStmt->setDouble(3, entry.second.second);
+            itemStmt->executeUpdate();
+
+            catStmt->setInt(1, entry.second.first);
+            catStmt->setDouble(2, entry.second.second);
+            catStmt->setInt(3, entry.first);
+            catStmt->executeUpdate();
+        }
+
+        std::unique_ptr<sql::Statement> stmt(conn->createStatement());
+        stmt->executeUpdate(
+            "INSERT INTO sales_rollup_hour (SalesHour, Orders) VALUES (HOUR(NOW()), 1) "
+            "ON DUPLICATE KEY UPDATE Orders = Orders + 1");
+    }
+
+    // Called inside the checkout transaction, after the payment row is written
+    void recordPayment(int orderID, double amount) {
+        ensureSchema();
+        std::unique_ptr<sql::PreparedStatement> pstmt(conn->prepareStatement(
+            "INSERT INTO sales_rollup_day (SalesDate, Payments, Revenue) "
+            "SELECT DATE(OrdersDate), 1, ? FROM orders WHERE OrdersID = ? "
+            "ON DUPLICATE KEY UPDATE Payments = Payments + 1, Revenue = Revenue + VALUES(Revenue)"));
+        pstmt->setDouble(1, amount);
+        pstmt->setInt(2, orderID);
+        pstmt->executeUpdate();
+    }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef TOP_SELLERS_H
+#define TOP_SELLERS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "mysql_connection.h"
+#include <cppconn/prepared_statement.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include "order_events.h"
+#include "sales_rollup.h"
+
+struct TopSellerEntry {
+    int menuID;
+    std::string menuName;
+    long long unitsSold;
+    long long orders;
+    long long revenueCents;
+    long long error;        // Space-Saving overestimate bound (0 = exact)
+};
+
+// Space-Saving heavy-hitters summary over units sold, bounded to `capacity`
+// tracked items. When a new item arrives and the summary is full, the item
+// with the fewest units is evicted and the newcomer inherits its count as an
+// error bound. While the number of distinct items stays within capacity
+// (the whole menu, in practice) every count is exact.
+class SpaceSaving {
+private:
+    std::vector<TopSellerEntry> entries;
+    std::unordered_map<int, size_t> slots;
+    size_t capacity;
+
+public:
+    explicit SpaceSaving(size_t maxItems = 256) : capacity(maxItems) {}
+
+    void add(int menuID, const std::string& menuName, long long units, long long orders, long long revenueCents) {
+        auto it = slots.find(menuID);
+        if (it != slots.end()) {
+            TopSellerEntry& e = entries[it->second];
+            e.unitsSold += units;
+            e.orders += orders;
+            e.revenueCents += revenueCents;
+            if (!menuName.empty()) e.menuName = menuName;
+            return;
+        }
+
+        TopSellerEntry entry = { menuID, menuName, units, orders, revenueCents, 0 };
+        if (entries.size() < capacity) {
+            slots[menuID] = entries.size();
+            entries.push_back(entry);
+            return;
+        }
+
+        size_t victim = 0;
+        for (size_t i = 1; i < entries.size(); i++) {
+            if (entries[i].unitsSold < entries[victim].unitsSold) victim = i;
+        }
+        entry.error = entries[victim].unitsSold;
+        entry.unitsSold += entry.error;
+        slots.erase(entries[victim].menuID);
+        slots[menuID] = victim;
+        entries[victim] = entry;
+    }
+
+    void merge(const SpaceSaving& other) {
+        for (const TopSellerEntry& e : other.entries) {
+            add(e.menuID, e.menuName, e.unitsSold, e.orders, e.revenueCents);
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        slots.clear();
+    }
+
+    std::vector<TopSellerEntry> top(size_t k) const {
+        std::vector<TopSellerEntry> result(entries);
+        size_t keep = std::min(k, result.size());
+        std::partial_sort(result.begin(), result.begin() + keep, result.end(),
+            [](const TopSellerEntry& a, const TopSellerEntry& b) {
+                return a.unitsSold != b.unitsSold ? a.unitsSold > b.unitsSold : a.menuID < b.menuID;
+            });
+        result.resize(keep);
+        return result;
+    }
+};
+
+// Top sellers for all time, today and the last hour, updated from committed
+// orders. The last hour is sixty one-minute summaries in a ring, merged on
+// read; "today" is reset at local midnight. Seeded once from the database
+// at startup, then maintained purely from OrderPlacedEvent.
+class TopSellerTracker {
+private:
+    enum { MINUTES = 60 };
+
+    SpaceSaving allTime, today;
+    SpaceSaving minutes[MINUTES];
+    long long minuteStamp[MINUTES];
+    long long todayStamp = -1;
+    size_t capacity;
+    mutable std::mutex m;
+
+    static long long localDay(time_t when) {
+        tm t = {};
+#ifdef _WIN32
+        localtime_s(&t, &when);
+#else
+        localtime_r(&when, &t);
+#endif
+        return (t.tm_year + 1900) * 1000LL + t.tm_yday;
+    }
+
+    SpaceSaving& minuteBucket(time_t when) {
+        long long minute = static_cast<long long>(when) / 60;
+        int slot = static_cast<int>(minute % MINUTES);
+        if (minuteStamp[slot] != minute) {
+            minutes[slot].clear();
+            minuteStamp[slot] = minute;
+        }
+        return minutes[slot];
+    }
+
+    void rollDay(time_t now) {
+        long long day = localDay(now);
+        if (day != todayStamp) {
+            today.clear();
+            todayStamp = day;
+        }
+    }
+
+    void addLocked(time_t when, int menuID, const std::string& name, long long units, long long orders, long long cents) {
+        allTime.add(menuID, name, units, orders, cents);
+        if (localDay(when) == todayStamp) today.add(menuID, name, units, orders, cents);
+        if (when > time(nullptr) - MINUTES * 60) minuteBucket(when).add(menuID, name, units, orders, cents);
+    }
+
+public:
+    explicit TopSellerTracker(size_t maxItems = 256) : allTime(maxItems), today(maxItems), capacity(maxItems) {
+        for (int i = 0; i < MINUTES; i++) {
+            minutes[i] = SpaceSaving(maxItems);
+            minuteStamp[i] = -1;
+        }
+    }
+
+    void attach(OrderEvents& events) {
+        events.onOrderPlaced([this](const OrderPlacedEvent& e) { record(e); });
+    }
+
+    // Loads all-time totals from the item rollup and today's orders
+    void seed(sql::Connection* con) {
+        SalesRollup(con).ensureSchema();
+
+        std::lock_guard<std::mutex> lock(m);
+        time_t now = time(nullptr);
+        rollDay(now);
+
+        std::unique_ptr<sql::Statement> stmt(con->createStatement());
+        std::unique_ptr<sql::ResultSet> all(stmt->executeQuery(
+            "SELECT r.MenuID, m.Menu_Name, r.Quantity, r.Orders, ROUND(r.Revenue * 100) AS RevenueCents "
+            "FROM sales_rollup_item r JOIN menu m ON m.MenuID = r.MenuID"));
+        while (all->next()) {
+            allTime.add(all->getInt("MenuID"), all->getString("Menu_Name"), all->getInt64("Quantity"),
+                all->getInt64("Orders"), all->getInt64("RevenueCents"));
+        }
+
+        std::unique_ptr<sql::ResultSet> recent(stmt->executeQuery(
+            "SELECT UNIX_TIMESTAMP(o.OrdersDate) AS placedAt, oi.MenuID, m.Menu_Name, oi.Quantity, "
+            "ROUND(oi.Quantity * IFNULL(oi.UnitPrice, m.Price) * 100) AS RevenueCents "
+            "FROM orders o JOIN order_item oi ON oi.OrdersID = o.OrdersID "
+            "JOIN menu m ON m.MenuID = oi.MenuID "
+            "WHERE o.OrdersDate >= CURDATE()"));
+        while (recent->next()) {
+            time_t when = static_cast<time_t>(recent->getInt64("placedAt"));
+            std::string name = recent->getString("Menu_Name");
+            int menuID = recent->getInt("MenuID");
+            long long units = recent->getInt64("Quantity"), cents = recent->getInt64("RevenueCents");
+            today.add(menuID, name, units, 1, cents);
+            if (when > now - MINUTES * 60) minuteBucket(when).add(menuID, name, units, 1, cents);
+        }
+    }
+
+    void record(const OrderPlacedEvent& e) {
+        std::lock_guard<std::mutex> lock(m);
+        rollDay(time(nullptr));
+
+        // One order counts once per item even if the cart lists it twice
+        std::unordered_set<int> seen;
+        for (const OrderEventLine& line : e.lines) {
+            long long cents = static_cast<long long>(line.price * line.quantity * 100 + 0.5);
+            long long orders = seen.insert(line.menuID).second ? 1 : 0;
+            addLocked(e.placedAt, line.menuID, line.menuName, line.quantity, orders, cents);
+        }
+    }
+
+    std::vector<TopSellerEntry> topAllTime(size_t k = 10) const {
+        std::lock_guard<std::mutex> lock(m);
+        return allTime.top(k);
+    }
+
+    std::vector<TopSellerEntry> topToday(size_t k = 10) {
+        std::lock_guard<std::mutex> lock(m);
+        rollDay(time(nullptr));
+        return today.top(k);
+    }
+
+    std::vector<TopSellerEntry> topLastHour(size_t k = 10) const {
+        std::lock_guard<std::mutex> lock(m);
+        long long current = static_cast<long long>(time(nullptr)) / 60;
+        SpaceSaving merged(capacity);
+        for (int i = 0; i < MINUTES; i++) {
+            if (minuteStamp[i] > current - MINUTES) merged.merge(minutes[i]);
+        }
+        return merged.top(k);
+    }
+};
+
+#endif